@@ -45,10 +45,15 @@
 #include "PSL_TetMeshUtilities.hpp"
 #include "PSL_OrthogonalGridUtilities.hpp"
 #include "PSL_AMFilterUtilities.hpp"
+#include "PSL_AMFilterColumnPartition.hpp"
+#include "PSL_AbstractAuthority.hpp"
+#include "PSL_Abstract_MpiWrapper.hpp"
 #include "PSL_Interface_ParallelVector.hpp"
+#include "PSL_Random.hpp"
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 
 namespace PlatoSubproblemLibrary
 {
@@ -748,6 +753,17 @@ PSL_TEST(AMFilterUtilities, computeGridPrintableDensity)
             }
         }
     }
+
+    // full sweep matches the layer by layer computation
+    std::vector<double> tSweptGridPrintableDensity;
+    tAMFilterUtilities.computeGridPrintableDensity(tGridBlueprintDensity,tSweptGridPrintableDensity);
+    ASSERT_EQ(tSweptGridPrintableDensity.size(),tGridPrintableDensity.size());
+    for(size_t tIndex = 0; tIndex < tGridPrintableDensity.size(); ++tIndex)
+        EXPECT_EQ(tSweptGridPrintableDensity[tIndex],tGridPrintableDensity[tIndex]);
+
+    // smooth max arguments must be positive
+    tGridPrintableDensity[tGridUtilities.getSerializedIndex(0,0,0)] = -1.0;
+    EXPECT_THROW(tAMFilterUtilities.computeGridLayerSupportDensity(1,tGridPrintableDensity,tGridSupportDensity),std::domain_error);
 }
 
 PSL_TEST(AMFilterUtilities, computeTetNodePrintableDensity)
@@ -1431,8 +1447,253 @@ PSL_TEST(AMFilterUtilities, computeTetMeshPrintableDensity_manyElements)
     for(int i = 0; i < (int) tGoldDensity.size(); ++i)
     {
         // printf("%.17e\n", tDensityVector.get_value(i));
-        EXPECT_DOUBLE_EQ(tDensityVector.get_value(i), tGoldDensity[i]);
+        // interpolation weights are precomputed, so values near zero differ from the gold by round-off
+        EXPECT_NEAR(tDensityVector.get_value(i), tGoldDensity[i], 1e-15);
+    }
+}
+
+PSL_TEST(AMFilterUtilities, gradientFiniteDifference)
+{
+    set_rand_seed();
+
+    // unit cube of 2x2x2 cubes, each split into 6 tets sharing the cube diagonal
+    const size_t tNumCubes = 2;
+    const size_t tNumNodesPerSide = tNumCubes + 1;
+    std::vector<std::vector<double>> tCoordinates;
+    std::vector<std::vector<int>> tConnectivity;
+    for(size_t i = 0; i < tNumNodesPerSide; ++i)
+        for(size_t j = 0; j < tNumNodesPerSide; ++j)
+            for(size_t k = 0; k < tNumNodesPerSide; ++k)
+                tCoordinates.push_back({double(i)/tNumCubes, double(j)/tNumCubes, double(k)/tNumCubes});
+    auto tNode = [&](size_t i, size_t j, size_t k) {return int((i*tNumNodesPerSide + j)*tNumNodesPerSide + k);};
+    const std::vector<std::vector<size_t>> tPermutations({{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}});
+    for(size_t i = 0; i < tNumCubes; ++i)
+        for(size_t j = 0; j < tNumCubes; ++j)
+            for(size_t k = 0; k < tNumCubes; ++k)
+                for(auto tPermutation : tPermutations)
+                {
+                    std::vector<size_t> tCorner({i,j,k});
+                    std::vector<int> tTet({tNode(tCorner[0],tCorner[1],tCorner[2])});
+                    for(auto tDim : tPermutation)
+                    {
+                        ++tCorner[tDim];
+                        tTet.push_back(tNode(tCorner[0],tCorner[1],tCorner[2]));
+                    }
+                    tConnectivity.push_back(tTet);
+                }
+
+    TetMeshUtilities tTetUtilities(tCoordinates,tConnectivity);
+
+    Vector tUBasisVector({1.0,0.0,0.0});
+    Vector tVBasisVector({0.0,1.0,0.0});
+    Vector tWBasisVector({0.0,0.0,1.0});
+    Vector tMaxUVWCoords, tMinUVWCoords;
+    tTetUtilities.computeBoundingBox(tUBasisVector,tVBasisVector,tWBasisVector,tMaxUVWCoords,tMinUVWCoords);
+
+    OrthogonalGridUtilities tGridUtilities(tUBasisVector,tVBasisVector,tWBasisVector,tMaxUVWCoords,tMinUVWCoords,0.15);
+
+    double tPNorm = 20;
+    AMFilterUtilities tAMFilterUtilities(tTetUtilities,tGridUtilities,tPNorm);
+
+    // objective is a random weighting of the printable density
+    const size_t tNumNodes = tCoordinates.size();
+    std::vector<double> tBlueprint(tNumNodes);
+    uniform_rand_double(0.1, 0.9, tBlueprint);
+    std::vector<double> tWeights(tNumNodes);
+    uniform_rand_double(-1.0, 1.0, tWeights);
+
+    auto tObjective = [&](const std::vector<double>& aBlueprint)
+    {
+        example::Interface_ParallelVector tDensity(aBlueprint);
+        std::vector<double> tGridBlueprintDensity;
+        tAMFilterUtilities.computeGridBlueprintDensity(&tDensity,tGridBlueprintDensity);
+        std::vector<double> tGridPrintableDensity;
+        tAMFilterUtilities.computeGridPrintableDensity(tGridBlueprintDensity,tGridPrintableDensity);
+        tAMFilterUtilities.computeTetMeshPrintableDensity(tGridPrintableDensity,&tDensity);
+        double tValue = 0;
+        for(size_t tNodeIndex = 0; tNodeIndex < tNumNodes; ++tNodeIndex)
+            tValue += tWeights[tNodeIndex]*tDensity.get_value(tNodeIndex);
+        return tValue;
+    };
+
+    // analytic gradient by reverse sweep
+    example::Interface_ParallelVector tDensity(tBlueprint);
+    std::vector<double> tGridBlueprintDensity;
+    tAMFilterUtilities.computeGridBlueprintDensity(&tDensity,tGridBlueprintDensity);
+    std::vector<double> tGridPrintableDensity;
+    tAMFilterUtilities.computeGridPrintableDensity(tGridBlueprintDensity,tGridPrintableDensity);
+
+    example::Interface_ParallelVector tGradient(tWeights);
+    std::vector<double> tGridPrintableDensityGradient;
+    tAMFilterUtilities.computeGridPrintableDensityGradient(&tGradient,tGridPrintableDensityGradient);
+    std::vector<double> tGridBlueprintDensityGradient;
+    tAMFilterUtilities.computeGridBlueprintDensityGradient(tGridBlueprintDensity,tGridPrintableDensity,tGridPrintableDensityGradient,tGridBlueprintDensityGradient);
+    tAMFilterUtilities.computeTetMeshBlueprintDensityGradient(&tDensity,tGridBlueprintDensityGradient,&tGradient);
+
+    // central differences
+    const double tStep = 1e-6;
+    double tMaxGradient = 0;
+    for(size_t tNodeIndex = 0; tNodeIndex < tNumNodes; ++tNodeIndex)
+        tMaxGradient = std::max(tMaxGradient,std::fabs(tGradient.get_value(tNodeIndex)));
+    EXPECT_GT(tMaxGradient,0.0);
+    for(size_t tNodeIndex = 0; tNodeIndex < tNumNodes; ++tNodeIndex)
+    {
+        std::vector<double> tPlus(tBlueprint);
+        std::vector<double> tMinus(tBlueprint);
+        tPlus[tNodeIndex] += tStep;
+        tMinus[tNodeIndex] -= tStep;
+        double tFiniteDifference = (tObjective(tPlus) - tObjective(tMinus))/(2*tStep);
+        EXPECT_NEAR(tGradient.get_value(tNodeIndex),tFiniteDifference,1e-5*tMaxGradient);
+    }
+}
+
+PSL_TEST(AMFilterColumnPartition, matchesSerial)
+{
+    AbstractAuthority tAuthority;
+    const size_t tRank = tAuthority.mpi_wrapper->get_rank();
+    const size_t tNumRanks = tAuthority.mpi_wrapper->get_size();
+
+    // unit cube of 3x3x3 cubes, each split into 6 tets sharing the cube diagonal
+    const size_t tNumCubes = 3;
+    const size_t tNumNodesPerSide = tNumCubes + 1;
+    std::vector<std::vector<double>> tCoordinates;
+    for(size_t i = 0; i < tNumNodesPerSide; ++i)
+        for(size_t j = 0; j < tNumNodesPerSide; ++j)
+            for(size_t k = 0; k < tNumNodesPerSide; ++k)
+                tCoordinates.push_back({double(i)/tNumCubes, double(j)/tNumCubes, double(k)/tNumCubes});
+    auto tNode = [&](size_t i, size_t j, size_t k) {return int((i*tNumNodesPerSide + j)*tNumNodesPerSide + k);};
+    const std::vector<std::vector<size_t>> tPermutations({{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}});
+    std::vector<std::vector<int>> tConnectivity;
+    std::vector<size_t> tCubeOfTet;
+    for(size_t i = 0; i < tNumCubes; ++i)
+        for(size_t j = 0; j < tNumCubes; ++j)
+            for(size_t k = 0; k < tNumCubes; ++k)
+                for(auto tPermutation : tPermutations)
+                {
+                    std::vector<size_t> tCorner({i,j,k});
+                    std::vector<int> tTet({tNode(tCorner[0],tCorner[1],tCorner[2])});
+                    for(auto tDim : tPermutation)
+                    {
+                        ++tCorner[tDim];
+                        tTet.push_back(tNode(tCorner[0],tCorner[1],tCorner[2]));
+                    }
+                    tConnectivity.push_back(tTet);
+                    tCubeOfTet.push_back((i*tNumCubes + j)*tNumCubes + k);
+                }
+    const size_t tNumNodes = tCoordinates.size();
+
+    // this processor's part is every cube whose index is its rank modulo the number of processors
+    std::vector<int> tLocalNodeOfNode(tNumNodes,-1);
+    std::vector<size_t> tNodeOfLocalNode;
+    std::vector<std::vector<double>> tLocalCoordinates;
+    std::vector<std::vector<int>> tLocalConnectivity;
+    for(size_t tTetIndex = 0; tTetIndex < tConnectivity.size(); ++tTetIndex)
+    {
+        if(tCubeOfTet[tTetIndex] % tNumRanks != tRank)
+            continue;
+        std::vector<int> tLocalTet;
+        for(int tNodeIndex : tConnectivity[tTetIndex])
+        {
+            if(tLocalNodeOfNode[tNodeIndex] < 0)
+            {
+                tLocalNodeOfNode[tNodeIndex] = tNodeOfLocalNode.size();
+                tNodeOfLocalNode.push_back(tNodeIndex);
+                tLocalCoordinates.push_back(tCoordinates[tNodeIndex]);
+            }
+            tLocalTet.push_back(tLocalNodeOfNode[tNodeIndex]);
+        }
+        tLocalConnectivity.push_back(tLocalTet);
+    }
+    const size_t tNumLocalNodes = tNodeOfLocalNode.size();
+
+    // a node's gradient contribution is given on the lowest processor holding it
+    std::vector<int> tHolder(tNumNodes,-int(tNumRanks));
+    std::vector<int> tLowestHolder(tNumNodes);
+    for(size_t tLocalNode = 0; tLocalNode < tNumLocalNodes; ++tLocalNode)
+        tHolder[tNodeOfLocalNode[tLocalNode]] = -int(tRank);
+    tAuthority.mpi_wrapper->all_reduce_max(tHolder,tLowestHolder);
+
+    TetMeshUtilities tTetUtilities(tCoordinates,tConnectivity);
+    TetMeshUtilities tLocalTetUtilities(tLocalCoordinates,tLocalConnectivity);
+
+    Vector tUBasisVector({1.0,0.0,0.0});
+    Vector tVBasisVector({0.0,1.0,0.0});
+    Vector tWBasisVector({0.0,0.0,1.0});
+    Vector tMaxUVWCoords, tMinUVWCoords;
+    tTetUtilities.computeBoundingBox(tUBasisVector,tVBasisVector,tWBasisVector,tMaxUVWCoords,tMinUVWCoords);
+
+    OrthogonalGridUtilities tGridUtilities(tUBasisVector,tVBasisVector,tWBasisVector,tMaxUVWCoords,tMinUVWCoords,0.1);
+
+    double tPNorm = 20;
+    AMFilterUtilities tAMFilterUtilities(tTetUtilities,tGridUtilities,tPNorm);
+    AMFilterColumnPartition tColumnPartition(&tAuthority,tLocalTetUtilities,tGridUtilities,tPNorm);
+
+    // owned columns tile the grid
+    const std::vector<size_t> tGridDimensions = tGridUtilities.getGridDimensions();
+    std::vector<int> tTimesOwned(tGridDimensions[0]*tGridDimensions[1],0);
+    for(size_t tOwner = 0; tOwner < tNumRanks; ++tOwner)
+    {
+        std::vector<size_t> tBeginIndex, tEndIndex;
+        tColumnPartition.getOwnedColumns(tOwner,tBeginIndex,tEndIndex);
+        for(size_t i = tBeginIndex[0]; i < tEndIndex[0]; ++i)
+            for(size_t j = tBeginIndex[1]; j < tEndIndex[1]; ++j)
+                ++tTimesOwned[i + j*tGridDimensions[0]];
+    }
+    for(int tCount : tTimesOwned)
+        EXPECT_EQ(tCount,1);
+
+    // the same fields on every processor
+    std::vector<double> tBlueprint(tNumNodes);
+    std::vector<double> tWeights(tNumNodes);
+    for(size_t tNodeIndex = 0; tNodeIndex < tNumNodes; ++tNodeIndex)
+    {
+        tBlueprint[tNodeIndex] = 0.5 + 0.4*std::sin(7.0*tNodeIndex + 1.0);
+        tWeights[tNodeIndex] = std::cos(3.0*tNodeIndex);
+    }
+
+    // serial reference on the whole mesh
+    example::Interface_ParallelVector tDensity(tBlueprint);
+    std::vector<double> tGridBlueprintDensity;
+    tAMFilterUtilities.computeGridBlueprintDensity(&tDensity,tGridBlueprintDensity);
+    std::vector<double> tGridPrintableDensity;
+    tAMFilterUtilities.computeGridPrintableDensity(tGridBlueprintDensity,tGridPrintableDensity);
+    tAMFilterUtilities.computeTetMeshPrintableDensity(tGridPrintableDensity,&tDensity);
+
+    example::Interface_ParallelVector tGradient(tWeights);
+    std::vector<double> tGridPrintableDensityGradient;
+    tAMFilterUtilities.computeGridPrintableDensityGradient(&tGradient,tGridPrintableDensityGradient);
+    std::vector<double> tGridBlueprintDensityGradient;
+    tAMFilterUtilities.computeGridBlueprintDensityGradient(tGridBlueprintDensity,tGridPrintableDensity,tGridPrintableDensityGradient,tGridBlueprintDensityGradient);
+    example::Interface_ParallelVector tBlueprintVector(tBlueprint);
+    tAMFilterUtilities.computeTetMeshBlueprintDensityGradient(&tBlueprintVector,tGridBlueprintDensityGradient,&tGradient);
+
+    // distributed
+    std::vector<double> tLocalBlueprint(tNumLocalNodes);
+    std::vector<double> tLocalWeights(tNumLocalNodes,0.0);
+    for(size_t tLocalNode = 0; tLocalNode < tNumLocalNodes; ++tLocalNode)
+    {
+        const size_t tNodeIndex = tNodeOfLocalNode[tLocalNode];
+        tLocalBlueprint[tLocalNode] = tBlueprint[tNodeIndex];
+        if(-tLowestHolder[tNodeIndex] == int(tRank))
+            tLocalWeights[tLocalNode] = tWeights[tNodeIndex];
     }
+    example::Interface_ParallelVector tLocalDensity(tLocalBlueprint);
+    tColumnPartition.computeTetMeshPrintableDensity(&tLocalDensity);
+    for(size_t tLocalNode = 0; tLocalNode < tNumLocalNodes; ++tLocalNode)
+        EXPECT_NEAR(tLocalDensity.get_value(tLocalNode),tDensity.get_value(tNodeOfLocalNode[tLocalNode]),1e-12);
+
+    example::Interface_ParallelVector tLocalBlueprintVector(tLocalBlueprint);
+    example::Interface_ParallelVector tLocalGradient(tLocalWeights);
+    tColumnPartition.computeTetMeshBlueprintDensityGradient(&tLocalBlueprintVector,&tLocalGradient);
+
+    // copies of a shared node each carry part of its gradient
+    std::vector<double> tSummedGradient(tNumNodes,0.0);
+    for(size_t tLocalNode = 0; tLocalNode < tNumLocalNodes; ++tLocalNode)
+        tSummedGradient[tNodeOfLocalNode[tLocalNode]] += tLocalGradient.get_value(tLocalNode);
+    std::vector<double> tGlobalGradient(tNumNodes);
+    tAuthority.mpi_wrapper->all_reduce_sum(tSummedGradient,tGlobalGradient);
+    for(size_t tNodeIndex = 0; tNodeIndex < tNumNodes; ++tNodeIndex)
+        EXPECT_NEAR(tGlobalGradient[tNodeIndex],tGradient.get_value(tNodeIndex),1e-12);
 }
 
 PSL_TEST(AMFilterUtilities, smoothMax)
@@ -209,6 +209,259 @@ PSL_TEST(CompressedRowSparseMatrixImplementation,matVecToReducedTranspose)
     expect_equal_float_vectors(b_gold, b);
 }
 
+PSL_TEST(CompressedRowSparseMatrixImplementation,storeTranspose)
+{
+    set_rand_seed();
+    // test transposed products from a stored transpose match those by scattering
+
+    // build random matrix large enough for threaded products, with some empty rows and columns
+    const size_t num_rows = 400;
+    const size_t num_columns = 300;
+    std::vector<size_t> row_bounds(1, 0u);
+    std::vector<size_t> columns;
+    std::vector<double> data;
+    for(size_t row = 0; row < num_rows; row++)
+    {
+        if(row % 7u != 3u)
+        {
+            for(size_t column = 0; column < num_columns; column++)
+            {
+                if((column % 11u != 5u) && (uniform_rand_double() < .2))
+                {
+                    columns.push_back(column);
+                    data.push_back(uniform_rand_double(-1., 1.));
+                }
+            }
+        }
+        row_bounds.push_back(columns.size());
+    }
+    example::CompressedRowSparseMatrix scatterMatrix(num_rows, num_columns, row_bounds, columns, data);
+    example::CompressedRowSparseMatrix storedMatrix(num_rows, num_columns, row_bounds, columns, data);
+    storedMatrix.storeTranspose();
+
+    std::vector<double> x(num_rows);
+    uniform_rand_double(-1., 1., x);
+
+    // full transposed products
+    std::vector<double> scatter_b;
+    scatterMatrix.matVec(x, scatter_b, true);
+    std::vector<double> stored_b;
+    storedMatrix.matVec(x, stored_b, true);
+    expect_equal_float_vectors(scatter_b, stored_b);
+
+    // reduced transposed products
+    scatterMatrix.matVecToReduced(x, scatter_b, true);
+    storedMatrix.matVecToReduced(x, stored_b, true);
+    EXPECT_EQ(scatter_b.size(), scatterMatrix.getNumNonZeroSortedColumns());
+    expect_equal_float_vectors(scatter_b, stored_b);
+
+    // stored transpose follows modifications
+    std::vector<double> row_factors(num_rows);
+    uniform_rand_double(.5, 2., row_factors);
+    scatterMatrix.rowNormalize(row_factors);
+    storedMatrix.rowNormalize(row_factors);
+    scatterMatrix.matVec(x, scatter_b, true);
+    storedMatrix.matVec(x, stored_b, true);
+    expect_equal_float_vectors(scatter_b, stored_b);
+
+    // repeated products are reproducible
+    std::vector<double> repeat_b;
+    storedMatrix.matVec(x, repeat_b, true);
+    expect_equal_vectors(stored_b, repeat_b);
+}
+
+PSL_TEST(CompressedRowSparseMatrixImplementation,matMultiVec)
+{
+    set_rand_seed();
+    // test products with interleaved vectors match products with each vector
+
+    // build random matrix large enough for threaded products, with some empty rows and columns
+    const size_t num_rows = 400;
+    const size_t num_columns = 300;
+    std::vector<size_t> row_bounds(1, 0u);
+    std::vector<size_t> columns;
+    std::vector<double> data;
+    for(size_t row = 0; row < num_rows; row++)
+    {
+        if(row % 7u != 3u)
+        {
+            for(size_t column = 0; column < num_columns; column++)
+            {
+                if((column % 11u != 5u) && (uniform_rand_double() < .2))
+                {
+                    columns.push_back(column);
+                    data.push_back(uniform_rand_double(-1., 1.));
+                }
+            }
+        }
+        row_bounds.push_back(columns.size());
+    }
+    example::CompressedRowSparseMatrix scatterMatrix(num_rows, num_columns, row_bounds, columns, data);
+    example::CompressedRowSparseMatrix storedMatrix(num_rows, num_columns, row_bounds, columns, data);
+    storedMatrix.storeTranspose();
+
+    const size_t num_vectors = 3;
+    for(bool transpose : {false, true})
+    {
+        const size_t input_length = (transpose ? num_rows : num_columns);
+        std::vector<double> x(input_length * num_vectors);
+        uniform_rand_double(-1., 1., x);
+
+        std::vector<double> scatter_full;
+        scatterMatrix.matMultiVec(x, scatter_full, num_vectors, transpose);
+        std::vector<double> stored_full;
+        storedMatrix.matMultiVec(x, stored_full, num_vectors, transpose);
+        std::vector<double> scatter_reduced;
+        scatterMatrix.matMultiVecToReduced(x, scatter_reduced, num_vectors, transpose);
+        std::vector<double> stored_reduced;
+        storedMatrix.matMultiVecToReduced(x, stored_reduced, num_vectors, transpose);
+
+        for(size_t vector = 0; vector < num_vectors; vector++)
+        {
+            std::vector<double> single_x(input_length);
+            for(size_t i = 0; i < input_length; i++)
+            {
+                single_x[i] = x[i * num_vectors + vector];
+            }
+            std::vector<double> single_full;
+            scatterMatrix.matVec(single_x, single_full, transpose);
+            std::vector<double> single_reduced;
+            scatterMatrix.matVecToReduced(single_x, single_reduced, transpose);
+
+            ASSERT_EQ(single_full.size() * num_vectors, scatter_full.size());
+            ASSERT_EQ(single_full.size() * num_vectors, stored_full.size());
+            for(size_t i = 0; i < single_full.size(); i++)
+            {
+                EXPECT_FLOAT_EQ(single_full[i], scatter_full[i * num_vectors + vector]);
+                EXPECT_FLOAT_EQ(single_full[i], stored_full[i * num_vectors + vector]);
+            }
+            ASSERT_EQ(single_reduced.size() * num_vectors, scatter_reduced.size());
+            ASSERT_EQ(single_reduced.size() * num_vectors, stored_reduced.size());
+            for(size_t i = 0; i < single_reduced.size(); i++)
+            {
+                EXPECT_FLOAT_EQ(single_reduced[i], scatter_reduced[i * num_vectors + vector]);
+                EXPECT_FLOAT_EQ(single_reduced[i], stored_reduced[i * num_vectors + vector]);
+            }
+        }
+    }
+}
+
+PSL_TEST(CompressedRowSparseMatrixImplementation,compactStorage)
+{
+    set_rand_seed();
+    // test 32-bit columns reproduce products to rounding, and single precision values to float accuracy
+
+    // build random matrix large enough for threaded products, with some empty rows and columns
+    const size_t num_rows = 400;
+    const size_t num_columns = 300;
+    std::vector<size_t> row_bounds(1, 0u);
+    std::vector<size_t> columns;
+    std::vector<double> data;
+    for(size_t row = 0; row < num_rows; row++)
+    {
+        if(row % 7u != 3u)
+        {
+            for(size_t column = 0; column < num_columns; column++)
+            {
+                if((column % 11u != 5u) && (uniform_rand_double() < .2))
+                {
+                    columns.push_back(column);
+                    data.push_back(uniform_rand_double(-1., 1.));
+                }
+            }
+        }
+        row_bounds.push_back(columns.size());
+    }
+    example::CompressedRowSparseMatrix wideMatrix(num_rows, num_columns, row_bounds, columns, data);
+    example::CompressedRowSparseMatrix compactMatrix(num_rows, num_columns, row_bounds, columns, data);
+    compactMatrix.compactStorage(false);
+    example::CompressedRowSparseMatrix singleMatrix(num_rows, num_columns, row_bounds, columns, data);
+    singleMatrix.compactStorage(true);
+    singleMatrix.storeTranspose();
+    EXPECT_EQ(compactMatrix.m_matrix_columns.size(), 0u);
+    EXPECT_EQ(singleMatrix.m_matrix_data.size(), 0u);
+
+    // a row holds within 60 nonzeros of magnitude at most one
+    const double single_tolerance = 1e-5;
+    const size_t num_vectors = 3;
+    for(bool transpose : {false, true})
+    {
+        const size_t input_length = (transpose ? num_rows : num_columns);
+        for(size_t vectors : {size_t(1u), num_vectors})
+        {
+            std::vector<double> x(input_length * vectors);
+            uniform_rand_double(-1., 1., x);
+
+            std::vector<double> wide_full;
+            wideMatrix.matMultiVec(x, wide_full, vectors, transpose);
+            std::vector<double> compact_full;
+            compactMatrix.matMultiVec(x, compact_full, vectors, transpose);
+            std::vector<double> single_full;
+            singleMatrix.matMultiVec(x, single_full, vectors, transpose);
+            expect_equal_float_vectors(wide_full, compact_full);
+            ASSERT_EQ(wide_full.size(), single_full.size());
+            for(size_t i = 0; i < wide_full.size(); i++)
+            {
+                EXPECT_NEAR(wide_full[i], single_full[i], single_tolerance);
+            }
+
+            std::vector<double> wide_reduced;
+            wideMatrix.matMultiVecToReduced(x, wide_reduced, vectors, transpose);
+            std::vector<double> compact_reduced;
+            compactMatrix.matMultiVecToReduced(x, compact_reduced, vectors, transpose);
+            std::vector<double> single_reduced;
+            singleMatrix.matMultiVecToReduced(x, single_reduced, vectors, transpose);
+            expect_equal_float_vectors(wide_reduced, compact_reduced);
+            ASSERT_EQ(wide_reduced.size(), single_reduced.size());
+            for(size_t i = 0; i < wide_reduced.size(); i++)
+            {
+                EXPECT_NEAR(wide_reduced[i], single_reduced[i], single_tolerance);
+            }
+        }
+    }
+
+    // rows read back through either storage
+    std::vector<double> wide_row_data;
+    std::vector<size_t> wide_row_columns;
+    std::vector<double> single_row_data;
+    std::vector<size_t> single_row_columns;
+    for(size_t row = 0; row < num_rows; row++)
+    {
+        wideMatrix.getRow(row, wide_row_data, wide_row_columns);
+        singleMatrix.getRow(row, single_row_data, single_row_columns);
+        expect_equal_vectors(wide_row_columns, single_row_columns);
+        ASSERT_EQ(wide_row_data.size(), single_row_data.size());
+        for(size_t nz = 0; nz < wide_row_data.size(); nz++)
+        {
+            EXPECT_FLOAT_EQ(wide_row_data[nz], single_row_data[nz]);
+        }
+    }
+
+    // modifications and transposes keep the storage
+    std::vector<double> row_factors(num_rows);
+    uniform_rand_double(.5, 2., row_factors);
+    wideMatrix.rowNormalize(row_factors);
+    singleMatrix.rowNormalize(row_factors);
+    example::CompressedRowSparseMatrix* wideTranspose = example::transposeCompressedRowSparseMatrix(&wideMatrix);
+    example::CompressedRowSparseMatrix* singleTranspose = example::transposeCompressedRowSparseMatrix(&singleMatrix);
+    std::vector<double> x(num_rows);
+    uniform_rand_double(-1., 1., x);
+    std::vector<double> wide_b;
+    wideTranspose->matVec(x, wide_b, false);
+    std::vector<double> single_b;
+    singleMatrix.matVec(x, single_b, true);
+    std::vector<double> single_transpose_b;
+    singleTranspose->matVec(x, single_transpose_b, false);
+    ASSERT_EQ(wide_b.size(), single_b.size());
+    for(size_t i = 0; i < wide_b.size(); i++)
+    {
+        EXPECT_NEAR(wide_b[i], single_b[i], 2. * single_tolerance);
+        EXPECT_NEAR(wide_b[i], single_transpose_b[i], 2. * single_tolerance);
+    }
+    delete wideTranspose;
+    delete singleTranspose;
+}
+
 PSL_TEST(CompressedRowSparseMatrixImplementation,sendAndRecv)
 {
     set_rand_seed();
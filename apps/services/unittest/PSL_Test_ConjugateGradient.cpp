@@ -187,6 +187,153 @@ PSL_TEST(ConjugateGradient,nonPositiveDefinite)
     safe_free(matrix);
 }
 
+void build_random_positive_definite(const size_t& dimension, const double& max_log_scale, std::vector<double>& values)
+{
+    // B'B + nI, then scaled symmetrically by powers of ten
+    std::vector<double> B(dimension * dimension);
+    uniform_rand_double(-1., 1., B);
+    std::vector<double> scales(dimension);
+    uniform_rand_double(0., max_log_scale, scales);
+    values.assign(dimension * dimension, 0.);
+    for(size_t row = 0; row < dimension; row++)
+    {
+        for(size_t column = 0; column < dimension; column++)
+        {
+            double value = (row == column ? double(dimension) : 0.);
+            for(size_t k = 0; k < dimension; k++)
+            {
+                value += B[k * dimension + row] * B[k * dimension + column];
+            }
+            values[row * dimension + column] = value * pow(10., scales[row] + scales[column]);
+        }
+    }
+}
+
+PSL_TEST(ConjugateGradient,preconditionedThreeByThree)
+{
+    set_rand_seed();
+    // test solve(...) success for each preconditioner
+    ConjugateGradientTest_AllocateUtilities
+
+    // allocate problem
+    const size_t nrows = 3;
+    const size_t ncols = 3;
+    std::vector<double> matrix_values = {10., 2., 5., 2., 6., 8., 5., 8., 12.};
+    AbstractInterface::DenseMatrix* matrix = builder->build_by_row_major(nrows, ncols, matrix_values);
+    std::vector<double> rhs = {21., -14., -13.};
+
+    const std::vector<preconditioner_t::preconditioner_t> preconditioners = {preconditioner_t::jacobi_preconditioner,
+                                                                             preconditioner_t::incomplete_cholesky_preconditioner};
+    for(size_t p = 0; p < preconditioners.size(); p++)
+    {
+        cg_solver.setPreconditioner(preconditioners[p]);
+
+        // solve
+        std::vector<double> x;
+        const bool converged = solver->solve(matrix, rhs, x);
+        EXPECT_EQ(converged, true);
+        ASSERT_EQ(x.size(), ncols);
+        EXPECT_FLOAT_EQ(x[0], 3.);
+        EXPECT_FLOAT_EQ(x[1], -2.);
+        EXPECT_FLOAT_EQ(x[2], -1.);
+    }
+
+    // clean up
+    safe_free(matrix);
+}
+
+PSL_TEST(ConjugateGradient,preconditionedFewerIterations)
+{
+    set_rand_seed();
+    // test preconditioners reduce iterations for a badly scaled matrix
+    ConjugateGradientTest_AllocateUtilities
+    cg_solver.setTolerance(1e-16);
+
+    // allocate problem
+    const size_t dimension = 30;
+    std::vector<double> matrix_values;
+    build_random_positive_definite(dimension, 2., matrix_values);
+    AbstractInterface::DenseMatrix* matrix = builder->build_by_row_major(dimension, dimension, matrix_values);
+    std::vector<double> rhs(dimension);
+    uniform_rand_double(-1., 1., rhs);
+
+    // solve
+    std::vector<double> x;
+    solver->solve(matrix, rhs, x);
+    const size_t unpreconditioned_iterations = cg_solver.getNumIterations();
+    cg_solver.setPreconditioner(preconditioner_t::jacobi_preconditioner);
+    EXPECT_EQ(solver->solve(matrix, rhs, x), true);
+    const size_t jacobi_iterations = cg_solver.getNumIterations();
+    cg_solver.setPreconditioner(preconditioner_t::incomplete_cholesky_preconditioner);
+    EXPECT_EQ(solver->solve(matrix, rhs, x), true);
+    const size_t cholesky_iterations = cg_solver.getNumIterations();
+    EXPECT_LT(jacobi_iterations, unpreconditioned_iterations);
+    // without zeros to drop, the incomplete factor is complete
+    EXPECT_LE(cholesky_iterations, 2u);
+
+    // check residual
+    std::vector<double> Ax;
+    matrix->matvec(x, Ax, false);
+    for(size_t row = 0; row < dimension; row++)
+    {
+        EXPECT_NEAR(Ax[row], rhs[row], 1e-6);
+    }
+
+    // clean up
+    safe_free(matrix);
+}
+
+PSL_TEST(ConjugateGradient,blockMultipleRightHandSides)
+{
+    set_rand_seed();
+    // test solve_multiple(...) against single solves, including a repeated right hand side that breaks the block
+    ConjugateGradientTest_AllocateUtilities
+    cg_solver.setTolerance(1e-20);
+
+    // allocate problem
+    const size_t dimension = 20;
+    std::vector<double> matrix_values;
+    build_random_positive_definite(dimension, 1., matrix_values);
+    AbstractInterface::DenseMatrix* matrix = builder->build_by_row_major(dimension, dimension, matrix_values);
+    const size_t num_rhs = 4;
+    std::vector<std::vector<double> > rhs(num_rhs, std::vector<double>(dimension));
+    for(size_t r = 0; r < num_rhs; r++)
+    {
+        uniform_rand_double(-1., 1., rhs[r]);
+    }
+    std::vector<std::vector<double> > repeated_rhs(rhs);
+    repeated_rhs.push_back(rhs[1]);
+
+    const std::vector<preconditioner_t::preconditioner_t> preconditioners = {preconditioner_t::no_preconditioner,
+                                                                             preconditioner_t::jacobi_preconditioner,
+                                                                             preconditioner_t::incomplete_cholesky_preconditioner};
+    for(size_t p = 0; p < preconditioners.size(); p++)
+    {
+        cg_solver.setPreconditioner(preconditioners[p]);
+
+        // solve
+        std::vector<std::vector<double> > block_x;
+        EXPECT_EQ(solver->solve_multiple(matrix, rhs, block_x), true);
+        ASSERT_EQ(block_x.size(), num_rhs);
+        // block krylov spaces grow by num_rhs each iteration
+        EXPECT_LE(cg_solver.getNumIterations(), dimension / num_rhs + 1u);
+        std::vector<std::vector<double> > repeated_x;
+        EXPECT_EQ(solver->solve_multiple(matrix, repeated_rhs, repeated_x), true);
+        ASSERT_EQ(repeated_x.size(), num_rhs + 1u);
+        for(size_t r = 0; r < num_rhs; r++)
+        {
+            std::vector<double> x;
+            EXPECT_EQ(solver->solve(matrix, rhs[r], x), true);
+            expect_near_vectors(block_x[r], x, 1e-6);
+            expect_near_vectors(repeated_x[r], x, 1e-6);
+        }
+        expect_near_vectors(repeated_x[num_rhs], repeated_x[1], 1e-6);
+    }
+
+    // clean up
+    safe_free(matrix);
+}
+
 }
 
 }
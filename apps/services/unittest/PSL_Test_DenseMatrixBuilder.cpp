@@ -44,6 +44,9 @@
 #include "PSL_UnitTestingHelper.hpp"
 
 #include "PSL_Interface_DenseMatrixBuilder.hpp"
+#include "PSL_Interface_ContiguousDenseMatrix.hpp"
+#include "PSL_Interface_CholeskySolver.hpp"
+#include "PSL_Abstract_PositiveDefiniteLinearSolver.hpp"
 #include "PSL_Interface_BasicGlobalUtilities.hpp"
 #include "PSL_Abstract_DenseMatrix.hpp"
 #include "PSL_FreeHelpers.hpp"
@@ -765,6 +768,148 @@ PSL_TEST(DenseMatrixBuilder,getRowAndColumn)
     safe_free(matrix);
 }
 
+PSL_TEST(DenseMatrixBuilder,contiguousToDefault)
+{
+    set_rand_seed();
+    DenseMatrixBuilderTest_AllocateUtilities
+    example::Interface_DenseMatrixBuilder contiguous_builder(&utilities);
+    contiguous_builder.set_contiguous_storage(true);
+
+    // sizes span several product tiles
+    const size_t nrows = 70;
+    const size_t inner = 150;
+    const size_t ncols = 530;
+    for(int X_transpose = 0; X_transpose < 2; X_transpose++)
+    {
+        for(int Y_transpose = 0; Y_transpose < 2; Y_transpose++)
+        {
+            std::vector<double> X_values(nrows * inner);
+            uniform_rand_double(-1., 1., X_values);
+            std::vector<double> Y_values(inner * ncols);
+            uniform_rand_double(-1., 1., Y_values);
+            const size_t X_rows = (X_transpose ? inner : nrows);
+            const size_t Y_rows = (Y_transpose ? ncols : inner);
+
+            AbstractInterface::DenseMatrix* X_default = builder->build_by_row_major(X_rows, nrows * inner / X_rows, X_values);
+            AbstractInterface::DenseMatrix* Y_default = builder->build_by_row_major(Y_rows, inner * ncols / Y_rows, Y_values);
+            AbstractInterface::DenseMatrix* result_default = builder->build_by_fill(nrows, ncols, 0.);
+            AbstractInterface::DenseMatrix* X_contiguous = contiguous_builder.build_by_row_major(X_rows, nrows * inner / X_rows, X_values);
+            AbstractInterface::DenseMatrix* Y_contiguous = contiguous_builder.build_by_row_major(Y_rows, inner * ncols / Y_rows, Y_values);
+            AbstractInterface::DenseMatrix* result_contiguous = contiguous_builder.build_by_fill(nrows, ncols, 0.);
+            EXPECT_NE(dynamic_cast<example::Interface_ContiguousDenseMatrix*>(result_contiguous), (void*)NULL);
+
+            // compute products
+            result_default->matrix_matrix_product(-1.5, X_default, X_transpose, Y_default, Y_transpose);
+            result_contiguous->matrix_matrix_product(-1.5, X_contiguous, X_transpose, Y_contiguous, Y_transpose);
+            ASSERT_EQ(result_contiguous->get_num_rows(), nrows);
+            ASSERT_EQ(result_contiguous->get_num_columns(), ncols);
+            for(size_t row = 0; row < nrows; row++)
+            {
+                for(size_t column = 0; column < ncols; column++)
+                {
+                    EXPECT_NEAR(result_default->get_value(row, column), result_contiguous->get_value(row, column), 1e-11);
+                }
+            }
+
+            // vector operations
+            std::vector<double> in(ncols);
+            uniform_rand_double(-1., 1., in);
+            std::vector<double> out_default;
+            std::vector<double> out_contiguous;
+            result_default->matvec(in, out_default, false);
+            result_contiguous->matvec(in, out_contiguous, false);
+            expect_near_vectors(out_default, out_contiguous, 1e-10);
+            std::vector<double> in_transpose(nrows);
+            uniform_rand_double(-1., 1., in_transpose);
+            result_default->matvec(in_transpose, out_default, true);
+            result_contiguous->matvec(in_transpose, out_contiguous, true);
+            expect_near_vectors(out_default, out_contiguous, 1e-10);
+            EXPECT_NEAR(result_default->dot(result_default), result_contiguous->dot(result_contiguous), 1e-6);
+            result_contiguous->aXpY(-1., result_default);
+            EXPECT_NEAR(result_contiguous->dot(result_contiguous), 0., 1e-16);
+
+            safe_free(X_default);
+            safe_free(Y_default);
+            safe_free(result_default);
+            safe_free(X_contiguous);
+            safe_free(Y_contiguous);
+            safe_free(result_contiguous);
+        }
+    }
+}
+
+PSL_TEST(DenseMatrixBuilder,contiguousFactorizations)
+{
+    set_rand_seed();
+    DenseMatrixBuilderTest_AllocateUtilities
+    example::Interface_DenseMatrixBuilder contiguous_builder(&utilities);
+    contiguous_builder.set_contiguous_storage(true);
+
+    // positive definite B'B + nI, and B itself
+    const size_t dimension = 40;
+    std::vector<double> B_values(dimension * dimension);
+    uniform_rand_double(-1., 1., B_values);
+    AbstractInterface::DenseMatrix* B = contiguous_builder.build_by_row_major(dimension, dimension, B_values);
+    AbstractInterface::DenseMatrix* positive_definite = contiguous_builder.build_by_fill(dimension, dimension, 0.);
+    positive_definite->matrix_matrix_product(1., B, true, B, false);
+    AbstractInterface::DenseMatrix* identity = contiguous_builder.build_by_fill(dimension, dimension, 0.);
+    identity->set_to_identity();
+    positive_definite->aXpY(double(dimension), identity);
+
+    std::vector<double> rhs(dimension);
+    uniform_rand_double(-1., 1., rhs);
+    std::vector<double> sol;
+    std::vector<double> check;
+
+    // cholesky
+    example::Interface_ContiguousDenseMatrix* positive_definite_casted = dynamic_cast<example::Interface_ContiguousDenseMatrix*>(positive_definite);
+    ASSERT_NE(positive_definite_casted, (void*)NULL);
+    EXPECT_EQ(positive_definite_casted->factor_cholesky(), true);
+    positive_definite_casted->solve_factored(rhs, sol);
+    positive_definite->matvec(sol, check, false);
+    expect_near_vectors(check, rhs, 1e-10);
+
+    // lu
+    example::Interface_ContiguousDenseMatrix* B_casted = dynamic_cast<example::Interface_ContiguousDenseMatrix*>(B);
+    ASSERT_NE(B_casted, (void*)NULL);
+    EXPECT_EQ(B_casted->factor_lu(), true);
+    B_casted->solve_factored(rhs, sol);
+    B->matvec(sol, check, false);
+    expect_near_vectors(check, rhs, 1e-9);
+    EXPECT_EQ(B_casted->factor_cholesky(), false);
+
+    // direct solver, from default storage too
+    example::Interface_CholeskySolver cholesky_solver(&utilities);
+    AbstractInterface::PositiveDefiniteLinearSolver* solver = &cholesky_solver;
+    std::vector<double> positive_definite_values(dimension * dimension);
+    for(size_t row = 0; row < dimension; row++)
+    {
+        for(size_t column = 0; column < dimension; column++)
+        {
+            positive_definite_values[row * dimension + column] = positive_definite->get_value(row, column);
+        }
+    }
+    AbstractInterface::DenseMatrix* positive_definite_default = builder->build_by_row_major(dimension, dimension, positive_definite_values);
+    std::vector<std::vector<double> > multiple_rhs(3, std::vector<double>(dimension));
+    for(size_t r = 0; r < multiple_rhs.size(); r++)
+    {
+        uniform_rand_double(-1., 1., multiple_rhs[r]);
+    }
+    std::vector<std::vector<double> > multiple_sol;
+    EXPECT_EQ(solver->solve_multiple(positive_definite_default, multiple_rhs, multiple_sol), true);
+    for(size_t r = 0; r < multiple_rhs.size(); r++)
+    {
+        positive_definite_default->matvec(multiple_sol[r], check, false);
+        expect_near_vectors(check, multiple_rhs[r], 1e-10);
+    }
+    EXPECT_EQ(solver->solve(B, rhs, sol), false);
+
+    safe_free(B);
+    safe_free(positive_definite);
+    safe_free(identity);
+    safe_free(positive_definite_default);
+}
+
 }
 
 }
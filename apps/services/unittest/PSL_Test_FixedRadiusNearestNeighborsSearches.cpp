@@ -48,7 +48,11 @@
 #include "PSL_FreeHelpers.hpp"
 #include "PSL_Abstract_FixedRadiusNearestNeighborsSearcher.hpp"
 #include "PSL_RadixGridFixedRadiusNearestNeighbors.hpp"
+#include "PSL_CellListFixedRadiusNearestNeighbors.hpp"
 #include "PSL_BruteForceFixedRadiusNearestNeighbors.hpp"
+#ifdef AMFILTER_ENABLED
+#include "PSL_ArborXFixedRadiusNearestNeighbors.hpp"
+#endif
 #include "PSL_SpatialSearcherFactory.hpp"
 #include "PSL_Random.hpp"
 
@@ -64,6 +68,7 @@ namespace FixedRadiusNearestNeighborsSearchesTest
 void get_random_points_in_unit_cube(std::vector<PlatoSubproblemLibrary::Point>& test_points);
 void rigorous_search_comparison(AbstractInterface::FixedRadiusNearestNeighborsSearcher* searcher);
 void handle_zero_radius(spatial_searcher_t::spatial_searcher_t searcher_type);
+void batched_search_comparison(AbstractInterface::FixedRadiusNearestNeighborsSearcher* searcher);
 
 PSL_TEST(FixedRadiusNearestNeighborsSearches,simpleRadixGrid)
 {
@@ -199,6 +204,61 @@ PSL_TEST(FixedRadiusNearestNeighborsSearches,rigorousRadixGrid)
     rigorous_search_comparison(&searcher);
 }
 
+PSL_TEST(FixedRadiusNearestNeighborsSearches,rigorousCellList)
+{
+    set_rand_seed();
+    CellListFixedRadiusNearestNeighbors searcher;
+    rigorous_search_comparison(&searcher);
+}
+
+PSL_TEST(FixedRadiusNearestNeighborsSearches,cellListMatchesRadixGridOnLattice)
+{
+    // lattice spacing divides the radius, so many neighbors lie exactly on the search sphere
+    const size_t points_per_side = 9u;
+    const double spacing = 0.1;
+    const double radius = 2. * spacing;
+
+    std::vector<Point> lattice_points;
+    for(size_t i = 0u; i < points_per_side; i++)
+    {
+        for(size_t j = 0u; j < points_per_side; j++)
+        {
+            for(size_t k = 0u; k < points_per_side; k++)
+            {
+                std::vector<double> data = {spacing * i, spacing * j, spacing * k};
+                lattice_points.push_back(PlatoSubproblemLibrary::Point(lattice_points.size(), data));
+            }
+        }
+    }
+    const size_t num_points = lattice_points.size();
+    PlatoSubproblemLibrary::PointCloud point_cloud;
+    point_cloud.assign(lattice_points);
+
+    RadixGridFixedRadiusNearestNeighbors radix_searcher;
+    radix_searcher.build(&point_cloud, radius);
+    CellListFixedRadiusNearestNeighbors cell_list_searcher;
+    cell_list_searcher.build(&point_cloud, radius);
+
+    std::vector<size_t> radix_results(num_points);
+    std::vector<size_t> cell_list_results(num_points);
+    for(size_t i = 0u; i < num_points; i++)
+    {
+        size_t num_radix_results = 0u;
+        radix_searcher.get_neighbors(&lattice_points[i], radix_results, num_radix_results);
+        size_t num_cell_list_results = 0u;
+        cell_list_searcher.get_neighbors(&lattice_points[i], cell_list_results, num_cell_list_results);
+
+        std::sort(&radix_results[0], &radix_results[num_radix_results]);
+        std::sort(&cell_list_results[0], &cell_list_results[num_cell_list_results]);
+
+        ASSERT_EQ(num_cell_list_results, num_radix_results);
+        for(size_t j = 0u; j < num_radix_results; j++)
+        {
+            EXPECT_EQ(cell_list_results[j], radix_results[j]);
+        }
+    }
+}
+
 PSL_TEST(FixedRadiusNearestNeighborsSearches,rigorousBruteForce)
 {
     set_rand_seed();
@@ -206,6 +266,76 @@ PSL_TEST(FixedRadiusNearestNeighborsSearches,rigorousBruteForce)
     rigorous_search_comparison(&searcher);
 }
 
+void batched_search_comparison(AbstractInterface::FixedRadiusNearestNeighborsSearcher* searcher)
+{
+    // compare batched neighbors of a point cloud to neighbors of each point
+
+    const size_t num_points = 200;
+    const double radius = 0.15;
+
+    std::vector<Point> points_A(num_points);
+    get_random_points_in_unit_cube(points_A);
+    PlatoSubproblemLibrary::PointCloud point_cloud_A;
+    point_cloud_A.assign(points_A);
+
+    std::vector<Point> points_B(num_points);
+    get_random_points_in_unit_cube(points_B);
+    PlatoSubproblemLibrary::PointCloud point_cloud_B;
+    point_cloud_B.assign(points_B);
+
+    searcher->build(&point_cloud_B, radius);
+
+    std::vector<size_t> neighbor_offsets;
+    std::vector<size_t> neighbor_indexes;
+    searcher->get_all_neighbors(&point_cloud_A, num_points, neighbor_offsets, neighbor_indexes);
+    ASSERT_EQ(neighbor_offsets.size(), num_points + 1u);
+    EXPECT_EQ(neighbor_offsets[0], 0u);
+    EXPECT_EQ(neighbor_offsets.back(), neighbor_indexes.size());
+    EXPECT_GT(neighbor_indexes.size(), num_points);
+
+    std::vector<size_t> results(num_points);
+    size_t num_results = 0;
+    for(size_t i = 0; i < num_points; i++)
+    {
+        num_results = 0u;
+        searcher->get_neighbors(&points_A[i], results, num_results);
+        std::sort(&results[0], &results[num_results]);
+
+        std::vector<size_t> batched_results(neighbor_indexes.begin() + neighbor_offsets[i],
+                                            neighbor_indexes.begin() + neighbor_offsets[i + 1u]);
+        std::sort(batched_results.begin(), batched_results.end());
+
+        ASSERT_EQ(batched_results.size(), num_results);
+        for(size_t j = 0; j < num_results; j++)
+        {
+            EXPECT_EQ(batched_results[j], results[j]);
+        }
+    }
+}
+
+PSL_TEST(FixedRadiusNearestNeighborsSearches,batchedCellList)
+{
+    set_rand_seed();
+    CellListFixedRadiusNearestNeighbors searcher;
+    batched_search_comparison(&searcher);
+}
+
+#ifdef AMFILTER_ENABLED
+PSL_TEST(FixedRadiusNearestNeighborsSearches,rigorousArborX)
+{
+    set_rand_seed();
+    ArborXFixedRadiusNearestNeighbors searcher;
+    rigorous_search_comparison(&searcher);
+}
+
+PSL_TEST(FixedRadiusNearestNeighborsSearches,batchedArborX)
+{
+    set_rand_seed();
+    ArborXFixedRadiusNearestNeighbors searcher;
+    batched_search_comparison(&searcher);
+}
+#endif
+
 void handle_zero_radius(spatial_searcher_t::spatial_searcher_t searcher_type)
 {
     const size_t num_answer_points = 100u;
@@ -277,6 +407,20 @@ PSL_TEST(FixedRadiusNearestNeighborsSearches,handleZeroRadius_radixGridFixedRadi
     handle_zero_radius(spatial_searcher_t::spatial_searcher_t::radix_grid_fixed_radius_nearest_neighbors);
 }
 
+PSL_TEST(FixedRadiusNearestNeighborsSearches,handleZeroRadius_cellListFixedRadiusNearestNeighbors)
+{
+    set_rand_seed();
+    handle_zero_radius(spatial_searcher_t::spatial_searcher_t::cell_list_fixed_radius_nearest_neighbors);
+}
+
+#ifdef AMFILTER_ENABLED
+PSL_TEST(FixedRadiusNearestNeighborsSearches,handleZeroRadius_arborXFixedRadiusNearestNeighbors)
+{
+    set_rand_seed();
+    handle_zero_radius(spatial_searcher_t::spatial_searcher_t::arborx_fixed_radius_nearest_neighbors);
+}
+#endif
+
 }
 
 }
@@ -52,6 +52,7 @@
 #include "PSL_Abstract_GlobalUtilities.hpp"
 #include "PSL_FreeHelpers.hpp"
 #include "PSL_KernelFilter.hpp"
+#include "PSL_KernelFilterCache.hpp"
 #include "PSL_Interface_PointCloud.hpp"
 #include "PSL_BruteForceFixedRadiusNearestNeighbors.hpp"
 #include "PSL_BoundingBoxMortonHierarchy.hpp"
@@ -67,6 +68,7 @@
 #include "PSL_Interface_BasicDenseVectorOperations.hpp"
 #include "PSL_Abstract_DenseVectorOperations.hpp"
 #include "PSL_Point.hpp"
+#include "PSL_PointCloud.hpp"
 #include "PSL_Interface_ParallelExchanger_localAndNonlocal.hpp"
 #include "PSL_Abstract_ParallelExchanger.hpp"
 #include "PSL_Interface_ParallelExchanger_global.hpp"
@@ -77,6 +79,7 @@
 #include <string>
 #include <cstddef>
 #include <sstream>
+#include <cstdio>
 
 namespace PlatoSubproblemLibrary
 {
@@ -790,6 +793,869 @@ PSL_TEST(KernelFilter,searchMethodsMortonToRadixGrid)
     kernel_filter_test_two_methods(&authority, &kernel_Morton, &kernel_RadixGrid, 5u);//500u);
 }
 
+PSL_TEST(KernelFilter,searchMethodsRadixGridToCellList)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+
+    ParameterData inputData_RadixGrid;
+    inputData_RadixGrid.set_absolute(3.5);
+    inputData_RadixGrid.set_iterations(1);
+    inputData_RadixGrid.set_penalty(1.);
+    inputData_RadixGrid.set_node_resolution_tolerance(1e-6);
+    inputData_RadixGrid.set_spatial_searcher(spatial_searcher_t::radix_grid_fixed_radius_nearest_neighbors);
+    inputData_RadixGrid.set_normalization(normalization_t::classical_row_normalization);
+    inputData_RadixGrid.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_RadixGrid.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_RadixGrid.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_RadixGrid.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_RadixGrid.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_RadixGrid.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_RadixGrid.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    // radix grid search
+    KernelFilter kernel_RadixGrid(&authority,
+                                  &inputData_RadixGrid,
+                                  NULL,
+                                  NULL);
+
+    // cell list search
+    ParameterData inputData_CellList = inputData_RadixGrid;
+    inputData_CellList.set_spatial_searcher(spatial_searcher_t::cell_list_fixed_radius_nearest_neighbors);
+    KernelFilter kernel_CellList(&authority,
+                                 &inputData_CellList,
+                                 NULL,
+                                 NULL);
+
+    // compare
+    kernel_filter_test_two_methods(&authority, &kernel_RadixGrid, &kernel_CellList, 5u);
+}
+
+PSL_TEST(KernelFilter,matrixAssemblyByRowToByRowSinglePass)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+
+    ParameterData inputData_ByRow;
+    inputData_ByRow.set_absolute(3.5);
+    inputData_ByRow.set_iterations(1);
+    inputData_ByRow.set_penalty(1.);
+    inputData_ByRow.set_node_resolution_tolerance(1e-6);
+    inputData_ByRow.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_ByRow.set_normalization(normalization_t::classical_row_normalization);
+    inputData_ByRow.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_ByRow.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_ByRow.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_ByRow.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_ByRow.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_ByRow.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_ByRow.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    // by row assembly
+    KernelFilter kernel_ByRow(&authority,
+                              &inputData_ByRow,
+                              NULL,
+                              NULL);
+
+    // single pass assembly
+    ParameterData inputData_SinglePass = inputData_ByRow;
+    inputData_SinglePass.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row_single_pass);
+    KernelFilter kernel_SinglePass(&authority,
+                                   &inputData_SinglePass,
+                                   NULL,
+                                   NULL);
+
+    // compare
+    kernel_filter_test_two_methods(&authority, &kernel_ByRow, &kernel_SinglePass, 5u);
+}
+
+PSL_TEST(KernelFilter,pointGhostingByNarrowShareToByNeighborExchange)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+
+    ParameterData inputData_NarrowShare;
+    inputData_NarrowShare.set_absolute(3.5);
+    inputData_NarrowShare.set_iterations(1);
+    inputData_NarrowShare.set_penalty(1.);
+    inputData_NarrowShare.set_node_resolution_tolerance(1e-6);
+    inputData_NarrowShare.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_NarrowShare.set_normalization(normalization_t::classical_row_normalization);
+    inputData_NarrowShare.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_NarrowShare.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_NarrowShare.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_NarrowShare.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_NarrowShare.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_NarrowShare.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_NarrowShare.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    // narrow share ghosting
+    KernelFilter kernel_NarrowShare(&authority,
+                                    &inputData_NarrowShare,
+                                    NULL,
+                                    NULL);
+
+    // neighbor exchange ghosting
+    ParameterData inputData_NeighborExchange = inputData_NarrowShare;
+    inputData_NeighborExchange.set_point_ghosting_agent(point_ghosting_agent_t::by_neighbor_exchange);
+    KernelFilter kernel_NeighborExchange(&authority,
+                                         &inputData_NeighborExchange,
+                                         NULL,
+                                         NULL);
+
+    // compare
+    kernel_filter_test_two_methods(&authority, &kernel_NarrowShare, &kernel_NeighborExchange, 5u);
+}
+
+PSL_TEST(KernelFilter,cacheSaveThenLoad)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+
+    ParameterData inputData;
+    inputData.set_absolute(3.5);
+    inputData.set_iterations(1);
+    inputData.set_penalty(1.);
+    inputData.set_node_resolution_tolerance(1e-6);
+    inputData.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData.set_normalization(normalization_t::classical_row_normalization);
+    inputData.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+    inputData.set_kernel_filter_cache_filename("PSL_Test_KernelFilter_cacheSaveThenLoad.bin");
+
+    // start without a cache
+    KernelFilterCache cache(&authority, inputData.get_kernel_filter_cache_filename());
+    std::remove(cache.get_filename().c_str());
+
+    // first filter assembles and saves
+    KernelFilter kernel_save(&authority,
+                             &inputData,
+                             NULL,
+                             NULL);
+
+    // second filter loads
+    KernelFilter kernel_load(&authority,
+                             &inputData,
+                             NULL,
+                             NULL);
+
+    // compare
+    kernel_filter_test_two_methods(&authority, &kernel_save, &kernel_load, 5u);
+    EXPECT_FALSE(kernel_save.is_built_from_cache());
+    EXPECT_TRUE(kernel_load.is_built_from_cache());
+
+    // a different radius misses the cache
+    ParameterData inputData_otherRadius = inputData;
+    inputData_otherRadius.set_absolute(2.5);
+    KernelFilter kernel_otherRadius(&authority,
+                                    &inputData_otherRadius,
+                                    NULL,
+                                    NULL);
+    KernelFilter kernel_otherRadiusLoad(&authority,
+                                        &inputData_otherRadius,
+                                        NULL,
+                                        NULL);
+    kernel_filter_test_two_methods(&authority, &kernel_otherRadius, &kernel_otherRadiusLoad, 5u);
+    EXPECT_FALSE(kernel_otherRadius.is_built_from_cache());
+    EXPECT_TRUE(kernel_otherRadiusLoad.is_built_from_cache());
+
+    std::remove(cache.get_filename().c_str());
+}
+
+PSL_TEST(KernelFilter,matrixFreeToAssembled)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    ParameterData inputData_assembled;
+    inputData_assembled.set_absolute(2.5);
+    inputData_assembled.set_iterations(2);
+    inputData_assembled.set_penalty(1.);
+    inputData_assembled.set_node_resolution_tolerance(1e-6);
+    inputData_assembled.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_assembled.set_normalization(normalization_t::classical_row_normalization);
+    inputData_assembled.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_assembled.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_assembled.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_assembled.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_assembled.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_assembled.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_assembled.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    ParameterData inputData_matrixFree = inputData_assembled;
+    inputData_matrixFree.set_kernel_filter_matrix_free(true);
+
+    // proc's are stacked in x
+    const size_t num_horiz_points = 9u;
+    const size_t num_vert_points = 8u;
+    const size_t num_local_points = num_horiz_points * num_vert_points;
+    example::Interface_PointCloud local_points;
+    build_brick_of_points(&local_points, num_vert_points, num_horiz_points, 1., 1., mpi_rank * num_horiz_points * 1., 0., 0.);
+
+    example::Interface_ParallelExchanger_localAndNonlocal exchanger(&authority);
+    std::vector<std::vector<std::pair<size_t, size_t> > > shared_node_data(mpi_size);
+    exchanger.put_shared_pairs(shared_node_data);
+    exchanger.put_num_local_locations(num_local_points);
+    exchanger.build();
+
+    KernelFilter kernel_assembled(&authority, &inputData_assembled, &local_points, &exchanger);
+    kernel_assembled.build();
+    KernelFilter kernel_matrixFree(&authority, &inputData_matrixFree, &local_points, &exchanger);
+    kernel_matrixFree.build();
+
+    // fill field arbitrarily
+    std::vector<double> field(num_local_points);
+    uniform_rand_double(0., 1., field);
+
+    // apply on field
+    example::Interface_ParallelVector field_assembled(field);
+    example::Interface_ParallelVector field_matrixFree(field);
+    kernel_assembled.apply(&field_assembled);
+    kernel_matrixFree.apply(&field_matrixFree);
+    for(size_t local_point = 0; local_point < num_local_points; local_point++)
+    {
+        EXPECT_NEAR(field_assembled.get_value(local_point), field_matrixFree.get_value(local_point), 1e-12);
+    }
+
+    // apply on gradient
+    example::Interface_ParallelVector gradient_assembled(field);
+    example::Interface_ParallelVector gradient_matrixFree(field);
+    kernel_assembled.apply(NULL, &gradient_assembled);
+    kernel_matrixFree.apply(NULL, &gradient_matrixFree);
+    for(size_t local_point = 0; local_point < num_local_points; local_point++)
+    {
+        EXPECT_NEAR(gradient_assembled.get_value(local_point), gradient_matrixFree.get_value(local_point), 1e-12);
+    }
+}
+
+PSL_TEST(KernelFilter,structuredStencilToAssembled)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    // structured hex mesh, split across processors
+    example::ElementBlock modular_block;
+    modular_block.build_from_structured_grid(6, 5, 7, 1., 0.5, 1., mpi_rank, mpi_size);
+    example::Interface_MeshModular modular_interface;
+    modular_interface.set_mesh(&modular_block);
+    const size_t num_points = modular_interface.get_num_points();
+
+    ParameterData inputData_stencil;
+    inputData_stencil.set_absolute(1.8);
+    inputData_stencil.set_iterations(2);
+    inputData_stencil.set_penalty(2.);
+    inputData_stencil.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_stencil.set_normalization(normalization_t::classical_row_normalization);
+    inputData_stencil.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_stencil.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_stencil.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_stencil.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_stencil.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_stencil.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_stencil.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+    inputData_stencil.set_kernel_filter_structured_stencil(true);
+
+    ParameterData inputData_assembled = inputData_stencil;
+    inputData_assembled.set_kernel_filter_structured_stencil(false);
+
+    example::Interface_ParallelExchanger_global exchanger(&authority);
+    std::vector<size_t> global_ids;
+    modular_block.get_global_ids(global_ids);
+    exchanger.put_globals(global_ids);
+    exchanger.build();
+
+    KernelFilter kernel_stencil(&authority, &inputData_stencil, &modular_interface, &exchanger);
+    kernel_stencil.build();
+    KernelFilter kernel_assembled(&authority, &inputData_assembled, &modular_interface, &exchanger);
+    kernel_assembled.build();
+    EXPECT_EQ(kernel_stencil.is_built_as_structured_stencil(), true);
+    EXPECT_EQ(kernel_assembled.is_built_as_structured_stencil(), false);
+
+    // fill field consistently on shared nodes
+    std::vector<double> field(num_points);
+    uniform_rand_double(0., 1., field);
+    example::Interface_ParallelVector parallel_field(field);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_field), &parallel_field);
+    parallel_field.get_values(field);
+
+    // apply on field
+    example::Interface_ParallelVector field_stencil(field);
+    example::Interface_ParallelVector field_assembled(field);
+    kernel_stencil.apply(&field_stencil);
+    kernel_assembled.apply(&field_assembled);
+    for(size_t point = 0; point < num_points; point++)
+    {
+        EXPECT_NEAR(field_stencil.get_value(point), field_assembled.get_value(point), 1e-12);
+    }
+
+    // apply on gradient
+    example::Interface_ParallelVector gradient_stencil(field);
+    example::Interface_ParallelVector gradient_assembled(field);
+    kernel_stencil.apply(NULL, &gradient_stencil);
+    kernel_assembled.apply(NULL, &gradient_assembled);
+    for(size_t point = 0; point < num_points; point++)
+    {
+        EXPECT_NEAR(gradient_stencil.get_value(point), gradient_assembled.get_value(point), 1e-12);
+    }
+}
+
+PSL_TEST(KernelFilter,structuredStencilDeclinedOffLattice)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    ParameterData input_data;
+    input_data.set_absolute(2.5);
+    input_data.set_iterations(1);
+    input_data.set_penalty(1.);
+    input_data.set_node_resolution_tolerance(1e-6);
+    input_data.set_spatial_searcher(spatial_searcher_t::recommended);
+    input_data.set_normalization(normalization_t::classical_row_normalization);
+    input_data.set_reproduction(reproduction_level_t::reproduce_constant);
+    input_data.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    input_data.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    input_data.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    input_data.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    input_data.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    input_data.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+    input_data.set_kernel_filter_structured_stencil(true);
+
+    // brick with one point moved off the lattice on the last processor
+    const size_t num_horiz_points = 6u;
+    const size_t num_vert_points = 5u;
+    const size_t num_local_points = num_horiz_points * num_vert_points;
+    example::Interface_PointCloud local_points;
+    build_brick_of_points(&local_points, num_vert_points, num_horiz_points, 1., 1., mpi_rank * num_horiz_points * 1., 0., 0.);
+    if(mpi_rank + 1u == mpi_size)
+    {
+        std::vector<double> moved_data({mpi_rank * num_horiz_points + 2.3, 2.1, 0.});
+        local_points.set_point_data(num_local_points / 2u, moved_data);
+    }
+
+    example::Interface_ParallelExchanger_localAndNonlocal exchanger(&authority);
+    std::vector<std::vector<std::pair<size_t, size_t> > > shared_node_data(mpi_size);
+    exchanger.put_shared_pairs(shared_node_data);
+    exchanger.put_num_local_locations(num_local_points);
+    exchanger.build();
+
+    // every processor assembles matrices if any processor is off the lattice
+    KernelFilter kernel(&authority, &input_data, &local_points, &exchanger);
+    kernel.build();
+    EXPECT_EQ(kernel.is_built_as_structured_stencil(), false);
+
+    // applying a constant is unchanged
+    std::vector<double> field(num_local_points, 0.7);
+    example::Interface_ParallelVector parallel_field(field);
+    kernel.apply(&parallel_field);
+    for(size_t point = 0; point < num_local_points; point++)
+    {
+        EXPECT_NEAR(parallel_field.get_value(point), 0.7, 1e-12);
+    }
+}
+
+PSL_TEST(KernelFilter,mortonOrderToUnordered)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    // structured hex mesh, split across processors
+    example::ElementBlock modular_block;
+    modular_block.build_from_structured_grid(6, 5, 7, 1., 0.5, 1., mpi_rank, mpi_size);
+    example::Interface_MeshModular modular_interface;
+    modular_interface.set_mesh(&modular_block);
+    const size_t num_points = modular_interface.get_num_points();
+
+    ParameterData inputData_unordered;
+    inputData_unordered.set_absolute(1.8);
+    inputData_unordered.set_iterations(2);
+    inputData_unordered.set_penalty(2.);
+    inputData_unordered.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_unordered.set_normalization(normalization_t::classical_row_normalization);
+    inputData_unordered.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_unordered.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_unordered.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_unordered.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_unordered.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_unordered.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_unordered.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    ParameterData inputData_ordered = inputData_unordered;
+    inputData_ordered.set_kernel_filter_morton_order(true);
+
+    example::Interface_ParallelExchanger_global exchanger(&authority);
+    std::vector<size_t> global_ids;
+    modular_block.get_global_ids(global_ids);
+    exchanger.put_globals(global_ids);
+    exchanger.build();
+
+    KernelFilter kernel_ordered(&authority, &inputData_ordered, &modular_interface, &exchanger);
+    kernel_ordered.enable_maintain_kernel_points();
+    kernel_ordered.build();
+    KernelFilter kernel_unordered(&authority, &inputData_unordered, &modular_interface, &exchanger);
+    kernel_unordered.enable_maintain_kernel_points();
+    kernel_unordered.build();
+
+    // fill field consistently on shared nodes
+    std::vector<double> field(num_points);
+    uniform_rand_double(0., 1., field);
+    example::Interface_ParallelVector parallel_field(field);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_field), &parallel_field);
+    parallel_field.get_values(field);
+
+    // apply on field
+    example::Interface_ParallelVector field_ordered(field);
+    example::Interface_ParallelVector field_unordered(field);
+    kernel_ordered.apply(&field_ordered);
+    kernel_unordered.apply(&field_unordered);
+    for(size_t point = 0; point < num_points; point++)
+    {
+        EXPECT_NEAR(field_ordered.get_value(point), field_unordered.get_value(point), 1e-12);
+    }
+
+    // apply on gradient
+    example::Interface_ParallelVector gradient_ordered(field);
+    example::Interface_ParallelVector gradient_unordered(field);
+    kernel_ordered.apply(NULL, &gradient_ordered);
+    kernel_unordered.apply(NULL, &gradient_unordered);
+    for(size_t point = 0; point < num_points; point++)
+    {
+        EXPECT_NEAR(gradient_ordered.get_value(point), gradient_unordered.get_value(point), 1e-12);
+    }
+
+    // transferred kernel points are in the order of fields at kernel points
+    PointCloud* points_ordered = kernel_ordered.internal_transfer_kernel_points();
+    PointCloud* points_unordered = kernel_unordered.internal_transfer_kernel_points();
+    const size_t num_kernel_points = points_unordered->get_num_points();
+    ASSERT_EQ(points_ordered->get_num_points(), num_kernel_points);
+    for(size_t kernel_point = 0; kernel_point < num_kernel_points; kernel_point++)
+    {
+        EXPECT_EQ(points_ordered->get_index(kernel_point), points_unordered->get_index(kernel_point));
+        for(size_t dimension = 0; dimension < 3u; dimension++)
+        {
+            EXPECT_EQ(points_ordered->get_coordinate(kernel_point, dimension),
+                      points_unordered->get_coordinate(kernel_point, dimension));
+        }
+    }
+    safe_free(points_ordered);
+    safe_free(points_unordered);
+}
+
+PSL_TEST(KernelFilter,compactStorageToWide)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    // structured hex mesh, split across processors
+    example::ElementBlock modular_block;
+    modular_block.build_from_structured_grid(6, 5, 7, 1., 0.5, 1., mpi_rank, mpi_size);
+    example::Interface_MeshModular modular_interface;
+    modular_interface.set_mesh(&modular_block);
+    const size_t num_points = modular_interface.get_num_points();
+
+    ParameterData inputData_wide;
+    inputData_wide.set_absolute(1.8);
+    inputData_wide.set_iterations(2);
+    inputData_wide.set_penalty(2.);
+    inputData_wide.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_wide.set_normalization(normalization_t::classical_row_normalization);
+    inputData_wide.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_wide.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_wide.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_wide.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_wide.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_wide.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_wide.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    ParameterData inputData_compact = inputData_wide;
+    inputData_compact.set_kernel_filter_compact_storage(true);
+    ParameterData inputData_single = inputData_wide;
+    inputData_single.set_kernel_filter_single_precision(true);
+
+    example::Interface_ParallelExchanger_global exchanger(&authority);
+    std::vector<size_t> global_ids;
+    modular_block.get_global_ids(global_ids);
+    exchanger.put_globals(global_ids);
+    exchanger.build();
+
+    KernelFilter kernel_wide(&authority, &inputData_wide, &modular_interface, &exchanger);
+    kernel_wide.build();
+    KernelFilter kernel_compact(&authority, &inputData_compact, &modular_interface, &exchanger);
+    kernel_compact.build();
+    KernelFilter kernel_single(&authority, &inputData_single, &modular_interface, &exchanger);
+    kernel_single.build();
+
+    // fill field consistently on shared nodes
+    std::vector<double> field(num_points);
+    uniform_rand_double(0., 1., field);
+    example::Interface_ParallelVector parallel_field(field);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_field), &parallel_field);
+    parallel_field.get_values(field);
+
+    // compact indexes only change summation order, single precision weights are accurate to float rounding
+    const double single_tolerance = 1e-6;
+    example::Interface_ParallelVector field_wide(field);
+    example::Interface_ParallelVector field_compact(field);
+    example::Interface_ParallelVector field_single(field);
+    kernel_wide.apply(&field_wide);
+    kernel_compact.apply(&field_compact);
+    kernel_single.apply(&field_single);
+    example::Interface_ParallelVector gradient_wide(field);
+    example::Interface_ParallelVector gradient_compact(field);
+    example::Interface_ParallelVector gradient_single(field);
+    kernel_wide.apply(NULL, &gradient_wide);
+    kernel_compact.apply(NULL, &gradient_compact);
+    kernel_single.apply(NULL, &gradient_single);
+    for(size_t point = 0; point < num_points; point++)
+    {
+        EXPECT_NEAR(field_wide.get_value(point), field_compact.get_value(point), 1e-12);
+        EXPECT_NEAR(field_wide.get_value(point), field_single.get_value(point), single_tolerance);
+        EXPECT_NEAR(gradient_wide.get_value(point), gradient_compact.get_value(point), 1e-12);
+        EXPECT_NEAR(gradient_wide.get_value(point), gradient_single.get_value(point), single_tolerance);
+    }
+}
+
+PSL_TEST(KernelFilter,storedTransposeToScattered)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    // structured hex mesh, split across processors
+    example::ElementBlock modular_block;
+    modular_block.build_from_structured_grid(6, 7, 5, 1., 1., 0.5, mpi_rank, mpi_size);
+    example::Interface_MeshModular modular_interface;
+    modular_interface.set_mesh(&modular_block);
+    const size_t num_points = modular_interface.get_num_points();
+
+    ParameterData inputData_scattered;
+    inputData_scattered.set_absolute(1.8);
+    inputData_scattered.set_iterations(2);
+    inputData_scattered.set_penalty(2.);
+    inputData_scattered.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_scattered.set_normalization(normalization_t::classical_row_normalization);
+    inputData_scattered.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_scattered.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_scattered.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_scattered.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_scattered.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_scattered.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_scattered.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    ParameterData inputData_stored = inputData_scattered;
+    inputData_stored.set_kernel_filter_stored_transpose(true);
+
+    example::Interface_ParallelExchanger_global exchanger(&authority);
+    std::vector<size_t> global_ids;
+    modular_block.get_global_ids(global_ids);
+    exchanger.put_globals(global_ids);
+    exchanger.build();
+
+    KernelFilter kernel_scattered(&authority, &inputData_scattered, &modular_interface, &exchanger);
+    kernel_scattered.build();
+    KernelFilter kernel_stored(&authority, &inputData_stored, &modular_interface, &exchanger);
+    kernel_stored.build();
+
+    // fill field consistently on shared nodes
+    std::vector<double> field(num_points);
+    uniform_rand_double(0., 1., field);
+    example::Interface_ParallelVector parallel_field(field);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_field), &parallel_field);
+    parallel_field.get_values(field);
+
+    // first gradient builds the stored transposes, second reuses them
+    for(size_t pass = 0u; pass < 2u; pass++)
+    {
+        example::Interface_ParallelVector gradient_scattered(field);
+        example::Interface_ParallelVector gradient_stored(field);
+        kernel_scattered.apply(NULL, &gradient_scattered);
+        kernel_stored.apply(NULL, &gradient_stored);
+        for(size_t point = 0; point < num_points; point++)
+        {
+            EXPECT_NEAR(gradient_scattered.get_value(point), gradient_stored.get_value(point), 1e-12);
+        }
+    }
+}
+
+PSL_TEST(KernelFilter,symmetricStorageToAssembled)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    // structured hex mesh, split across processors
+    example::ElementBlock modular_block;
+    modular_block.build_from_structured_grid(7, 6, 5, 0.5, 1., 1., mpi_rank, mpi_size);
+    example::Interface_MeshModular modular_interface;
+    modular_interface.set_mesh(&modular_block);
+    const size_t num_points = modular_interface.get_num_points();
+
+    ParameterData inputData_assembled;
+    inputData_assembled.set_absolute(1.6);
+    inputData_assembled.set_iterations(2);
+    inputData_assembled.set_penalty(3.);
+    inputData_assembled.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_assembled.set_normalization(normalization_t::classical_row_normalization);
+    inputData_assembled.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_assembled.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_assembled.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_assembled.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_assembled.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_assembled.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_assembled.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    ParameterData inputData_symmetric = inputData_assembled;
+    inputData_symmetric.set_kernel_filter_symmetric_storage(true);
+    ParameterData inputData_compact = inputData_symmetric;
+    inputData_compact.set_kernel_filter_compact_storage(true);
+
+    example::Interface_ParallelExchanger_global exchanger(&authority);
+    std::vector<size_t> global_ids;
+    modular_block.get_global_ids(global_ids);
+    exchanger.put_globals(global_ids);
+    exchanger.build();
+
+    KernelFilter kernel_assembled(&authority, &inputData_assembled, &modular_interface, &exchanger);
+    kernel_assembled.build();
+    EXPECT_EQ(kernel_assembled.is_built_symmetric(), false);
+    KernelFilter kernel_symmetric(&authority, &inputData_symmetric, &modular_interface, &exchanger);
+    kernel_symmetric.build();
+    EXPECT_EQ(kernel_symmetric.is_built_symmetric(), true);
+    KernelFilter kernel_compact(&authority, &inputData_compact, &modular_interface, &exchanger);
+    kernel_compact.build();
+    EXPECT_EQ(kernel_compact.is_built_symmetric(), true);
+
+    // fill field consistently on shared nodes
+    std::vector<double> field(num_points);
+    uniform_rand_double(0., 1., field);
+    example::Interface_ParallelVector parallel_field(field);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_field), &parallel_field);
+    parallel_field.get_values(field);
+
+    // scaling rows before or after the weights only changes rounding
+    example::Interface_ParallelVector field_assembled(field);
+    example::Interface_ParallelVector field_symmetric(field);
+    example::Interface_ParallelVector field_compact(field);
+    kernel_assembled.apply(&field_assembled);
+    kernel_symmetric.apply(&field_symmetric);
+    kernel_compact.apply(&field_compact);
+    example::Interface_ParallelVector gradient_assembled(field);
+    example::Interface_ParallelVector gradient_symmetric(field);
+    example::Interface_ParallelVector gradient_compact(field);
+    kernel_assembled.apply(NULL, &gradient_assembled);
+    kernel_symmetric.apply(NULL, &gradient_symmetric);
+    kernel_compact.apply(NULL, &gradient_compact);
+    for(size_t point = 0; point < num_points; point++)
+    {
+        EXPECT_NEAR(field_assembled.get_value(point), field_symmetric.get_value(point), 1e-12);
+        EXPECT_NEAR(field_assembled.get_value(point), field_compact.get_value(point), 1e-12);
+        EXPECT_NEAR(gradient_assembled.get_value(point), gradient_symmetric.get_value(point), 1e-12);
+        EXPECT_NEAR(gradient_assembled.get_value(point), gradient_compact.get_value(point), 1e-12);
+    }
+}
+
+PSL_TEST(KernelFilter,incrementalUpdateToRebuilt)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    ParameterData input_data;
+    input_data.set_absolute(2.5);
+    input_data.set_iterations(2);
+    input_data.set_penalty(2.);
+    input_data.set_node_resolution_tolerance(1e-6);
+    input_data.set_spatial_searcher(spatial_searcher_t::recommended);
+    input_data.set_normalization(normalization_t::classical_row_normalization);
+    input_data.set_reproduction(reproduction_level_t::reproduce_constant);
+    input_data.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    input_data.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    input_data.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    input_data.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    input_data.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    input_data.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    // brick of points, a slab per processor
+    const size_t num_horiz_points = 6u;
+    const size_t num_vert_points = 5u;
+    const size_t num_local_points = num_horiz_points * num_vert_points;
+    example::Interface_PointCloud local_points;
+    build_brick_of_points(&local_points, num_vert_points, num_horiz_points, 1., 1., mpi_rank * num_horiz_points * 1., 0., 0.);
+
+    example::Interface_ParallelExchanger_localAndNonlocal exchanger(&authority);
+    std::vector<std::vector<std::pair<size_t, size_t> > > shared_node_data(mpi_size);
+    exchanger.put_shared_pairs(shared_node_data);
+    exchanger.put_num_local_locations(num_local_points);
+    exchanger.build();
+
+    KernelFilter kernel_updated(&authority, &input_data, &local_points, &exchanger);
+    kernel_updated.enable_incremental_update();
+    kernel_updated.build();
+
+    std::vector<double> field(num_local_points);
+    uniform_rand_double(0., 1., field);
+    auto expect_matches_rebuilt = [&]()
+    {
+        ParameterData input_rebuilt = input_data;
+        KernelFilter kernel_rebuilt(&authority, &input_rebuilt, &local_points, &exchanger);
+        kernel_rebuilt.build();
+
+        example::Interface_ParallelVector field_updated(field);
+        example::Interface_ParallelVector field_rebuilt(field);
+        kernel_updated.apply(&field_updated);
+        kernel_rebuilt.apply(&field_rebuilt);
+        example::Interface_ParallelVector gradient_updated(field);
+        example::Interface_ParallelVector gradient_rebuilt(field);
+        kernel_updated.apply(NULL, &gradient_updated);
+        kernel_rebuilt.apply(NULL, &gradient_rebuilt);
+        for(size_t point = 0; point < num_local_points; point++)
+        {
+            EXPECT_NEAR(field_updated.get_value(point), field_rebuilt.get_value(point), 1e-12);
+            EXPECT_NEAR(gradient_updated.get_value(point), gradient_rebuilt.get_value(point), 1e-12);
+        }
+    };
+
+    // shrinking radius filters the existing pattern
+    input_data.set_absolute(1.7);
+    kernel_updated.update();
+    EXPECT_EQ(kernel_updated.is_updated_incrementally(), true);
+    expect_matches_rebuilt();
+
+    // changing only the weights keeps the pattern
+    input_data.set_penalty(3.);
+    kernel_updated.update();
+    EXPECT_EQ(kernel_updated.is_updated_incrementally(), true);
+    expect_matches_rebuilt();
+
+    // small displacements with a smaller radius stay within the pattern
+    for(size_t point = 0; point < num_local_points; point++)
+    {
+        Point current = local_points.get_point(point);
+        std::vector<double> moved_data({current(0u) + uniform_rand_double(-.04, .04),
+                                        current(1u) + uniform_rand_double(-.04, .04),
+                                        current(2u)});
+        local_points.set_point_data(point, moved_data);
+    }
+    input_data.set_absolute(1.5);
+    kernel_updated.update();
+    EXPECT_EQ(kernel_updated.is_updated_incrementally(), true);
+    expect_matches_rebuilt();
+
+    // growing radius builds again
+    input_data.set_absolute(2.2);
+    kernel_updated.update();
+    EXPECT_EQ(kernel_updated.is_updated_incrementally(), false);
+    expect_matches_rebuilt();
+}
+
+PSL_TEST(KernelFilter,batchedToSingleApplies)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    ParameterData inputData_assembled;
+    inputData_assembled.set_absolute(2.5);
+    inputData_assembled.set_iterations(2);
+    inputData_assembled.set_penalty(1.);
+    inputData_assembled.set_node_resolution_tolerance(1e-6);
+    inputData_assembled.set_spatial_searcher(spatial_searcher_t::recommended);
+    inputData_assembled.set_normalization(normalization_t::classical_row_normalization);
+    inputData_assembled.set_reproduction(reproduction_level_t::reproduce_constant);
+    inputData_assembled.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    inputData_assembled.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    inputData_assembled.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    inputData_assembled.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    inputData_assembled.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    inputData_assembled.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+
+    ParameterData inputData_matrixFree = inputData_assembled;
+    inputData_matrixFree.set_kernel_filter_matrix_free(true);
+
+    // proc's are stacked in x
+    const size_t num_horiz_points = 9u;
+    const size_t num_vert_points = 8u;
+    const size_t num_local_points = num_horiz_points * num_vert_points;
+    example::Interface_PointCloud local_points;
+    build_brick_of_points(&local_points, num_vert_points, num_horiz_points, 1., 1., mpi_rank * num_horiz_points * 1., 0., 0.);
+
+    example::Interface_ParallelExchanger_localAndNonlocal exchanger(&authority);
+    std::vector<std::vector<std::pair<size_t, size_t> > > shared_node_data(mpi_size);
+    exchanger.put_shared_pairs(shared_node_data);
+    exchanger.put_num_local_locations(num_local_points);
+    exchanger.build();
+
+    KernelFilter kernel_assembled(&authority, &inputData_assembled, &local_points, &exchanger);
+    kernel_assembled.build();
+    KernelFilter kernel_matrixFree(&authority, &inputData_matrixFree, &local_points, &exchanger);
+    kernel_matrixFree.build();
+    std::vector<KernelFilter*> kernels = {&kernel_assembled, &kernel_matrixFree};
+
+    // fill fields arbitrarily
+    const size_t num_fields = 3u;
+    std::vector<std::vector<double> > fields(num_fields, std::vector<double>(num_local_points));
+    for(size_t f = 0u; f < num_fields; f++)
+    {
+        uniform_rand_double(-1., 1., fields[f]);
+    }
+
+    for(KernelFilter* kernel : kernels)
+    {
+        for(bool is_gradient : {false, true})
+        {
+            std::vector<example::Interface_ParallelVector> single(fields.begin(), fields.end());
+            std::vector<example::Interface_ParallelVector> batched(fields.begin(), fields.end());
+            std::vector<AbstractInterface::ParallelVector*> batched_pointers(num_fields);
+            for(size_t f = 0u; f < num_fields; f++)
+            {
+                batched_pointers[f] = &batched[f];
+                if(is_gradient)
+                {
+                    kernel->apply(NULL, &single[f]);
+                }
+                else
+                {
+                    kernel->apply(&single[f]);
+                }
+            }
+            if(is_gradient)
+            {
+                kernel->apply(NULL, batched_pointers);
+            }
+            else
+            {
+                kernel->apply(batched_pointers);
+            }
+
+            for(size_t f = 0u; f < num_fields; f++)
+            {
+                for(size_t local_point = 0; local_point < num_local_points; local_point++)
+                {
+                    EXPECT_NEAR(single[f].get_value(local_point), batched[f].get_value(local_point), 1e-12);
+                }
+            }
+        }
+    }
+}
+
 PSL_TEST(KernelFilter,reproduceConstant)
 {
     set_rand_seed();
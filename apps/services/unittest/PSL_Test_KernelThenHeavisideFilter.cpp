@@ -362,5 +362,194 @@ PSL_TEST(KernelThenHeavisideFilter, gradientCheck)
     EXPECT_EQ(checker1.check_pass(), false);
 }
 
+PSL_TEST(KernelThenHeavisideFilter, fusedMatchesUnfused)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    // build mesh
+    example::ElementBlock modular_block;
+    modular_block.build_from_structured_grid(4, 5, 6, 1., 1., 1., mpi_rank, mpi_size);
+    example::Interface_MeshModular modular_interface;
+    modular_interface.set_mesh(&modular_block);
+    const size_t num_points = modular_interface.get_num_points();
+
+    // set input data
+    ParameterData input_data;
+    input_data.set_absolute(2.5);
+    input_data.set_iterations(1);
+    input_data.set_penalty(1.);
+    input_data.set_spatial_searcher(spatial_searcher_t::recommended);
+    input_data.set_normalization(normalization_t::classical_row_normalization);
+    input_data.set_reproduction(reproduction_level_t::reproduce_constant);
+    input_data.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    input_data.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    input_data.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    input_data.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    input_data.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    input_data.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+    input_data.set_min_heaviside_parameter(4.0);
+    input_data.set_heaviside_continuation_scale(2.5);
+    input_data.set_max_heaviside_parameter(50.0);
+    ParameterData fused_input_data = input_data;
+    fused_input_data.set_kernel_filter_fused_projection(true);
+
+    // build exchanger
+    example::Interface_ParallelExchanger_global exchanger(&authority);
+    std::vector<size_t> global_ids;
+    modular_block.get_global_ids(global_ids);
+    exchanger.put_globals(global_ids);
+    exchanger.build();
+
+    // build consistent control and gradient
+    std::vector<double> random_values(num_points);
+    uniform_rand_double(0., 1., random_values);
+    example::Interface_ParallelVector parallel_control(random_values);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_control), &parallel_control);
+    std::vector<double> control;
+    parallel_control.get_values(control);
+    normal_rand_double(0., 1., random_values);
+    example::Interface_ParallelVector parallel_gradient(random_values);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_gradient), &parallel_gradient);
+    std::vector<double> gradient;
+    parallel_gradient.get_values(gradient);
+
+    // build filters
+    KernelThenHeavisideFilter unfused(&authority, &input_data, &modular_interface, &exchanger);
+    unfused.build();
+    KernelThenHeavisideFilter fused(&authority, &fused_input_data, &modular_interface, &exchanger);
+    fused.build();
+    unfused.advance_continuation();
+    fused.advance_continuation();
+
+    // apply
+    example::Interface_ParallelVector unfused_field(control);
+    example::Interface_ParallelVector fused_field(control);
+    unfused.apply(&unfused_field);
+    fused.apply(&fused_field);
+    for(size_t i = 0u; i < num_points; i++)
+    {
+        EXPECT_NEAR(unfused_field.get_value(i), fused_field.get_value(i), 1e-12);
+    }
+
+    // gradient reusing the derivatives of the fused apply, then recomputing them for another base
+    for(size_t pass = 0u; pass < 2u; pass++)
+    {
+        std::vector<double> base = control;
+        if(pass == 1u)
+        {
+            for(size_t i = 0u; i < num_points; i++)
+            {
+                base[i] = 1. - base[i];
+            }
+        }
+        example::Interface_ParallelVector unfused_base(base);
+        example::Interface_ParallelVector fused_base(base);
+        example::Interface_ParallelVector unfused_gradient(gradient);
+        example::Interface_ParallelVector fused_gradient(gradient);
+        unfused.apply(&unfused_base, &unfused_gradient);
+        fused.apply(&fused_base, &fused_gradient);
+        for(size_t i = 0u; i < num_points; i++)
+        {
+            EXPECT_NEAR(unfused_gradient.get_value(i), fused_gradient.get_value(i), 1e-12);
+        }
+    }
+}
+
+PSL_TEST(KernelThenHeavisideFilter, updateForgetsFusedDerivatives)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+    const size_t mpi_rank = authority.mpi_wrapper->get_rank();
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+
+    // build mesh
+    example::ElementBlock modular_block;
+    modular_block.build_from_structured_grid(4, 5, 6, 1., 1., 1., mpi_rank, mpi_size);
+    example::Interface_MeshModular modular_interface;
+    modular_interface.set_mesh(&modular_block);
+    const size_t num_points = modular_interface.get_num_points();
+
+    // set input data
+    ParameterData input_data;
+    input_data.set_absolute(2.5);
+    input_data.set_iterations(1);
+    input_data.set_penalty(1.);
+    input_data.set_spatial_searcher(spatial_searcher_t::recommended);
+    input_data.set_normalization(normalization_t::classical_row_normalization);
+    input_data.set_reproduction(reproduction_level_t::reproduce_constant);
+    input_data.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    input_data.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    input_data.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    input_data.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    input_data.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    input_data.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+    input_data.set_min_heaviside_parameter(4.0);
+    input_data.set_heaviside_continuation_scale(2.5);
+    input_data.set_max_heaviside_parameter(50.0);
+    input_data.set_kernel_filter_fused_projection(true);
+    input_data.set_kernel_filter_incremental_update(true);
+
+    // build exchanger
+    example::Interface_ParallelExchanger_global exchanger(&authority);
+    std::vector<size_t> global_ids;
+    modular_block.get_global_ids(global_ids);
+    exchanger.put_globals(global_ids);
+    exchanger.build();
+
+    // build consistent control and gradient
+    std::vector<double> random_values(num_points);
+    uniform_rand_double(0., 1., random_values);
+    example::Interface_ParallelVector parallel_control(random_values);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_control), &parallel_control);
+    std::vector<double> control;
+    parallel_control.get_values(control);
+    normal_rand_double(0., 1., random_values);
+    example::Interface_ParallelVector parallel_gradient(random_values);
+    exchanger.get_expansion_to_parallel_vector(exchanger.get_contraction_to_local_indexes(&parallel_gradient), &parallel_gradient);
+    std::vector<double> gradient;
+    parallel_gradient.get_values(gradient);
+
+    // fused apply keeps derivatives for this control
+    KernelThenHeavisideFilter updated(&authority, &input_data, &modular_interface, &exchanger);
+    updated.build();
+    updated.advance_continuation();
+    example::Interface_ParallelVector initial_field(control);
+    updated.apply(&initial_field);
+
+    // change the kernel, then compare against a filter built for it
+    input_data.set_absolute(1.7);
+    input_data.set_penalty(2.);
+    updated.update();
+    ParameterData rebuilt_input_data = input_data;
+    KernelThenHeavisideFilter rebuilt(&authority, &rebuilt_input_data, &modular_interface, &exchanger);
+    rebuilt.build();
+    rebuilt.advance_continuation();
+
+    // gradient of the same control must not reuse derivatives of the old kernel
+    example::Interface_ParallelVector updated_base(control);
+    example::Interface_ParallelVector rebuilt_base(control);
+    example::Interface_ParallelVector updated_gradient(gradient);
+    example::Interface_ParallelVector rebuilt_gradient(gradient);
+    updated.apply(&updated_base, &updated_gradient);
+    rebuilt.apply(&rebuilt_base, &rebuilt_gradient);
+    for(size_t i = 0u; i < num_points; i++)
+    {
+        EXPECT_NEAR(updated_gradient.get_value(i), rebuilt_gradient.get_value(i), 1e-12);
+    }
+
+    // and applies match
+    example::Interface_ParallelVector updated_field(control);
+    example::Interface_ParallelVector rebuilt_field(control);
+    updated.apply(&updated_field);
+    rebuilt.apply(&rebuilt_field);
+    for(size_t i = 0u; i < num_points; i++)
+    {
+        EXPECT_NEAR(updated_field.get_value(i), rebuilt_field.get_value(i), 1e-12);
+    }
+}
+
 }
 }
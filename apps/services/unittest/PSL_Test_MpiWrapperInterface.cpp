@@ -112,6 +112,42 @@ PSL_TEST(MpiWrapperInterface,send_and_recv_int)
     EXPECT_GT(final_time, initial_time);
 }
 
+PSL_TEST(MpiWrapperInterface,isend_and_ireceive_double)
+{
+    set_rand_seed();
+    MpiWrapperInterfaceTest_AllocateUtilities
+
+    const size_t rank = mpi_wrapper->get_rank();
+    const size_t size = mpi_wrapper->get_size();
+
+    // send both up and down, no ordering by rank required
+    const size_t up_rank = (int(rank) + 1) % size;
+    const size_t down_rank = (int(size + rank) - 1) % size;
+
+    const double some_constant = 8.31;
+    const size_t expected_data_size = 2u;
+
+    std::vector<double> send_up_data = {some_constant, double(rank)};
+    std::vector<double> send_down_data = {-some_constant, double(rank)};
+    std::vector<double> receive_from_down_data(expected_data_size);
+    std::vector<double> receive_from_up_data(expected_data_size);
+
+    mpi_wrapper->ireceive(down_rank, receive_from_down_data);
+    mpi_wrapper->ireceive(up_rank, receive_from_up_data);
+    mpi_wrapper->isend(up_rank, send_up_data);
+    mpi_wrapper->isend(down_rank, send_down_data);
+    mpi_wrapper->wait_all();
+
+    // check
+    if(size > 2u)
+    {
+        EXPECT_DOUBLE_EQ(receive_from_down_data[0], some_constant);
+        EXPECT_DOUBLE_EQ(receive_from_up_data[0], -some_constant);
+    }
+    EXPECT_DOUBLE_EQ(receive_from_down_data[1], double(down_rank));
+    EXPECT_DOUBLE_EQ(receive_from_up_data[1], double(up_rank));
+}
+
 PSL_TEST(MpiWrapperInterface,send_and_recv_float)
 {
     set_rand_seed();
@@ -674,5 +674,48 @@ PSL_TEST(OrthogonalGridUtilities, computeGridPointUVWCoordinates)
     EXPECT_DOUBLE_EQ(tUVWCoords(2),3.0);
 }
 
+PSL_TEST(OrthogonalGridUtilities, getSubGrid)
+{
+    Vector tUBasisVector({1,1,0});
+    tUBasisVector.normalize();
+    Vector tVBasisVector({-1,1,0});
+    tVBasisVector.normalize();
+    Vector tWBasisVector({0,0,1});
+
+    Vector tMinUVWCoords({0.0,0.0,0.0});
+    Vector tMaxUVWCoords({1.0,2.0,3.0});
+
+    std::vector<size_t> tNumElements = {4,5,6};
+    OrthogonalGridUtilities tUtilities(tUBasisVector,tVBasisVector,tWBasisVector,tMaxUVWCoords,tMinUVWCoords,tNumElements);
+
+    // out of range or fewer than two points in a direction
+    EXPECT_THROW(tUtilities.getSubGrid({0,0,0},{6,6,7}),std::out_of_range);
+    EXPECT_THROW(tUtilities.getSubGrid({2,0,0},{3,6,7}),std::out_of_range);
+    EXPECT_THROW(tUtilities.getSubGrid({0,0},{5,6,7}),std::domain_error);
+
+    std::vector<size_t> tBegin = {1,2,0};
+    std::vector<size_t> tEnd = {4,6,7};
+    OrthogonalGridUtilities tSubGrid = tUtilities.getSubGrid(tBegin,tEnd);
+
+    std::vector<size_t> tSubGridDimensions = tSubGrid.getGridDimensions();
+    EXPECT_EQ(tSubGridDimensions[0],3u);
+    EXPECT_EQ(tSubGridDimensions[1],4u);
+    EXPECT_EQ(tSubGridDimensions[2],7u);
+
+    for(size_t i = 0; i < tSubGridDimensions[0]; ++i)
+    {
+        for(size_t j = 0; j < tSubGridDimensions[1]; ++j)
+        {
+            for(size_t k = 0; k < tSubGridDimensions[2]; ++k)
+            {
+                Vector tSubGridPoint = tSubGrid.computeGridPointXYZCoordinates(i,j,k);
+                Vector tGridPoint = tUtilities.computeGridPointXYZCoordinates(i+tBegin[0],j+tBegin[1],k+tBegin[2]);
+                for(size_t tDim = 0; tDim < 3; ++tDim)
+                    EXPECT_NEAR(tSubGridPoint(tDim),tGridPoint(tDim),1e-14);
+            }
+        }
+    }
+}
+
 }
 }
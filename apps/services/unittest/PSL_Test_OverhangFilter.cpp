@@ -73,10 +73,14 @@
 #include "PSL_Random.hpp"
 #include "PSL_AbstractAuthority.hpp"
 #include "PSL_OverhangFilter.hpp"
+#include "PSL_KernelFilterCache.hpp"
 #include "PSL_GradientCheck.hpp"
 
 #include <mpi.h>
 #include <string>
+#include <vector>
+#include <cstdio>
+#include <fstream>
 #include <cstddef>
 #include <sstream>
 #include <math.h>
@@ -476,6 +480,111 @@ protected:
 
 };
 
+PSL_TEST(OverhangFilter,cacheKernelsApart)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+
+    const size_t mpi_size = authority.mpi_wrapper->get_size();
+    if(mpi_size > 1u)
+    {
+        return;
+    }
+
+    // build mesh
+    example::ElementBlock modular_block;
+    const size_t rank = authority.mpi_wrapper->get_rank();
+    modular_block.build_from_structured_grid(5, 5, 5, 1., 1., 1., rank, mpi_size);
+    example::Interface_MeshModular modular_interface;
+    modular_interface.set_mesh(&modular_block);
+    const size_t num_points = modular_interface.get_num_points();
+
+    // set input data
+    ParameterData input_data;
+    input_data.set_scale(1.8);
+    input_data.set_iterations(1);
+    input_data.set_penalty(1.);
+    input_data.set_spatial_searcher(spatial_searcher_t::recommended);
+    input_data.set_normalization(normalization_t::classical_row_normalization);
+    input_data.set_reproduction(reproduction_level_t::reproduce_constant);
+    input_data.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+    input_data.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+    input_data.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+    input_data.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+    input_data.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+    input_data.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+    input_data.set_min_heaviside_parameter(5.0);
+    input_data.set_heaviside_continuation_scale(2.0);
+    input_data.set_max_heaviside_parameter(50.0);
+    input_data.set_max_overhang_angle(46.);
+    input_data.set_overhang_projection_angle_fraction(.5);
+    input_data.set_overhang_projection_radius_fraction(.5);
+    input_data.set_build_direction_x(0.);
+    input_data.set_build_direction_y(0.);
+    input_data.set_build_direction_z(1.);
+
+    // build exchanger
+    example::Interface_ParallelExchanger_localAndNonlocal parallel_exchanger(&authority);
+    std::vector<std::vector<std::pair<size_t, size_t> > > shared_node_data;
+    modular_block.get_shared_node_data(shared_node_data);
+    parallel_exchanger.put_shared_pairs(shared_node_data);
+    parallel_exchanger.put_num_local_locations(num_points);
+    parallel_exchanger.build();
+
+    std::vector<double> control_data(num_points);
+    uniform_rand_double(0.0, 1.0, control_data);
+
+    // start without caches
+    const std::string filename = "PSL_Test_OverhangFilter_cacheKernelsApart.bin";
+    KernelFilterCache smoothing_cache(&authority, filename, "smoothing");
+    KernelFilterCache overhang_cache(&authority, filename, "overhang");
+    std::remove(smoothing_cache.get_filename().c_str());
+    std::remove(overhang_cache.get_filename().c_str());
+
+    // filter without then with caches, each kernel saved to its own file
+    const std::vector<double> angles = {30., 75.};
+    std::vector<double> last_uncached_data;
+    for(size_t angle_index = 0u; angle_index < angles.size(); angle_index++)
+    {
+        ParameterData uncached_data = input_data;
+        uncached_data.set_max_overhang_angle(angles[angle_index]);
+        ParameterData cached_data = uncached_data;
+        cached_data.set_kernel_filter_cache_filename(filename);
+
+        OverhangFilter uncached_filter(&authority, &uncached_data, &modular_interface, &parallel_exchanger);
+        uncached_filter.build();
+        example::Interface_ParallelVector uncached_control(control_data);
+        uncached_filter.apply(&uncached_control);
+
+        OverhangFilter cached_filter(&authority, &cached_data, &modular_interface, &parallel_exchanger);
+        cached_filter.build();
+        example::Interface_ParallelVector cached_control(control_data);
+        cached_filter.apply(&cached_control);
+
+        // a changed angle must not load the overhang kernel of the last angle
+        for(size_t i = 0u; i < num_points; i++)
+        {
+            EXPECT_NEAR(uncached_control.get_value(i), cached_control.get_value(i), 1e-12);
+        }
+        if(!last_uncached_data.empty())
+        {
+            double angle_difference = 0.;
+            for(size_t i = 0u; i < num_points; i++)
+            {
+                angle_difference += fabs(uncached_control.get_value(i) - last_uncached_data[i]);
+            }
+            EXPECT_GT(angle_difference, 1e-6);
+        }
+        last_uncached_data = uncached_control.m_data;
+        EXPECT_NE(smoothing_cache.get_filename(), overhang_cache.get_filename());
+        EXPECT_TRUE(std::ifstream(smoothing_cache.get_filename().c_str()).good());
+        EXPECT_TRUE(std::ifstream(overhang_cache.get_filename().c_str()).good());
+    }
+
+    std::remove(smoothing_cache.get_filename().c_str());
+    std::remove(overhang_cache.get_filename().c_str());
+}
+
 PSL_TEST(OverhangFilter, gradientCheck)
 {
     set_rand_seed();
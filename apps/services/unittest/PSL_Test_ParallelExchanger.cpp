@@ -88,6 +88,64 @@ void test_globalbased_exchanger(AbstractInterface::MpiWrapper* mpi_wrapper,
                                 AbstractInterface::ParallelExchanger* parallel_exchanger);
 }
 
+// stores values in reverse, so has no contiguous storage to expose
+class ReversedParallelVector : public AbstractInterface::ParallelVector
+{
+public:
+    ReversedParallelVector(const std::vector<double>& data) :
+            m_reversed(data.rbegin(), data.rend())
+    {
+    }
+    size_t get_length() override
+    {
+        return m_reversed.size();
+    }
+    double get_value(size_t index) override
+    {
+        return m_reversed[m_reversed.size() - 1u - index];
+    }
+    void set_value(size_t index, double value) override
+    {
+        m_reversed[m_reversed.size() - 1u - index] = value;
+    }
+
+    std::vector<double> m_reversed;
+};
+
+PSL_TEST(ParallelExchangerInterface,parallel_vector_view)
+{
+    const std::vector<double> data = {1., 2., 3., 4.};
+
+    // contiguous storage is viewed in place
+    example::Interface_ParallelVector contiguous(data);
+    {
+        AbstractInterface::ParallelVectorView view(&contiguous);
+        ASSERT_EQ(view.size(), data.size());
+        EXPECT_EQ(view.data(), contiguous.m_data.data());
+        view[2] = -3.;
+    }
+    EXPECT_FLOAT_EQ(contiguous.get_value(2), -3.);
+
+    // otherwise values are copied in and written back
+    ReversedParallelVector reversed(data);
+    EXPECT_EQ(reversed.get_data(), (double*)NULL);
+    {
+        AbstractInterface::ParallelVectorView view(&reversed);
+        ASSERT_EQ(view.size(), data.size());
+        for(size_t i = 0u; i < data.size(); i++)
+        {
+            EXPECT_FLOAT_EQ(view[i], data[i]);
+        }
+        view[0] = -1.;
+    }
+    EXPECT_FLOAT_EQ(reversed.get_value(0), -1.);
+    {
+        AbstractInterface::ParallelVectorView view(&reversed, true);
+        view[1] = -2.;
+    }
+    EXPECT_FLOAT_EQ(reversed.get_value(1), 2.);
+}
+
 PSL_TEST(ParallelExchangerInterface,test_parallel_exchanger_interface)
 {
     set_rand_seed();
@@ -241,6 +299,74 @@ PSL_TEST(ParallelExchangerInterface,test_parallel_exchanger_globals)
     }
 }
 
+PSL_TEST(ParallelExchangerInterface,test_parallel_exchanger_global_contribution)
+{
+    set_rand_seed();
+    AbstractAuthority authority;
+
+    example::Interface_ParallelExchanger_global parallel_exchanger_global(&authority);
+
+    // get mesh
+    const int xlen = 4;
+    const int ylen = 3;
+    const int zlen = 5;
+    const double xdist = 3.0;
+    const double ydist = 8.0;
+    const double zdist = 15.0;
+    example::ElementBlock modular_block;
+    const int rank = authority.mpi_wrapper->get_rank();
+    const int num_processors = authority.mpi_wrapper->get_size();
+    modular_block.build_from_structured_grid(xlen, ylen, zlen, xdist, ydist, zdist, rank, num_processors);
+    const size_t local_num_nodes = modular_block.get_num_nodes();
+
+    std::vector<size_t> global_ids;
+    modular_block.get_global_ids(global_ids);
+    parallel_exchanger_global.put_globals(global_ids);
+    parallel_exchanger_global.build();
+
+    // contributing ones counts the processors holding each location
+    example::Interface_ParallelVector holder_counts;
+    holder_counts.m_data.assign(local_num_nodes, 1.);
+    parallel_exchanger_global.begin_contribution_to_owners(&holder_counts);
+    parallel_exchanger_global.end_contribution_to_owners(&holder_counts);
+
+    // every location is counted once at its owner
+    std::vector<double> contracted_counts = parallel_exchanger_global.get_contraction_to_local_indexes(&holder_counts);
+    double local_count_sum = 0.;
+    for(size_t c = 0u; c < contracted_counts.size(); c++)
+    {
+        local_count_sum += contracted_counts[c];
+    }
+    double global_count_sum = 0.;
+    authority.mpi_wrapper->all_reduce_sum(local_count_sum, global_count_sum);
+    double global_num_nodes = 0.;
+    double local_num_nodes_double = local_num_nodes;
+    authority.mpi_wrapper->all_reduce_sum(local_num_nodes_double, global_num_nodes);
+    EXPECT_FLOAT_EQ(global_count_sum, global_num_nodes);
+
+    // contributing global ids gives the global id times the count at owners
+    example::Interface_ParallelVector global_sums;
+    global_sums.m_data.assign(global_ids.begin(), global_ids.end());
+    parallel_exchanger_global.begin_contribution_to_owners(&global_sums);
+    parallel_exchanger_global.end_contribution_to_owners(&global_sums);
+    std::vector<double> contracted_sums = parallel_exchanger_global.get_contraction_to_local_indexes(&global_sums);
+
+    // share the ratio back to every holder
+    std::vector<double> contracted_ratios(contracted_sums.size());
+    for(size_t c = 0u; c < contracted_sums.size(); c++)
+    {
+        contracted_ratios[c] = contracted_sums[c] / contracted_counts[c];
+    }
+    example::Interface_ParallelVector ratios;
+    ratios.m_data.assign(local_num_nodes, -1.);
+    parallel_exchanger_global.begin_expansion_to_parallel_vector(contracted_ratios, &ratios);
+    parallel_exchanger_global.end_expansion_to_parallel_vector(&ratios);
+    for(size_t l = 0u; l < local_num_nodes; l++)
+    {
+        EXPECT_FLOAT_EQ(ratios.get_value(l), global_ids[l]);
+    }
+}
+
 namespace TestingParallelExchangerInterface
 {
 
@@ -408,15 +534,15 @@ void test_rigorous_shared_node_data(AbstractInterface::MpiWrapper* mpi_wrapper,
         // for each local node
         for(size_t local_index = 0u; local_index < local_num_nodes; local_index++)
         {
-            Point* local_point = local_point_cloud->get_point(local_index);
+            Point local_point = local_point_cloud->get_point(local_index);
 
             // for each nonlocal node
             for(size_t nonlocal_index = 0; nonlocal_index < nonlocal_num_nodes; nonlocal_index++)
             {
-                Point* nonlocal_point = nonlocal_point_cloud->get_point(nonlocal_index);
+                Point nonlocal_point = nonlocal_point_cloud->get_point(nonlocal_index);
 
                 // if distance less than threshold, assume same point
-                const double distance = local_point->distance(nonlocal_point);
+                const double distance = local_point.distance(&nonlocal_point);
                 if(distance < epsilon)
                 {
                     local_and_nonlocal_pairs.push_back(std::make_pair(local_index, nonlocal_index));
@@ -497,15 +623,15 @@ void test_rigorous_global_ids(AbstractInterface::MpiWrapper* mpi_wrapper,
         // for each local node
         for(size_t local_index = 0u; local_index < local_num_nodes; local_index++)
         {
-            Point* local_point = local_point_cloud->get_point(local_index);
+            Point local_point = local_point_cloud->get_point(local_index);
 
             // for each nonlocal node
             for(size_t nonlocal_index = 0; nonlocal_index < nonlocal_num_nodes; nonlocal_index++)
             {
-                Point* nonlocal_point = nonlocal_point_cloud->get_point(nonlocal_index);
+                Point nonlocal_point = nonlocal_point_cloud->get_point(nonlocal_index);
 
                 // if distance less than threshold, same point
-                const double distance = local_point->distance(nonlocal_point);
+                const double distance = local_point.distance(&nonlocal_point);
                 if(distance < epsilon)
                 {
                     // check global matching
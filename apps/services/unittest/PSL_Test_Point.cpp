@@ -44,10 +44,13 @@
 #include "PSL_UnitTestingHelper.hpp"
 
 #include "PSL_Point.hpp"
+#include "PSL_PointCloud.hpp"
+#include "PSL_AxisAlignedBoundingBox.hpp"
 #include "PSL_FreeHelpers.hpp"
 #include "PSL_Random.hpp"
 
 #include <vector>
+#include <stdexcept>
 
 namespace PlatoSubproblemLibrary
 {
@@ -72,6 +75,11 @@ PSL_TEST(Point,allocation)
     EXPECT_EQ(p.dimension(), 2u);
     EXPECT_EQ(p(0), 0.1);
     EXPECT_EQ(p(1), -0.1);
+
+    // too many dimensions
+    EXPECT_THROW(p.set(0u, {0.1, 0.2, 0.3, 0.4}), std::length_error);
+    EXPECT_THROW(Point(0u, {0.1, 0.2, 0.3, 0.4}), std::length_error);
+    EXPECT_THROW(p.set(Point::s_max_dimension, 0.5), std::out_of_range);
 }
 
 PSL_TEST(Point,charSet)
@@ -102,5 +110,77 @@ PSL_TEST(Point,charSet)
     EXPECT_EQ(p(2),xyz_floats[2]);
 }
 
+PSL_TEST(PointCloud,structureOfArrays)
+{
+    set_rand_seed();
+
+    // fill by points
+    const size_t num_points = 20u;
+    std::vector<Point> points(num_points);
+    for(size_t p = 0u; p < num_points; p++)
+    {
+        std::vector<double> data(3u);
+        uniform_rand_double(-1., 1., data);
+        points[p] = Point(2u * p + 1u, data);
+    }
+    PointCloud cloud;
+    cloud.assign(points);
+    ASSERT_EQ(cloud.get_num_points(), num_points);
+    EXPECT_EQ(cloud.get_dimension(), 3u);
+
+    // arrays and adaptor agree with the points
+    for(size_t p = 0u; p < num_points; p++)
+    {
+        EXPECT_EQ(cloud.get_index(p), points[p].get_index());
+        EXPECT_EQ(cloud.get_indexes()[p], points[p].get_index());
+        for(size_t d = 0u; d < 3u; d++)
+        {
+            EXPECT_EQ(cloud.get_coordinate(p, d), points[p](d));
+            EXPECT_EQ(cloud.get_coordinates(d)[p], points[p](d));
+        }
+        Point copied = cloud.get_point(p);
+        EXPECT_EQ(copied.get_index(), points[p].get_index());
+        EXPECT_EQ(copied.dimension(), 3u);
+        EXPECT_EQ(copied.distance(&points[p]), 0.);
+        EXPECT_EQ(cloud.distance(p, &points[0]), points[0].distance(&points[p]));
+    }
+
+    // subset keeps order and indexes
+    std::vector<size_t> subset = {7u, 2u, 19u};
+    PointCloud sub_cloud(&cloud, subset);
+    ASSERT_EQ(sub_cloud.get_num_points(), subset.size());
+    for(size_t s = 0u; s < subset.size(); s++)
+    {
+        EXPECT_EQ(sub_cloud.get_index(s), cloud.get_index(subset[s]));
+        EXPECT_EQ(sub_cloud.get_coordinate(s, 2u), cloud.get_coordinate(subset[s], 2u));
+    }
+
+    // appending by coordinates
+    const double appended[3] = {5., -5., 0.5};
+    cloud.push_back(100u, appended);
+    ASSERT_EQ(cloud.get_num_points(), num_points + 1u);
+    EXPECT_EQ(cloud.get_index(num_points), 100u);
+    EXPECT_EQ(cloud.get_coordinate(num_points, 1u), -5.);
+
+    // bound contains every point, up to its single precision
+    AxisAlignedBoundingBox bound = cloud.get_bound();
+    EXPECT_FLOAT_EQ(bound.get_x_max(), 5.);
+    EXPECT_FLOAT_EQ(bound.get_y_min(), -5.);
+    for(size_t p = 0u; p < cloud.get_num_points(); p++)
+    {
+        EXPECT_TRUE(bound.overlap_within_tolerance(cloud.get_point(p), 1e-6));
+    }
+
+    // lower dimensional points
+    PointCloud planar_cloud;
+    planar_cloud.push_back(Point(0u, {1., 2.}));
+    planar_cloud.push_back(Point(1u, {3., 4.}));
+    EXPECT_EQ(planar_cloud.get_dimension(), 2u);
+    EXPECT_EQ(planar_cloud.get_point(1u).dimension(), 2u);
+    EXPECT_EQ(planar_cloud.get_coordinate(1u, 2u), 0.);
+    Point origin(2u, {0., 0.});
+    EXPECT_DOUBLE_EQ(planar_cloud.distance(1u, &origin), 5.);
+}
+
 }
 }
@@ -83,8 +83,9 @@ PSL_TEST(Vector,allocation)
 
     std::vector<double> tTemp2 = {0.0, 1.0, 3.0, 2.248};
     EXPECT_THROW(Vector tVec5(tTemp2),std::length_error);
-    Point p2(0, tTemp2);
-    EXPECT_THROW(Vector tVec6(p2),std::length_error);
+    EXPECT_THROW(Point p2(0, tTemp2),std::length_error);
+    Point p3(0, {0.0, 1.0});
+    EXPECT_THROW(Vector tVec6(p3),std::length_error);
 }
 
 PSL_TEST(Vector,set_and_get)
@@ -6,6 +6,7 @@ option( ANALYZE       "Flag to turn on testing of Plato Analyze performer" OFF )
 option( REGRESSION    "Flag to create regression test suite"               OFF )
 option( UNIT_TESTING  "Flag to turn on unit testing"                       OFF )
 option( ENABLE_ISO    "Flag to turn on iso extraction"                     OFF )
+option( ENABLE_PSL_BENCHMARK "Build the PlatoSubproblemLibrary benchmark"  OFF )
 option( STK_ENABLED   "Flag to indicate STK is available"                  OFF )
 option( GEOMETRY      "Flag to turn on Plato Geometry"                     OFF )
 option( EXPY          "Build exodus python API"                            OFF )
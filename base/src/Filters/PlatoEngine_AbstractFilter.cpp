@@ -53,8 +53,30 @@ AbstractFilter::~AbstractFilter()
 {
 }
 
+void AbstractFilter::apply_on_fields(size_t length, const std::vector<double*>& field_data)
+{
+    const size_t num_fields = field_data.size();
+    for(size_t field = 0u; field < num_fields; field++)
+    {
+        apply_on_field(length, field_data[field]);
+    }
+}
+
+void AbstractFilter::apply_on_gradients(size_t length, double* base_field_data, const std::vector<double*>& gradient_data)
+{
+    const size_t num_gradients = gradient_data.size();
+    for(size_t gradient = 0u; gradient < num_gradients; gradient++)
+    {
+        apply_on_gradient(length, base_field_data, gradient_data[gradient]);
+    }
+}
+
 void AbstractFilter::advance_continuation()
 {
 }
 
+void AbstractFilter::update()
+{
+}
+
 }
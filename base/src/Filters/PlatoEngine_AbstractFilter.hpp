@@ -43,6 +43,7 @@
 #pragma once
 
 #include <mpi.h>
+#include <vector>
 #include <cstddef>
 
 class DataMesh;
@@ -59,7 +60,12 @@ public:
     virtual void build(InputData aInputData, MPI_Comm& aLocalComm, DataMesh* aMesh) = 0;
     virtual void apply_on_field(size_t length, double* field_data) = 0;
     virtual void apply_on_gradient(size_t length, double* base_field_data, double* gradient_data) = 0;
+    // apply to several fields (gradients) at once, by default one at a time
+    virtual void apply_on_fields(size_t length, const std::vector<double*>& field_data);
+    virtual void apply_on_gradients(size_t length, double* base_field_data, const std::vector<double*>& gradient_data);
     virtual void advance_continuation() = 0;
+    // rebuild after the mesh coordinates or filter parameters changed, by default nothing
+    virtual void update();
 
 private:
 
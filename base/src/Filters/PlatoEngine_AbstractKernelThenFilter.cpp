@@ -178,6 +178,11 @@ void AbstractKernelThenFilter::advance_continuation()
     mAdvanceContinuationIteration++;
 }
 
+void AbstractKernelThenFilter::update()
+{
+    m_filter->update();
+}
+
 void AbstractKernelThenFilter::build_input_data(InputData aInputData)
 {
     Plato::InterfaceToEngine_ParameterDataBuilder builder(aInputData);
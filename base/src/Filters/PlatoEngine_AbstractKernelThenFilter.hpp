@@ -73,6 +73,7 @@ public:
     void apply_on_field(size_t length, double* field_data) override;
     void apply_on_gradient(size_t length, double* base_field_data, double* gradient_data) override;
     void advance_continuation() override;
+    void update() override;
 
 private:
 
@@ -194,11 +194,72 @@ void KernelFilter::apply_on_gradient(size_t length, double* /*base_field_data*/,
     std::copy(pv.m_data.begin(), pv.m_data.end(), gradient_data);
 }
 
+void KernelFilter::apply_on_fields(size_t length, const std::vector<double*>& field_data)
+{
+    apply_on_multiple(length, field_data, false);
+}
+
+void KernelFilter::apply_on_gradients(size_t length, double* /*base_field_data*/, const std::vector<double*>& gradient_data)
+{
+    apply_on_multiple(length, gradient_data, true);
+}
+
+void KernelFilter::apply_on_multiple(size_t length, const std::vector<double*>& data, bool is_gradient)
+{
+    const size_t num_vectors = data.size();
+    std::vector<PlatoSubproblemLibrary::example::Interface_ParallelVector> pvs;
+    pvs.reserve(num_vectors);
+    std::vector<PlatoSubproblemLibrary::AbstractInterface::ParallelVector*> pv_pointers(num_vectors, NULL);
+    for(size_t vector = 0u; vector < num_vectors; vector++)
+    {
+        pvs.push_back(PlatoSubproblemLibrary::example::Interface_ParallelVector(std::vector<double>(data[vector], data[vector] + length)));
+        pv_pointers[vector] = &pvs[vector];
+
+        if(m_validate_interface)
+        {
+            const double initial_parallel_error = m_parallel_exchanger->get_maximum_absolute_parallel_error(pv_pointers[vector]);
+            if(m_maximum_absolute_parallel_error_tolerance < initial_parallel_error)
+            {
+                m_authority->utilities->fatal_error("KernelFilter::apply_on_multiple high parallel error before apply. Aborting. \n\n");
+            }
+        }
+    }
+
+    // all vectors share one pass over the kernel matrices
+    if(is_gradient)
+    {
+        m_kernel->apply(NULL, pv_pointers);
+    }
+    else
+    {
+        m_kernel->apply(pv_pointers);
+    }
+
+    for(size_t vector = 0u; vector < num_vectors; vector++)
+    {
+        if(m_validate_interface)
+        {
+            const double final_parallel_error = m_parallel_exchanger->get_maximum_absolute_parallel_error(pv_pointers[vector]);
+            if(m_maximum_absolute_parallel_error_tolerance < final_parallel_error)
+            {
+                m_authority->utilities->fatal_error("KernelFilter::apply_on_multiple high parallel error after apply. Aborting. \n\n");
+            }
+        }
+
+        std::copy(pvs[vector].m_data.begin(), pvs[vector].m_data.end(), data[vector]);
+    }
+}
+
 void KernelFilter::advance_continuation()
 {
     m_kernel->advance_continuation();
 }
 
+void KernelFilter::update()
+{
+    m_kernel->update();
+}
+
 void KernelFilter::build_input_data(InputData aInputData)
 {
     Plato::InterfaceToEngine_ParameterDataBuilder builder(aInputData);
@@ -72,10 +72,15 @@ public:
     void build(InputData aInputData, MPI_Comm& aLocalComm, DataMesh* aMesh) override;
     void apply_on_field(size_t length, double* field_data) override;
     void apply_on_gradient(size_t length, double* base_field_data, double* gradient_data) override;
+    void apply_on_fields(size_t length, const std::vector<double*>& field_data) override;
+    void apply_on_gradients(size_t length, double* base_field_data, const std::vector<double*>& gradient_data) override;
     void advance_continuation() override;
+    void update() override;
 
 private:
 
+    void apply_on_multiple(size_t length, const std::vector<double*>& data, bool is_gradient);
+
     void build_input_data(InputData interface);
     void build_points(DataMesh* mesh);
     void build_parallel_exchanger(DataMesh* mesh);
@@ -44,6 +44,7 @@
 #include "PSL_Abstract_DenseVectorOperations.hpp"
 
 #include <vector>
+#include <cstddef>
 
 namespace PlatoSubproblemLibrary
 {
@@ -65,5 +66,25 @@ double DenseVectorOperations::delta_squared(const std::vector<double>& x, const
     return dot(delta, delta);
 }
 
+void DenseVectorOperations::fused_dot(const std::vector<const std::vector<double>*>& x,
+                                      const std::vector<const std::vector<double>*>& y,
+                                      std::vector<double>& result)
+{
+    const size_t num_dots = x.size();
+    result.assign(num_dots, 0.);
+    if(num_dots == 0u)
+    {
+        return;
+    }
+    const size_t num_entries = x[0]->size();
+    for(size_t index = 0u; index < num_entries; index++)
+    {
+        for(size_t d = 0u; d < num_dots; d++)
+        {
+            result[d] += (*x[d])[index] * (*y[d])[index];
+        }
+    }
+}
+
 }
 }
@@ -63,6 +63,10 @@ public:
     virtual void multiply(const std::vector<double>& x, const std::vector<double>& y, std::vector<double>& z) = 0;
     virtual void multiply(const std::vector<double>& x, std::vector<double>& y) = 0;
     virtual double delta_squared(const std::vector<double>& x, const std::vector<double>& y);
+    // result[i] = dot(*x[i], *y[i]), computed in one pass so an implementation may reduce once
+    virtual void fused_dot(const std::vector<const std::vector<double>*>& x,
+                           const std::vector<const std::vector<double>*>& y,
+                           std::vector<double>& result);
 
 protected:
 
@@ -43,7 +43,16 @@
 // PlatoSubproblemLibraryVersion(3): a stand-alone library for the kernel filter for plato.
 #include "PSL_Abstract_FixedRadiusNearestNeighborsSearcher.hpp"
 
+#include "PSL_Point.hpp"
+#include "PSL_PointCloud.hpp"
+
 #include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace PlatoSubproblemLibrary
 {
@@ -61,6 +70,58 @@ FixedRadiusNearestNeighborsSearcher::~FixedRadiusNearestNeighborsSearcher()
 
 }
 
+// default batched search, one get_neighbors per query point over contiguous blocks of queries per thread
+void FixedRadiusNearestNeighborsSearcher::get_all_neighbors(PlatoSubproblemLibrary::PointCloud* query_points,
+                                                            const size_t& max_num_neighbors,
+                                                            std::vector<size_t>& neighbor_offsets,
+                                                            std::vector<size_t>& neighbor_indexes)
+{
+    const size_t num_query_points = query_points->get_num_points();
+
+    size_t num_threads = 1u;
+#ifdef _OPENMP
+    num_threads = std::max(1, omp_get_max_threads());
+#endif
+    std::vector<std::vector<size_t> > thread_indexes(num_threads);
+    neighbor_offsets.assign(num_query_points + 1u, 0u);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_threads)
+#endif
+    {
+        size_t thread = 0u;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        const size_t block_size = (num_query_points + num_threads - 1u) / num_threads;
+        const size_t query_begin = std::min(num_query_points, thread * block_size);
+        const size_t query_end = std::min(num_query_points, query_begin + block_size);
+
+        std::vector<size_t>& indexes = thread_indexes[thread];
+        std::vector<size_t> neighbors_buffer(max_num_neighbors);
+        for(size_t query_index = query_begin; query_index < query_end; query_index++)
+        {
+            Point query_point = query_points->get_point(query_index);
+            size_t num_neighbors = 0u;
+            get_neighbors(&query_point, neighbors_buffer, num_neighbors);
+            indexes.insert(indexes.end(), neighbors_buffer.begin(), neighbors_buffer.begin() + num_neighbors);
+            neighbor_offsets[query_index + 1u] = num_neighbors;
+        }
+    }
+
+    // blocks are in query order, so counts scan to offsets and thread buffers concatenate
+    for(size_t query_index = 0u; query_index < num_query_points; query_index++)
+    {
+        neighbor_offsets[query_index + 1u] += neighbor_offsets[query_index];
+    }
+    neighbor_indexes.clear();
+    neighbor_indexes.reserve(neighbor_offsets.back());
+    for(size_t thread = 0u; thread < num_threads; thread++)
+    {
+        neighbor_indexes.insert(neighbor_indexes.end(), thread_indexes[thread].begin(), thread_indexes[thread].end());
+    }
+}
+
 }
 
 }
@@ -64,6 +64,12 @@ public:
     virtual void build(PlatoSubproblemLibrary::PointCloud* answer_points, double radius) = 0;
     // find neighbors within radius
     virtual void get_neighbors(PlatoSubproblemLibrary::Point* query_point, std::vector<size_t>& neighbors_buffer, size_t& num_neighbors) = 0;
+    // find neighbors of every query point, those of query point i are neighbor_indexes[neighbor_offsets[i]:neighbor_offsets[i+1]],
+    // max_num_neighbors bounds the neighbors of one query point, for example the number of answer points
+    virtual void get_all_neighbors(PlatoSubproblemLibrary::PointCloud* query_points,
+                                   const size_t& max_num_neighbors,
+                                   std::vector<size_t>& neighbor_offsets,
+                                   std::vector<size_t>& neighbor_indexes);
 
 protected:
 
@@ -50,6 +50,7 @@
 
 #include <vector>
 #include <cstddef>
+#include <algorithm>
 
 namespace PlatoSubproblemLibrary
 {
@@ -225,62 +226,66 @@ void MpiWrapper::send_point_cloud(size_t target_rank, PlatoSubproblemLibrary::Po
     // send number of points
     const size_t num_points = points->get_num_points();
     this->send(target_rank, (int)num_points);
+    if(num_points == 0u)
+    {
+        return;
+    }
 
-    // send points
-    for(size_t point_index = 0u; point_index < num_points; point_index++) {
-        Point* point = points->get_point(point_index);
-        std::vector<double> point_data;
-        point->get_data(point_data);
-        this->send(target_rank, (int)point->get_index());
-        this->send(target_rank, (int)point_data.size());
-        this->send(target_rank, point_data);
+    // send indexes and coordinates as whole arrays, one dimension after another
+    const size_t dimension = points->get_dimension();
+    this->send(target_rank, (int)dimension);
+    const std::vector<size_t>& point_indexes = points->get_indexes();
+    std::vector<int> indexes(point_indexes.begin(), point_indexes.end());
+    this->send(target_rank, indexes);
+    std::vector<double> coordinates(dimension * num_points);
+    for(size_t dim = 0u; dim < dimension; dim++)
+    {
+        const std::vector<double>& dimension_coordinates = points->get_coordinates(dim);
+        std::copy(dimension_coordinates.begin(), dimension_coordinates.end(), coordinates.begin() + dim * num_points);
     }
+    this->send(target_rank, coordinates);
 }
 
 PlatoSubproblemLibrary::PointCloud* MpiWrapper::receive_point_cloud(size_t source_rank)
 {
-    // receive number of points
-    int int_num_points = 0;
-    this->receive(source_rank, int_num_points);
-    const size_t num_points = int_num_points;
-
-    // allocate
     PlatoSubproblemLibrary::PointCloud* result = new PlatoSubproblemLibrary::PointCloud;
-    std::vector<Point> points(num_points);
-
-    // receive point data
-    for(size_t i = 0u; i < num_points; i++)
-    {
-        int index_of_point = 0;
-        this->receive(source_rank, index_of_point);
-        int point_dimension = 0;
-        this->receive(source_rank, point_dimension);
-        std::vector<double> point_data(point_dimension);
-        this->receive(source_rank, point_data);
-        points[i].set(index_of_point, point_data);
-    }
-
-    // fill point data
-    result->assign(points);
+    receive_to_point_cloud(source_rank, result);
     return result;
 }
 
 void MpiWrapper::receive_to_point_cloud(size_t source_rank, PlatoSubproblemLibrary::PointCloud* points)
 {
     // receive number of points
-    int num_points = 0;
-    this->receive(source_rank, num_points);
+    int int_num_points = 0;
+    this->receive(source_rank, int_num_points);
+    const size_t num_points = int_num_points;
+    if(num_points == 0u)
+    {
+        return;
+    }
 
-    // receive point data
-    for(int i = 0; i < num_points; i++)
+    // receive indexes and coordinates
+    int point_dimension = 0;
+    this->receive(source_rank, point_dimension);
+    const size_t dimension = point_dimension;
+    std::vector<int> indexes(num_points);
+    this->receive(source_rank, indexes);
+    std::vector<double> coordinates(dimension * num_points);
+    this->receive(source_rank, coordinates);
+
+    // append point data
+    const size_t num_existing_points = points->get_num_points();
+    points->resize(num_existing_points + num_points);
+    Point point;
+    double point_data[Point::s_max_dimension];
+    for(size_t i = 0u; i < num_points; i++)
     {
-        int index_of_point = 0;
-        this->receive(source_rank, index_of_point);
-        int point_dimension = 0;
-        this->receive(source_rank, point_dimension);
-        std::vector<double> point_data(point_dimension);
-        this->receive(source_rank, point_data);
-        points->push_back(Point(index_of_point, point_data));
+        for(size_t dim = 0u; dim < dimension; dim++)
+        {
+            point_data[dim] = coordinates[dim * num_points + i];
+        }
+        point.set(indexes[i], point_data, dimension);
+        points->assign(num_existing_points + i, point);
     }
 }
 
@@ -82,6 +82,18 @@ public:
     void receive(size_t source_rank, float& recv_data);
     void receive(size_t source_rank, double& recv_data);
 
+    // non-blocking; vectors must stay allocated and untouched until wait_all returns
+    virtual void isend(size_t target_rank, std::vector<int>& send_vector) = 0;
+    virtual void isend(size_t target_rank, std::vector<float>& send_vector) = 0;
+    virtual void isend(size_t target_rank, std::vector<double>& send_vector) = 0;
+    virtual void ireceive(size_t source_rank, std::vector<int>& recv_vector) = 0;
+    virtual void ireceive(size_t source_rank, std::vector<float>& recv_vector) = 0;
+    virtual void ireceive(size_t source_rank, std::vector<double>& recv_vector) = 0;
+    virtual void wait_all() = 0;
+
+    // send the value at each rank's position to that rank, receive one value from each rank
+    virtual void all_to_all(std::vector<int>& send_vector, std::vector<int>& recv_vector) = 0;
+
     virtual void all_gather(std::vector<int>& local_portion, std::vector<int>& global_portion) = 0;
     virtual void all_gather(std::vector<float>& local_portion, std::vector<float>& global_portion) = 0;
     virtual void all_gather(std::vector<double>& local_portion, std::vector<double>& global_portion) = 0;
@@ -74,10 +74,13 @@ void OverlapSearcher::build(PlatoSubproblemLibrary::PointCloud* answer_points, d
 
     // build boxes
     const size_t num_points = answer_points->get_num_points();
+    const std::vector<double>& answer_x = answer_points->get_coordinates(0u);
+    const std::vector<double>& answer_y = answer_points->get_coordinates(1u);
+    const std::vector<double>& answer_z = answer_points->get_coordinates(2u);
     std::vector<AxisAlignedBoundingBox> answer_boxes(num_points);
     for(size_t index = 0u; index < num_points; index++)
     {
-        answer_boxes[index].set(answer_points->get_point(index));
+        answer_boxes[index] = AxisAlignedBoundingBox(answer_x[index], answer_y[index], answer_z[index], answer_points->get_index(index));
     }
 
     // build searcher from boxes
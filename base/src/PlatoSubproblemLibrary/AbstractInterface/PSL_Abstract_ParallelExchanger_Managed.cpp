@@ -64,7 +64,9 @@ ParallelExchanger_Managed::ParallelExchanger_Managed(AbstractAuthority* authorit
         AbstractInterface::ParallelExchanger(authority),
         m_contracted_to_local(),
         m_local_index_to_send(),
-        m_local_index_to_recv()
+        m_local_index_to_recv(),
+        m_send_buffers(),
+        m_recv_buffers()
 {
 }
 
@@ -84,12 +86,13 @@ std::vector<size_t> ParallelExchanger_Managed::get_local_contracted_indexes()
 std::vector<double> ParallelExchanger_Managed::get_contraction_to_local_indexes(AbstractInterface::ParallelVector* input_data_vector)
 {
     // convert data vector in parallel format to vector of values for locally owned points
+    const ParallelVectorView input_values(input_data_vector, true);
     const size_t num_contracted = m_contracted_to_local.size();
     std::vector<double> contraction_result(num_contracted, 0.);
     for(size_t contracted_index = 0u; contracted_index < num_contracted; contracted_index++)
     {
         const size_t local_index = m_contracted_to_local[contracted_index];
-        contraction_result[contracted_index] = input_data_vector->get_value(local_index);
+        contraction_result[contracted_index] = input_values[local_index];
     }
 
     return contraction_result;
@@ -99,55 +102,97 @@ void ParallelExchanger_Managed::get_expansion_to_parallel_vector(const std::vect
                                                                   AbstractInterface::ParallelVector* output_data_vector)
 {
     // communicate between processors to expand the locally owned data to parallel format with some values shared on processors
+    begin_expansion_to_parallel_vector(input_data_vector, output_data_vector);
+    end_expansion_to_parallel_vector(output_data_vector);
+}
 
+void ParallelExchanger_Managed::begin_expansion_to_parallel_vector(const std::vector<double>& input_data_vector,
+                                                                    AbstractInterface::ParallelVector* output_data_vector)
+{
     // do local mapping
+    ParallelVectorView output_values(output_data_vector);
     const size_t num_contracted = m_contracted_to_local.size();
     for(size_t contracted_index = 0u; contracted_index < num_contracted; contracted_index++)
     {
         const size_t local_index = m_contracted_to_local[contracted_index];
-        output_data_vector->set_value(local_index, input_data_vector[contracted_index]);
+        output_values[local_index] = input_data_vector[contracted_index];
     }
 
-    // do communication
-    size_t size = m_authority->mpi_wrapper->get_size();
+    // owners send to every processor sharing their locations
+    post_exchange(m_local_index_to_send, m_local_index_to_recv, output_values.data());
+}
+
+void ParallelExchanger_Managed::end_expansion_to_parallel_vector(AbstractInterface::ParallelVector* output_data_vector)
+{
+    m_authority->mpi_wrapper->wait_all();
 
-    // receive from lower procs
+    ParallelVectorView output_values(output_data_vector);
+    const size_t size = m_recv_buffers.size();
     for(size_t proc_ = 0; proc_ < size; proc_++)
     {
         const size_t num_to_recv = m_local_index_to_recv[proc_].size();
-
-        if(num_to_recv > 0)
+        for(size_t recv_index = 0; recv_index < num_to_recv; recv_index++)
         {
-            std::vector<double> field_values_to_recv(num_to_recv, 0.0);
+            const size_t index_to_recv_to = m_local_index_to_recv[proc_][recv_index];
+            output_values[index_to_recv_to] = m_recv_buffers[proc_][recv_index];
+        }
+    }
+}
 
-            m_authority->mpi_wrapper->receive(proc_, field_values_to_recv);
+void ParallelExchanger_Managed::begin_contribution_to_owners(AbstractInterface::ParallelVector* data_vector)
+{
+    // the reverse of expansion, processors sharing locations send to the owners
+    const ParallelVectorView data_values(data_vector, true);
+    post_exchange(m_local_index_to_recv, m_local_index_to_send, data_values.data());
+}
 
-            for(size_t recv_index = 0; recv_index < num_to_recv; recv_index++)
-            {
-                const size_t index_to_recv_to = m_local_index_to_recv[proc_][recv_index];
-                const double field_value_recvd = field_values_to_recv[recv_index];
-                output_data_vector->set_value(index_to_recv_to, field_value_recvd);
-            }
+void ParallelExchanger_Managed::end_contribution_to_owners(AbstractInterface::ParallelVector* data_vector)
+{
+    m_authority->mpi_wrapper->wait_all();
+
+    // sum in processor order so results do not depend on arrival order
+    ParallelVectorView data_values(data_vector);
+    const size_t size = m_recv_buffers.size();
+    for(size_t proc_ = 0; proc_ < size; proc_++)
+    {
+        const size_t num_to_recv = m_local_index_to_send[proc_].size();
+        for(size_t recv_index = 0; recv_index < num_to_recv; recv_index++)
+        {
+            const size_t index_to_add_to = m_local_index_to_send[proc_][recv_index];
+            data_values[index_to_add_to] += m_recv_buffers[proc_][recv_index];
         }
     }
+}
+
+void ParallelExchanger_Managed::post_exchange(const std::vector<std::vector<size_t> >& local_index_to_send,
+                                              const std::vector<std::vector<size_t> >& local_index_to_recv,
+                                              const double* data_values)
+{
+    const size_t size = m_authority->mpi_wrapper->get_size();
+    m_send_buffers.resize(size);
+    m_recv_buffers.resize(size);
 
-    // send to upper procs
     for(size_t proc_ = 0; proc_ < size; proc_++)
     {
-        const size_t num_to_send = m_local_index_to_send[proc_].size();
+        const size_t num_to_recv = local_index_to_recv[proc_].size();
+        m_recv_buffers[proc_].resize(num_to_recv);
+        if(num_to_recv > 0)
+        {
+            m_authority->mpi_wrapper->ireceive(proc_, m_recv_buffers[proc_]);
+        }
+    }
 
+    for(size_t proc_ = 0; proc_ < size; proc_++)
+    {
+        const size_t num_to_send = local_index_to_send[proc_].size();
+        m_send_buffers[proc_].resize(num_to_send);
         if(num_to_send > 0)
         {
-            std::vector<double> field_values_to_send(num_to_send, 0.0);
-
             for(size_t send_index = 0; send_index < num_to_send; send_index++)
             {
-                const size_t index_to_send = m_local_index_to_send[proc_][send_index];
-                const double field_value_to_send = output_data_vector->get_value(index_to_send);
-                field_values_to_send[send_index] = field_value_to_send;
+                m_send_buffers[proc_][send_index] = data_values[local_index_to_send[proc_][send_index]];
             }
-
-            m_authority->mpi_wrapper->send(proc_, field_values_to_send);
+            m_authority->mpi_wrapper->isend(proc_, m_send_buffers[proc_]);
         }
     }
 }
@@ -72,7 +72,20 @@ public:
     // determine maximum absolute parallel error
     double get_maximum_absolute_parallel_error(ParallelVector* input_data_vector) override;
 
+    // non-blocking expansion; shared locations of the output are only written by the end call
+    void begin_expansion_to_parallel_vector(const std::vector<double>& input_data_vector, ParallelVector* output_data_vector);
+    void end_expansion_to_parallel_vector(ParallelVector* output_data_vector);
+    // non-blocking sum of the values at shared locations into the locally owned location of the owner;
+    // values at locations not locally owned are left unchanged
+    void begin_contribution_to_owners(ParallelVector* data_vector);
+    void end_contribution_to_owners(ParallelVector* data_vector);
+
 protected:
+    // post receives for local_index_to_recv and sends of the values at local_index_to_send, by processor
+    void post_exchange(const std::vector<std::vector<size_t> >& local_index_to_send,
+                       const std::vector<std::vector<size_t> >& local_index_to_recv,
+                       const double* data_values);
+
     // for contraction
     std::vector<size_t> m_contracted_to_local;
 
@@ -80,6 +93,10 @@ protected:
     std::vector<std::vector<size_t> > m_local_index_to_send;
     std::vector<std::vector<size_t> > m_local_index_to_recv;
 
+    // buffers of pending non-blocking communication, by processor
+    std::vector<std::vector<double> > m_send_buffers;
+    std::vector<std::vector<double> > m_recv_buffers;
+
 };
 
 }
@@ -46,6 +46,7 @@
 #include <cstddef>
 #include <vector>
 #include <cassert>
+#include <algorithm>
 
 namespace PlatoSubproblemLibrary
 {
@@ -60,10 +61,21 @@ ParallelVector::~ParallelVector()
 {
 }
 
+double* ParallelVector::get_data()
+{
+    return NULL;
+}
+
 void ParallelVector::get_values(std::vector<double>& field)
 {
     const size_t length = get_length();
     field.resize(length);
+    const double* data = get_data();
+    if(data)
+    {
+        std::copy(data, data + length, field.begin());
+        return;
+    }
     for(size_t i = 0u; i < length; i++)
     {
         field[i] = get_value(i);
@@ -73,11 +85,40 @@ void ParallelVector::set_values(const std::vector<double>& field)
 {
     const size_t length = get_length();
     assert(field.size() == length);
+    double* data = get_data();
+    if(data)
+    {
+        std::copy(field.begin(), field.end(), data);
+        return;
+    }
     for(size_t i = 0u; i < length; i++)
     {
         set_value(i, field[i]);
     }
 }
 
+ParallelVectorView::ParallelVectorView(ParallelVector* vector, bool read_only) :
+        m_vector(vector),
+        m_write_back(false),
+        m_length(vector->get_length()),
+        m_data(vector->get_data()),
+        m_copy()
+{
+    if(!m_data)
+    {
+        m_vector->get_values(m_copy);
+        m_data = m_copy.data();
+        m_write_back = !read_only;
+    }
+}
+
+ParallelVectorView::~ParallelVectorView()
+{
+    if(m_write_back)
+    {
+        m_vector->set_values(m_copy);
+    }
+}
+
 }
 }
@@ -60,11 +60,42 @@ public:
     virtual size_t get_length() = 0;
     virtual double get_value(size_t index) = 0;
     virtual void set_value(size_t index, double value) = 0;
+    // contiguous storage of all values, or NULL if values are only reachable through get_value and set_value
+    virtual double* get_data();
     void get_values(std::vector<double>& field);
     void set_values(const std::vector<double>& field);
 
 protected:
 };
 
+/* Contiguous view of the values of a ParallelVector.
+ *
+ * Points at the vector's storage when it has one. Otherwise the values are copied in on
+ * construction and, unless the view is read only, copied back on destruction.
+ */
+class ParallelVectorView
+{
+public:
+    ParallelVectorView(ParallelVector* vector, bool read_only = false);
+    ~ParallelVectorView();
+
+    size_t size() const { return m_length; }
+    double* data() { return m_data; }
+    const double* data() const { return m_data; }
+    double& operator[](size_t index) { return m_data[index]; }
+    double operator[](size_t index) const { return m_data[index]; }
+
+protected:
+    ParallelVector* m_vector;
+    bool m_write_back;
+    size_t m_length;
+    double* m_data;
+    std::vector<double> m_copy;
+
+private:
+    ParallelVectorView(const ParallelVectorView&);
+    ParallelVectorView& operator=(const ParallelVectorView&);
+};
+
 }
 }
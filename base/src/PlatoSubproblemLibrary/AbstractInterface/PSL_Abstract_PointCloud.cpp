@@ -75,7 +75,8 @@ PlatoSubproblemLibrary::PointCloud* PointCloud::build_point_cloud(std::vector<bo
     }
 
     // allocate
-    std::vector<PlatoSubproblemLibrary::Point> points(num_selected);
+    PlatoSubproblemLibrary::PointCloud* result = new PlatoSubproblemLibrary::PointCloud;
+    result->resize(num_selected);
 
     // fill
     size_t selected_counter = 0u;
@@ -83,14 +84,10 @@ PlatoSubproblemLibrary::PointCloud* PointCloud::build_point_cloud(std::vector<bo
     {
         if(selected_nodes[node])
         {
-            points[selected_counter++] = this->get_point(node);
+            result->assign(selected_counter++, this->get_point(node));
         }
     }
 
-    // build
-    PlatoSubproblemLibrary::PointCloud* result = new PlatoSubproblemLibrary::PointCloud;
-    result->assign(points);
-
     return result;
 }
 
@@ -43,6 +43,9 @@
 // PlatoSubproblemLibraryVersion(3): a stand-alone library for the kernel filter for plato.
 #include "PSL_Abstract_PositiveDefiniteLinearSolver.hpp"
 
+#include <vector>
+#include <cstddef>
+
 namespace PlatoSubproblemLibrary
 {
 
@@ -59,6 +62,20 @@ PositiveDefiniteLinearSolver::~PositiveDefiniteLinearSolver()
 
 }
 
+bool PositiveDefiniteLinearSolver::solve_multiple(DenseMatrix* matrix,
+                                                  const std::vector<std::vector<double> >& rhs,
+                                                  std::vector<std::vector<double> >& sol)
+{
+    const size_t num_rhs = rhs.size();
+    sol.resize(num_rhs);
+    bool success = true;
+    for(size_t r = 0u; r < num_rhs; r++)
+    {
+        success = solve(matrix, rhs[r], sol[r]) && success;
+    }
+    return success;
+}
+
 }
 
 }
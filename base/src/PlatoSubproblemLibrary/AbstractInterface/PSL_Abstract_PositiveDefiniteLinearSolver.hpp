@@ -61,6 +61,10 @@ public:
 
     // true if success
     virtual bool solve(DenseMatrix* matrix, const std::vector<double>& rhs, std::vector<double>& sol) = 0;
+    // true if success for every right hand side; solves one at a time unless overridden
+    virtual bool solve_multiple(DenseMatrix* matrix,
+                                const std::vector<std::vector<double> >& rhs,
+                                std::vector<std::vector<double> >& sol);
 
 protected:
 
@@ -63,6 +63,15 @@ public:
 
     virtual void matVec(const std::vector<double>& input, std::vector<double>& output, bool transpose) = 0;
     virtual void matVecToReduced(const std::vector<double>& input, std::vector<double>& output, bool transpose) = 0;
+    // products with num_vectors vectors interleaved by row, entry (i,v) at i*num_vectors+v
+    virtual void matMultiVec(const std::vector<double>& input,
+                             std::vector<double>& output,
+                             size_t num_vectors,
+                             bool transpose) = 0;
+    virtual void matMultiVecToReduced(const std::vector<double>& input,
+                                      std::vector<double>& output,
+                                      size_t num_vectors,
+                                      bool transpose) = 0;
 
     virtual void rowNormalize(const std::vector<double>& rowNormalizationFactors) = 0;
     virtual void columnNormalize(const std::vector<double>& columnNormalizationFactors) = 0;
@@ -75,6 +84,11 @@ public:
     virtual void getRow(size_t row, std::vector<double>& data, std::vector<size_t>& columns) = 0;
     virtual void setRow(size_t row, const std::vector<double>& data) = 0;
 
+    // request transposed products be computed from an explicitly stored transpose
+    virtual void storeTranspose() = 0;
+    // request 32-bit local column indexes, and optionally single precision values; products accumulate in double
+    virtual void compactStorage(bool singlePrecision) = 0;
+
 protected:
 };
 
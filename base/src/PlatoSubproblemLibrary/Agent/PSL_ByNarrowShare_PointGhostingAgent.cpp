@@ -195,13 +195,8 @@ void ByNarrowShare_PointGhostingAgent::share_points_with_processor_send(size_t o
     std::sort(&local_point_results[0], &local_point_results[num_results]);
 
     // build local kernel points which are neighbors
-    PointCloud neighbored_local_kernel_points;
-    for(size_t results_index = 0u; results_index < num_results; results_index++)
-    {
-        const size_t point_index = local_point_results[results_index];
-        Point* local_point = local_kernel_points->get_point(point_index);
-        neighbored_local_kernel_points.push_back(*local_point);
-    }
+    std::vector<size_t> neighbored_indexes(local_point_results.begin(), local_point_results.begin() + num_results);
+    PointCloud neighbored_local_kernel_points(local_kernel_points, neighbored_indexes);
 
     // send
     m_authority->mpi_wrapper->send_point_cloud(other_proc_id, &neighbored_local_kernel_points);
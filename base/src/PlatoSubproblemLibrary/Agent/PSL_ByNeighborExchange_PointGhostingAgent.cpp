@@ -0,0 +1,270 @@
+/*
+//@HEADER
+// *************************************************************************
+//   Plato Engine v.1.0: Copyright 2018, National Technology & Engineering
+//                    Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Sandia Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact the Plato team (plato3D-help@sandia.gov)
+//
+// *************************************************************************
+//@HEADER
+*/
+
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_ByNeighborExchange_PointGhostingAgent.hpp"
+
+#include "PSL_ParameterDataEnums.hpp"
+#include "PSL_PointCloud.hpp"
+#include "PSL_Point.hpp"
+#include "PSL_Abstract_FixedRadiusNearestNeighborsSearcher.hpp"
+#include "PSL_Abstract_MpiWrapper.hpp"
+#include "PSL_AxisAlignedBoundingBox.hpp"
+#include "PSL_SpatialSearcherFactory.hpp"
+#include "PSL_Abstract_OverlapSearcher.hpp"
+#include "PSL_Abstract_GlobalUtilities.hpp"
+#include "PSL_AbstractAuthority.hpp"
+
+#include <cassert>
+#include <vector>
+#include <cstddef>
+#include <algorithm> // for sort
+
+namespace PlatoSubproblemLibrary
+{
+
+ByNeighborExchange_PointGhostingAgent::ByNeighborExchange_PointGhostingAgent(AbstractAuthority* authority) :
+        Abstract_PointGhostingAgent(point_ghosting_agent_t::by_neighbor_exchange, authority),
+        m_overlap_searcher(NULL),
+        m_support_distance(-1.)
+{
+}
+
+void ByNeighborExchange_PointGhostingAgent::share(double support_distance,
+                                                  PointCloud* local_kernel_points,
+                                                  std::vector<PointCloud*>& nonlocal_kernel_points,
+                                                  std::vector<size_t>& processor_neighbors_below,
+                                                  std::vector<size_t>& processor_neighbors_above)
+{
+    assert(local_kernel_points);
+
+    // handle input
+    m_support_distance = support_distance;
+    const size_t mpi_rank = m_authority->mpi_wrapper->get_rank();
+    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+    nonlocal_kernel_points.clear();
+    nonlocal_kernel_points.resize(mpi_size);
+
+    std::vector<AxisAlignedBoundingBox> processor_bounds;
+    std::vector<size_t> processor_neighbors;
+    determine_processor_bounds_and_neighbors(local_kernel_points, processor_bounds, processor_neighbors);
+
+    processor_neighbors_below.clear();
+    processor_neighbors_above.clear();
+    for(size_t other_proc_id : processor_neighbors)
+    {
+        if(other_proc_id < mpi_rank)
+        {
+            processor_neighbors_below.push_back(other_proc_id);
+        }
+        else
+        {
+            processor_neighbors_above.push_back(other_proc_id);
+        }
+    }
+
+    // pack local points near each neighbor
+    m_overlap_searcher = build_overlap_searcher();
+    m_overlap_searcher->build(local_kernel_points, m_support_distance);
+    const size_t num_neighbors = processor_neighbors.size();
+    std::vector<std::vector<int> > send_indexes(num_neighbors);
+    std::vector<std::vector<double> > send_coordinates(num_neighbors);
+    std::vector<std::vector<int> > send_sizes(num_neighbors, std::vector<int>(2u));
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        pack_points_for_processor(processor_bounds[processor_neighbors[neighbor]],
+                                  local_kernel_points,
+                                  send_indexes[neighbor],
+                                  send_coordinates[neighbor]);
+        send_sizes[neighbor][0] = send_indexes[neighbor].size();
+        send_sizes[neighbor][1] = local_kernel_points->get_dimension();
+    }
+    delete m_overlap_searcher;
+    m_overlap_searcher = NULL;
+
+    // exchange number of points and dimension
+    std::vector<std::vector<int> > receive_sizes(num_neighbors, std::vector<int>(2u));
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        m_authority->mpi_wrapper->ireceive(processor_neighbors[neighbor], receive_sizes[neighbor]);
+    }
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        m_authority->mpi_wrapper->isend(processor_neighbors[neighbor], send_sizes[neighbor]);
+    }
+    m_authority->mpi_wrapper->wait_all();
+
+    // exchange points
+    std::vector<std::vector<int> > receive_indexes(num_neighbors);
+    std::vector<std::vector<double> > receive_coordinates(num_neighbors);
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        const size_t num_points = receive_sizes[neighbor][0];
+        if(num_points == 0u)
+        {
+            continue;
+        }
+        receive_indexes[neighbor].resize(num_points);
+        receive_coordinates[neighbor].resize(num_points * receive_sizes[neighbor][1]);
+        m_authority->mpi_wrapper->ireceive(processor_neighbors[neighbor], receive_indexes[neighbor]);
+        m_authority->mpi_wrapper->ireceive(processor_neighbors[neighbor], receive_coordinates[neighbor]);
+    }
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        if(send_indexes[neighbor].empty())
+        {
+            continue;
+        }
+        m_authority->mpi_wrapper->isend(processor_neighbors[neighbor], send_indexes[neighbor]);
+        m_authority->mpi_wrapper->isend(processor_neighbors[neighbor], send_coordinates[neighbor]);
+    }
+    m_authority->mpi_wrapper->wait_all();
+
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        PointCloud* points = new PointCloud;
+        unpack_points(receive_indexes[neighbor], receive_coordinates[neighbor], receive_sizes[neighbor][1], points);
+        nonlocal_kernel_points[processor_neighbors[neighbor]] = points;
+    }
+}
+
+AbstractInterface::OverlapSearcher* ByNeighborExchange_PointGhostingAgent::build_overlap_searcher()
+{
+    AbstractInterface::FixedRadiusNearestNeighborsSearcher* generic_searcher =
+            build_fixed_radius_nearest_neighbors_searcher(spatial_searcher_t::recommended_overlap_searcher, m_authority);
+    AbstractInterface::OverlapSearcher* overlap_searcher = dynamic_cast<AbstractInterface::OverlapSearcher*>(generic_searcher);
+    if(!overlap_searcher)
+    {
+        m_authority->utilities->fatal_error("ByNeighborExchange_PointGhostingAgent: failed to dynamic cast pointer. Aborting.\n\n");
+    }
+    return overlap_searcher;
+}
+
+void ByNeighborExchange_PointGhostingAgent::determine_processor_bounds_and_neighbors(PointCloud* local_kernel_points,
+                                                                                     std::vector<AxisAlignedBoundingBox>& processor_bounds,
+                                                                                     std::vector<size_t>& processor_neighbors)
+{
+    const size_t mpi_rank = m_authority->mpi_wrapper->get_rank();
+    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+
+    // get all local bounds
+    AxisAlignedBoundingBox local_bound = local_kernel_points->get_bound();
+    local_bound.set_id(mpi_rank);
+    processor_bounds.clear();
+    processor_bounds.resize(mpi_size);
+    m_authority->mpi_wrapper->all_gather(local_bound, processor_bounds);
+
+    // search for candidates with a generous growth, then keep those passing the same symmetric test as
+    // ByNarrowShare so both processors of a pair agree they are neighbors despite float rounding
+    AbstractInterface::OverlapSearcher* bounds_searcher = build_overlap_searcher();
+    bounds_searcher->build(processor_bounds);
+    AxisAlignedBoundingBox grown_local_bound = local_bound;
+    grown_local_bound.grow_in_each_axial_direction(2. * m_support_distance);
+    std::vector<size_t> candidates(mpi_size);
+    size_t num_candidates = 0u;
+    bounds_searcher->get_overlaps(&grown_local_bound, candidates, num_candidates);
+    delete bounds_searcher;
+
+    processor_neighbors.clear();
+    for(size_t candidate = 0u; candidate < num_candidates; candidate++)
+    {
+        const size_t other_proc_id = candidates[candidate];
+        if(other_proc_id != mpi_rank && local_bound.overlap_within_tolerance(processor_bounds[other_proc_id], m_support_distance))
+        {
+            processor_neighbors.push_back(other_proc_id);
+        }
+    }
+    std::sort(processor_neighbors.begin(), processor_neighbors.end());
+}
+
+void ByNeighborExchange_PointGhostingAgent::pack_points_for_processor(const AxisAlignedBoundingBox& other_proc_bound,
+                                                                      PointCloud* local_kernel_points,
+                                                                      std::vector<int>& indexes,
+                                                                      std::vector<double>& coordinates)
+{
+    // grow other processor by filter radius
+    AxisAlignedBoundingBox grown_other_proc_bound = other_proc_bound;
+    grown_other_proc_bound.grow_in_each_axial_direction(m_support_distance);
+
+    // get local overlaps
+    const size_t num_local_points = local_kernel_points->get_num_points();
+    std::vector<size_t> local_point_results(num_local_points);
+    size_t num_results = 0u;
+    m_overlap_searcher->get_overlaps(&grown_other_proc_bound, local_point_results, num_results);
+    std::sort(local_point_results.begin(), local_point_results.begin() + num_results);
+
+    // indexes, then coordinates by dimension
+    const size_t dimension = local_kernel_points->get_dimension();
+    indexes.resize(num_results);
+    coordinates.resize(dimension * num_results);
+    for(size_t result = 0u; result < num_results; result++)
+    {
+        const size_t local_point = local_point_results[result];
+        indexes[result] = local_kernel_points->get_index(local_point);
+        for(size_t dim = 0u; dim < dimension; dim++)
+        {
+            coordinates[dim * num_results + result] = local_kernel_points->get_coordinate(local_point, dim);
+        }
+    }
+}
+
+void ByNeighborExchange_PointGhostingAgent::unpack_points(const std::vector<int>& indexes,
+                                                          const std::vector<double>& coordinates,
+                                                          size_t dimension,
+                                                          PointCloud* points)
+{
+    const size_t num_points = indexes.size();
+    points->resize(num_points);
+    Point point;
+    double point_data[Point::s_max_dimension];
+    for(size_t i = 0u; i < num_points; i++)
+    {
+        for(size_t dim = 0u; dim < dimension; dim++)
+        {
+            point_data[dim] = coordinates[dim * num_points + i];
+        }
+        point.set(indexes[i], point_data, dimension);
+        points->assign(i, point);
+    }
+}
+
+}
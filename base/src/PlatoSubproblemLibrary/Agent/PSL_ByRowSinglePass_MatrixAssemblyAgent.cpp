@@ -0,0 +1,233 @@
+/*
+//@HEADER
+// *************************************************************************
+//   Plato Engine v.1.0: Copyright 2018, National Technology & Engineering
+//                    Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Sandia Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact the Plato team (plato3D-help@sandia.gov)
+//
+// *************************************************************************
+//@HEADER
+*/
+
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_ByRowSinglePass_MatrixAssemblyAgent.hpp"
+
+#include "PSL_ByRow_MatrixAssemblyAgent.hpp"
+#include "PSL_ParameterDataEnums.hpp"
+#include "PSL_Abstract_SparseMatrix.hpp"
+#include "PSL_PointCloud.hpp"
+#include "PSL_Abstract_SparseMatrixBuilder.hpp"
+#include "PSL_Point.hpp"
+#include "PSL_Abstract_FixedRadiusNearestNeighborsSearcher.hpp"
+#include "PSL_Abstract_BoundedSupportFunction.hpp"
+#include "PSL_AbstractAuthority.hpp"
+
+#include <cassert>
+#include <vector>
+#include <cstddef>
+#include <algorithm> // for sort, min
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace PlatoSubproblemLibrary
+{
+
+ByRowSinglePass_MatrixAssemblyAgent::ByRowSinglePass_MatrixAssemblyAgent(AbstractAuthority* authority,
+                                                                         ParameterData* input_data) :
+        ByRow_MatrixAssemblyAgent(matrix_assembly_agent_t::by_row_single_pass, authority, input_data),
+        m_thread_rows(),
+        m_thread_columns(),
+        m_thread_values()
+{
+}
+
+void ByRowSinglePass_MatrixAssemblyAgent::build_local(Abstract_BoundedSupportFunction* bounded_support_function,
+                                                      PointCloud* kernel_points,
+                                                      AbstractInterface::SparseMatrix** local_kernel_matrix)
+{
+    // build searcher
+    m_searcher->build(kernel_points, m_support_distance);
+
+    // search and evaluate once
+    gather_nonzeros(bounded_support_function, kernel_points, kernel_points, true);
+
+    // build local sparse matrix
+    const size_t num_points = kernel_points->get_num_points();
+    m_authority->sparse_builder->begin_build(num_points, num_points);
+    specify_gathered_nonzeros();
+    *local_kernel_matrix = m_authority->sparse_builder->end_build();
+}
+
+void ByRowSinglePass_MatrixAssemblyAgent::compute_nonlocal_matrix_for_above_processor(Abstract_BoundedSupportFunction* bounded_support_function,
+                                                                                      const std::vector<size_t>& processor_neighbors_above,
+                                                                                      std::vector<PointCloud*>& nonlocal_kernel_points,
+                                                                                      PointCloud* local_kernel_points,
+                                                                                      std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+                                                                                      const std::vector<int>& num_points_per_processor)
+{
+    // compute matrix from higher processors that neighbor
+    const size_t num_neighbors_above = processor_neighbors_above.size();
+    for(size_t neighbor_proc_index = 0u; neighbor_proc_index < num_neighbors_above; neighbor_proc_index++)
+    {
+        const size_t upper_proc_id = processor_neighbors_above[neighbor_proc_index];
+
+        // for row block matrix: rows are local and columns are nonlocal
+        const size_t num_rows = local_kernel_points->get_num_points();
+        const size_t num_columns = num_points_per_processor[upper_proc_id];
+
+        // search and evaluate once, nonlocal points query the local searcher
+        gather_nonzeros(bounded_support_function, nonlocal_kernel_points[upper_proc_id], local_kernel_points, false);
+
+        // build sparse matrix
+        m_authority->sparse_builder->begin_build(num_rows, num_columns);
+        specify_gathered_nonzeros();
+        parallel_block_row_kernel_matrices[upper_proc_id] = m_authority->sparse_builder->end_build();
+
+        // if empty, delete
+        if(parallel_block_row_kernel_matrices[upper_proc_id]->getNumNonZeroSortedRows() == 0u)
+        {
+            delete parallel_block_row_kernel_matrices[upper_proc_id];
+            parallel_block_row_kernel_matrices[upper_proc_id] = NULL;
+        }
+    }
+}
+
+void ByRowSinglePass_MatrixAssemblyAgent::gather_nonzeros(Abstract_BoundedSupportFunction* bounded_support_function,
+                                                          PointCloud* query_points,
+                                                          PointCloud* answer_points,
+                                                          bool is_query_row)
+{
+    const size_t num_query_points = query_points->get_num_points();
+    const size_t num_answer_points = answer_points->get_num_points();
+
+    size_t num_threads = 1u;
+#ifdef _OPENMP
+    num_threads = std::max(1, omp_get_max_threads());
+#endif
+    m_thread_rows.assign(num_threads, std::vector<size_t>());
+    m_thread_columns.assign(num_threads, std::vector<size_t>());
+    m_thread_values.assign(num_threads, std::vector<double>());
+
+    // determine which points are within the radius of each query point, in one batched search
+    std::vector<size_t> neighbor_offsets;
+    std::vector<size_t> neighbor_indexes;
+    m_searcher->get_all_neighbors(query_points, num_answer_points, neighbor_offsets, neighbor_indexes);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_threads)
+#endif
+    {
+        size_t thread = 0u;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        // contiguous blocks of query points, so buffers concatenate in query order
+        const size_t block_size = (num_query_points + num_threads - 1u) / num_threads;
+        const size_t query_begin = std::min(num_query_points, thread * block_size);
+        const size_t query_end = std::min(num_query_points, query_begin + block_size);
+
+        std::vector<size_t>& rows = m_thread_rows[thread];
+        std::vector<size_t>& columns = m_thread_columns[thread];
+        std::vector<double>& values = m_thread_values[thread];
+
+        for(size_t query_index = query_begin; query_index < query_end; query_index++)
+        {
+            Point query_point = query_points->get_point(query_index);
+            size_t* neighbors_begin = neighbor_indexes.data() + neighbor_offsets[query_index];
+            size_t* neighbors_end = neighbor_indexes.data() + neighbor_offsets[query_index + 1u];
+
+            // this sort is not necessary but promotes more sequential access
+            std::sort(neighbors_begin, neighbors_end);
+
+            // for each neighbor found, calculate the distance weight
+            for(const size_t* neighbor = neighbors_begin; neighbor != neighbors_end; neighbor++)
+            {
+                const size_t answer_index = *neighbor;
+                Point answer_point = answer_points->get_point(answer_index);
+
+                // if weight positive, store
+                if(is_query_row)
+                {
+                    const double weight = bounded_support_function->evaluate(&query_point, &answer_point);
+                    if(weight > 0)
+                    {
+                        rows.push_back(query_index);
+                        columns.push_back(answer_index);
+                        values.push_back(weight);
+                    }
+                }
+                else
+                {
+                    const double weight = bounded_support_function->evaluate(&answer_point, &query_point);
+                    if(weight > 0)
+                    {
+                        rows.push_back(answer_point.get_index());
+                        columns.push_back(query_point.get_index());
+                        values.push_back(weight);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ByRowSinglePass_MatrixAssemblyAgent::specify_gathered_nonzeros()
+{
+    const size_t num_repeats = m_authority->sparse_builder->get_number_of_passes_over_all_nonzero_entries();
+    const size_t num_threads = m_thread_rows.size();
+    for(size_t repeat = 0u; repeat < num_repeats; repeat++)
+    {
+        for(size_t thread = 0u; thread < num_threads; thread++)
+        {
+            const std::vector<size_t>& rows = m_thread_rows[thread];
+            const std::vector<size_t>& columns = m_thread_columns[thread];
+            const std::vector<double>& values = m_thread_values[thread];
+            const size_t num_nonzeros = rows.size();
+            for(size_t nonzero = 0u; nonzero < num_nonzeros; nonzero++)
+            {
+                m_authority->sparse_builder->specify_nonzero(rows[nonzero], columns[nonzero], values[nonzero]);
+            }
+        }
+        m_authority->sparse_builder->advance_pass();
+    }
+
+    // release buffers
+    m_thread_rows.clear();
+    m_thread_columns.clear();
+    m_thread_values.clear();
+}
+
+}
@@ -0,0 +1,101 @@
+/*
+//@HEADER
+// *************************************************************************
+//   Plato Engine v.1.0: Copyright 2018, National Technology & Engineering
+//                    Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Sandia Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact the Plato team (plato3D-help@sandia.gov)
+//
+// *************************************************************************
+//@HEADER
+*/
+
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Assembles linear system based on functional form, searching and evaluating once per point.
+ *
+ * Rows are distributed over threads. Each thread gathers the nonzeros of its rows into its own
+ * buffers, then the buffers are stitched in row order into the sparse matrix builder, so the
+ * assembled matrices are identical to those of the by row agent.
+ */
+
+#include "PSL_ByRow_MatrixAssemblyAgent.hpp"
+
+#include <vector>
+#include <cstddef>
+
+namespace PlatoSubproblemLibrary
+{
+namespace AbstractInterface
+{
+class SparseMatrix;
+}
+class AbstractAuthority;
+class ParameterData;
+class PointCloud;
+class Abstract_BoundedSupportFunction;
+
+class ByRowSinglePass_MatrixAssemblyAgent : public ByRow_MatrixAssemblyAgent
+{
+public:
+    ByRowSinglePass_MatrixAssemblyAgent(AbstractAuthority* authority,
+                                        ParameterData* input_data);
+
+protected:
+
+    void build_local(Abstract_BoundedSupportFunction* bounded_support_function,
+                     PointCloud* kernel_points,
+                     AbstractInterface::SparseMatrix** local_kernel_matrix) override;
+    void compute_nonlocal_matrix_for_above_processor(Abstract_BoundedSupportFunction* bounded_support_function,
+                                                     const std::vector<size_t>& processor_neighbors_above,
+                                                     std::vector<PointCloud*>& nonlocal_kernel_points,
+                                                     PointCloud* local_kernel_points,
+                                                     std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+                                                     const std::vector<int>& num_points_per_processor) override;
+
+    // search and evaluate for each query point, nonzeros are buffered per thread in query order
+    void gather_nonzeros(Abstract_BoundedSupportFunction* bounded_support_function,
+                         PointCloud* query_points,
+                         PointCloud* answer_points,
+                         bool is_query_row);
+    // specify buffered nonzeros over all passes of the sparse matrix builder
+    void specify_gathered_nonzeros();
+
+    std::vector<std::vector<size_t> > m_thread_rows;
+    std::vector<std::vector<size_t> > m_thread_columns;
+    std::vector<std::vector<double> > m_thread_values;
+
+};
+
+}
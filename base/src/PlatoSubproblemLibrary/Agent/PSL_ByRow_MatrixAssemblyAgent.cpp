@@ -75,6 +75,15 @@ ByRow_MatrixAssemblyAgent::ByRow_MatrixAssemblyAgent(AbstractAuthority* authorit
 {
 }
 
+ByRow_MatrixAssemblyAgent::ByRow_MatrixAssemblyAgent(matrix_assembly_agent_t::matrix_assembly_agent_t type,
+                                                     AbstractAuthority* authority,
+                                                     ParameterData* input_data) :
+        Abstract_MatrixAssemblyAgent(type, authority),
+        m_input_data(input_data),
+        m_support_distance(-1.)
+{
+}
+
 void ByRow_MatrixAssemblyAgent::build(Abstract_BoundedSupportFunction* bounded_support_function,
                                       PointCloud* local_kernel_points,
                                       std::vector<PointCloud*>& nonlocal_kernel_points,
@@ -138,11 +147,11 @@ void ByRow_MatrixAssemblyAgent::build_local(Abstract_BoundedSupportFunction* bou
     {
         for(size_t point1_index = 0; point1_index < num_points; point1_index++)
         {
-            Point* point1 = kernel_points->get_point(point1_index);
+            Point point1 = kernel_points->get_point(point1_index);
 
             // determine which points are within the radius of point1
             num_neighbors = 0;
-            m_searcher->get_neighbors(point1, neighbors_buffer, num_neighbors);
+            m_searcher->get_neighbors(&point1, neighbors_buffer, num_neighbors);
 
             // this sort is not necessary but promotes more sequential access
             std::sort(&neighbors_buffer[0], &neighbors_buffer[num_neighbors]);
@@ -151,10 +160,10 @@ void ByRow_MatrixAssemblyAgent::build_local(Abstract_BoundedSupportFunction* bou
             for(size_t neighbor_index = 0; neighbor_index < num_neighbors; neighbor_index++)
             {
                 const size_t point2_index = neighbors_buffer[neighbor_index];
-                Point* point2 = kernel_points->get_point(point2_index);
+                Point point2 = kernel_points->get_point(point2_index);
 
                 // if weight positive, store
-                const double weight = bounded_support_function->evaluate(point1, point2);
+                const double weight = bounded_support_function->evaluate(&point1, &point2);
                 if(weight > 0)
                 {
                     m_authority->sparse_builder->specify_nonzero(point1_index, point2_index, weight);
@@ -198,11 +207,11 @@ void ByRow_MatrixAssemblyAgent::compute_nonlocal_matrix_for_above_processor(Abst
         {
             for(size_t nonlocal_index = 0; nonlocal_index < num_nonLocal_within_radius; nonlocal_index++)
             {
-                Point* nonlocal_point = nonlocal_kernel_points[upper_proc_id]->get_point(nonlocal_index);
+                Point nonlocal_point = nonlocal_kernel_points[upper_proc_id]->get_point(nonlocal_index);
 
                 // determine which points are within the radius of point1
                 num_neighbors = 0;
-                m_searcher->get_neighbors(nonlocal_point, neighbors_buffer, num_neighbors);
+                m_searcher->get_neighbors(&nonlocal_point, neighbors_buffer, num_neighbors);
 
                 // this sort is not necessary but promotes more sequential access
                 std::sort(&neighbors_buffer[0], &neighbors_buffer[num_neighbors]);
@@ -211,14 +220,14 @@ void ByRow_MatrixAssemblyAgent::compute_nonlocal_matrix_for_above_processor(Abst
                 for(size_t neighbor_index = 0; neighbor_index < num_neighbors; neighbor_index++)
                 {
                     const size_t local_neighbor = neighbors_buffer[neighbor_index];
-                    Point* local_point = local_kernel_points->get_point(local_neighbor);
+                    Point local_point = local_kernel_points->get_point(local_neighbor);
 
                     // if weight positive, store
-                    const double weight = bounded_support_function->evaluate(local_point, nonlocal_point);
+                    const double weight = bounded_support_function->evaluate(&local_point, &nonlocal_point);
                     if(weight > 0)
                     {
-                        const size_t row = local_point->get_index();
-                        const size_t column = nonlocal_point->get_index();
+                        const size_t row = local_point.get_index();
+                        const size_t column = nonlocal_point.get_index();
 
                         m_authority->sparse_builder->specify_nonzero(row, column, weight);
                     }
@@ -81,16 +81,19 @@ public:
                std::vector<AbstractInterface::SparseMatrix*>& parallel_block_column_kernel_matrices) override;
 
 protected:
+    ByRow_MatrixAssemblyAgent(matrix_assembly_agent_t::matrix_assembly_agent_t type,
+                              AbstractAuthority* authority,
+                              ParameterData* input_data);
 
-    void build_local(Abstract_BoundedSupportFunction* bounded_support_function,
-                     PointCloud* kernel_points,
-                     AbstractInterface::SparseMatrix** local_kernel_matrix);
-    void compute_nonlocal_matrix_for_above_processor(Abstract_BoundedSupportFunction* bounded_support_function,
-                                                     const std::vector<size_t>& processor_neighbors_above,
-                                                     std::vector<PointCloud*>& nonlocal_kernel_points,
-                                                     PointCloud* local_kernel_points,
-                                                     std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
-                                                     const std::vector<int>& num_points_per_processor);
+    virtual void build_local(Abstract_BoundedSupportFunction* bounded_support_function,
+                             PointCloud* kernel_points,
+                             AbstractInterface::SparseMatrix** local_kernel_matrix);
+    virtual void compute_nonlocal_matrix_for_above_processor(Abstract_BoundedSupportFunction* bounded_support_function,
+                                                             const std::vector<size_t>& processor_neighbors_above,
+                                                             std::vector<PointCloud*>& nonlocal_kernel_points,
+                                                             PointCloud* local_kernel_points,
+                                                             std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+                                                             const std::vector<int>& num_points_per_processor);
     void send_block_row_to_above_processor(const std::vector<size_t>& processor_neighbors_above,
                                            std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices);
     void recv_block_row_from_below_processor(const std::vector<size_t>& processor_neighbors_below,
@@ -193,7 +193,7 @@ void Default_MatrixNormalizationAgent::normalizeBlockRow_bySetupReproducingCondi
         const size_t num_nonLocal_boxes = nonlocal_kernel_points[rank_]->get_num_points();
         for(size_t index = 0; index < num_nonLocal_boxes; index++)
         {
-            nonLocalColumnToIndex[rank_][nonlocal_kernel_points[rank_]->get_point(index)->get_index()] = index;
+            nonLocalColumnToIndex[rank_][nonlocal_kernel_points[rank_]->get_index(index)] = index;
         }
     }
 
@@ -201,10 +201,9 @@ void Default_MatrixNormalizationAgent::normalizeBlockRow_bySetupReproducingCondi
     for(size_t row = 0; row < num_rows; row++)
     {
         // get this row's center
-        Point* this_row = kernel_points->get_point(row);
-        const double row_x = (*this_row)(0);
-        const double row_y = (*this_row)(1);
-        const double row_z = (*this_row)(2);
+        const double row_x = kernel_points->get_coordinate(row, 0u);
+        const double row_y = kernel_points->get_coordinate(row, 1u);
+        const double row_z = kernel_points->get_coordinate(row, 2u);
 
         // get data
         std::vector<double> initial_weights;
@@ -220,10 +219,10 @@ void Default_MatrixNormalizationAgent::normalizeBlockRow_bySetupReproducingCondi
         const size_t num_local_tmp_row_columns = tmp_row_columns.size();
         for(size_t nz = 0u; nz < num_local_tmp_row_columns; nz++)
         {
-            Point* this_column = kernel_points->get_point(tmp_row_columns[nz]);
-            Constraints_x.push_back((*this_column)(0u) - row_x);
-            Constraints_y.push_back((*this_column)(1u) - row_y);
-            Constraints_z.push_back((*this_column)(2u) - row_z);
+            const size_t column = tmp_row_columns[nz];
+            Constraints_x.push_back(kernel_points->get_coordinate(column, 0u) - row_x);
+            Constraints_y.push_back(kernel_points->get_coordinate(column, 1u) - row_y);
+            Constraints_z.push_back(kernel_points->get_coordinate(column, 2u) - row_z);
         }
 
         // add nonlocal contributions
@@ -240,10 +239,10 @@ void Default_MatrixNormalizationAgent::normalizeBlockRow_bySetupReproducingCondi
             const size_t num_nonlocal_tmp_row_columns = tmp_row_columns.size();
             for(size_t nz = 0u; nz < num_nonlocal_tmp_row_columns; nz++)
             {
-                Point* this_column = nonlocal_kernel_points[rank_]->get_point(nonLocalColumnToIndex[rank_][tmp_row_columns[nz]]);
-                Constraints_x.push_back((*this_column)(0u) - row_x);
-                Constraints_y.push_back((*this_column)(1u) - row_y);
-                Constraints_z.push_back((*this_column)(2u) - row_z);
+                const size_t column = nonLocalColumnToIndex[rank_][tmp_row_columns[nz]];
+                Constraints_x.push_back(nonlocal_kernel_points[rank_]->get_coordinate(column, 0u) - row_x);
+                Constraints_y.push_back(nonlocal_kernel_points[rank_]->get_coordinate(column, 1u) - row_y);
+                Constraints_z.push_back(nonlocal_kernel_points[rank_]->get_coordinate(column, 2u) - row_z);
             }
         }
 
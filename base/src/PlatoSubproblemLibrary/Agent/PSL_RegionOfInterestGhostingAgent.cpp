@@ -210,15 +210,15 @@ PointCloud* RegionOfInterestGhostingAgent::share(double spatial_tolerance,
                 }
 
                 // fill sending points
-                PointCloud points_to_send;
+                std::vector<size_t> indexes_to_send;
                 for(size_t local_index = 0u; local_index < num_local_points; local_index++)
                 {
                     if(to_send[local_index] && is_local_point_of_interest[local_index])
                     {
-                        Point* local_point = globally_indexed_local_nodes->get_point(local_index);
-                        points_to_send.push_back(*local_point);
+                        indexes_to_send.push_back(local_index);
                     }
                 }
+                PointCloud points_to_send(globally_indexed_local_nodes, indexes_to_send);
 
                 // send
                 m_authority->mpi_wrapper->send_point_cloud(rank, &points_to_send);
@@ -252,8 +252,7 @@ PointCloud* RegionOfInterestGhostingAgent::share(double spatial_tolerance,
     {
         if(transfer_local[local_index] && is_local_point_of_interest[local_index])
         {
-            Point* local_point = globally_indexed_local_nodes->get_point(local_index);
-            global_points_of_interest->push_back(*local_point);
+            global_points_of_interest->push_back(globally_indexed_local_nodes->get_point(local_index));
         }
     }
 
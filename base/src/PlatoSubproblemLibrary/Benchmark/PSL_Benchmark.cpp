@@ -0,0 +1,517 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_Benchmark.hpp"
+
+#include "PSL_AbstractAuthority.hpp"
+#include "PSL_Abstract_MpiWrapper.hpp"
+#include "PSL_Abstract_FixedRadiusNearestNeighborsSearcher.hpp"
+#include "PSL_Abstract_SparseMatrix.hpp"
+#include "PSL_SpatialSearcherFactory.hpp"
+#include "PSL_BoundedSupportFunctionFactory.hpp"
+#include "PSL_Abstract_BoundedSupportFunction.hpp"
+#include "PSL_ByRow_MatrixAssemblyAgent.hpp"
+#include "PSL_ParameterData.hpp"
+#include "PSL_ParameterDataEnums.hpp"
+#include "PSL_KernelFilter.hpp"
+#include "PSL_Implementation_MeshModular.hpp"
+#include "PSL_Interface_MeshModular.hpp"
+#include "PSL_Interface_ParallelExchanger_global.hpp"
+#include "PSL_Interface_ParallelVector.hpp"
+#include "PSL_Point.hpp"
+#include "PSL_PointCloud.hpp"
+#include "PSL_FreeHelpers.hpp"
+#include "PSL_Random.hpp"
+
+#ifdef AMFILTER_ENABLED
+#include "PSL_AMFilterUtilities.hpp"
+#include "PSL_TetMeshUtilities.hpp"
+#include "PSL_OrthogonalGridUtilities.hpp"
+#include "PSL_Vector.hpp"
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+
+namespace PlatoSubproblemLibrary
+{
+
+Benchmark::Benchmark(AbstractAuthority* authority, std::ostream* output) :
+        m_authority(authority),
+        m_output(output),
+        m_points_per_side(24u),
+        m_perturbation(0.25),
+        m_radius(2.),
+        m_repetitions(5u),
+        m_brute_force_limit(8000u)
+{
+}
+
+Benchmark::~Benchmark()
+{
+}
+
+void Benchmark::set_points_per_side(size_t points_per_side)
+{
+    m_points_per_side = std::max(points_per_side, size_t(2u));
+}
+
+void Benchmark::set_perturbation(double perturbation)
+{
+    m_perturbation = perturbation;
+}
+
+void Benchmark::set_radius(double radius)
+{
+    m_radius = radius;
+}
+
+void Benchmark::set_repetitions(size_t repetitions)
+{
+    m_repetitions = std::max(repetitions, size_t(1u));
+}
+
+void Benchmark::set_brute_force_limit(size_t brute_force_limit)
+{
+    m_brute_force_limit = brute_force_limit;
+}
+
+void Benchmark::run_all()
+{
+    for(int perturbed = 0; perturbed < 2; perturbed++)
+    {
+        run_spatial_searchers(perturbed);
+        run_matrix_assembly(perturbed);
+        run_kernel_filter(perturbed);
+        run_am_filter_utilities(perturbed);
+    }
+}
+
+void Benchmark::run_spatial_searchers(bool perturbed)
+{
+    PointCloud cloud;
+    build_point_cloud(perturbed, &cloud);
+    const size_t num_points = cloud.get_num_points();
+    const std::string case_name = get_case_name(perturbed);
+
+    std::vector<std::pair<spatial_searcher_t::spatial_searcher_t, std::string> > searchers;
+    if(num_points <= m_brute_force_limit)
+    {
+        searchers.push_back(std::make_pair(spatial_searcher_t::bounding_box_brute_force, "bounding_box_brute_force"));
+        searchers.push_back(std::make_pair(spatial_searcher_t::brute_force_fixed_radius_nearest_neighbors, "brute_force_fixed_radius_nearest_neighbors"));
+    }
+    searchers.push_back(std::make_pair(spatial_searcher_t::bounding_box_morton_hierarchy, "bounding_box_morton_hierarchy"));
+    searchers.push_back(std::make_pair(spatial_searcher_t::radix_grid_fixed_radius_nearest_neighbors, "radix_grid_fixed_radius_nearest_neighbors"));
+    searchers.push_back(std::make_pair(spatial_searcher_t::cell_list_fixed_radius_nearest_neighbors, "cell_list_fixed_radius_nearest_neighbors"));
+#ifdef AMFILTER_ENABLED
+    searchers.push_back(std::make_pair(spatial_searcher_t::arborx_fixed_radius_nearest_neighbors, "arborx_fixed_radius_nearest_neighbors"));
+#endif
+
+    const size_t num_searchers = searchers.size();
+    for(size_t s = 0u; s < num_searchers; s++)
+    {
+        AbstractInterface::FixedRadiusNearestNeighborsSearcher* searcher = NULL;
+        std::vector<size_t> neighbor_offsets;
+        std::vector<size_t> neighbor_indexes;
+        time("searcher_build/" + searchers[s].second,
+             case_name,
+             num_points,
+             [&]()
+             {
+                 safe_free(searcher);
+                 searcher = build_fixed_radius_nearest_neighbors_searcher(searchers[s].first, m_authority);
+             },
+             [&]()
+             {
+                 searcher->build(&cloud, m_radius);
+             });
+        time("searcher_query/" + searchers[s].second,
+             case_name,
+             num_points,
+             [&]()
+             {
+                 neighbor_offsets.clear();
+                 neighbor_indexes.clear();
+             },
+             [&]()
+             {
+                 searcher->get_all_neighbors(&cloud, num_points, neighbor_offsets, neighbor_indexes);
+             });
+        safe_free(searcher);
+    }
+}
+
+void Benchmark::run_matrix_assembly(bool perturbed)
+{
+    PointCloud cloud;
+    build_point_cloud(perturbed, &cloud);
+    const size_t num_points = cloud.get_num_points();
+
+    ParameterData input_data;
+    input_data.set_penalty(3.);
+    input_data.set_spatial_searcher(spatial_searcher_t::recommended);
+    Abstract_BoundedSupportFunction* bounded_support_function =
+            build_bounded_support_function(bounded_support_function_t::polynomial_tent_function, m_authority);
+    bounded_support_function->build(m_radius, &input_data);
+
+    // local assembly only, processors are not ghosted
+    ByRow_MatrixAssemblyAgent agent(m_authority, &input_data);
+    std::vector<PointCloud*> nonlocal_kernel_points;
+    const std::vector<size_t> no_neighbors;
+    AbstractInterface::SparseMatrix* local_kernel_matrix = NULL;
+    std::vector<AbstractInterface::SparseMatrix*> block_row_kernel_matrices;
+    std::vector<AbstractInterface::SparseMatrix*> block_column_kernel_matrices;
+    time("matrix_assembly/by_row",
+         get_case_name(perturbed),
+         num_points,
+         [&]()
+         {
+             safe_free(local_kernel_matrix);
+             safe_free(block_row_kernel_matrices);
+             safe_free(block_column_kernel_matrices);
+         },
+         [&]()
+         {
+             agent.build(bounded_support_function,
+                         &cloud,
+                         nonlocal_kernel_points,
+                         no_neighbors,
+                         no_neighbors,
+                         &local_kernel_matrix,
+                         block_row_kernel_matrices,
+                         block_column_kernel_matrices);
+         });
+
+    safe_free(local_kernel_matrix);
+    safe_free(block_row_kernel_matrices);
+    safe_free(block_column_kernel_matrices);
+    safe_free(bounded_support_function);
+}
+
+void Benchmark::run_kernel_filter(bool perturbed)
+{
+    // structured hex mesh, one block per processor
+    const size_t mpi_rank = m_authority->mpi_wrapper->get_rank();
+    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+    const double side_length = double(m_points_per_side - 1u);
+    example::ElementBlock block;
+    block.build_from_structured_grid(m_points_per_side, m_points_per_side, m_points_per_side,
+                                     side_length, side_length, side_length,
+                                     mpi_rank, mpi_size);
+    if(perturbed)
+    {
+        block.random_perturb_local_nodal_locations(m_perturbation);
+    }
+    example::Interface_MeshModular mesh;
+    mesh.set_mesh(&block);
+    const size_t num_points = mesh.get_num_points();
+
+    example::Interface_ParallelExchanger_global exchanger(m_authority);
+    std::vector<size_t> global_ids;
+    block.get_global_ids(global_ids);
+    exchanger.put_globals(global_ids);
+    exchanger.build();
+
+    std::vector<double> field(num_points);
+    uniform_rand_double(0., 1., field);
+    const std::string case_name = get_case_name(perturbed);
+
+    // assembled matrices by default, then the stencil where requested, which falls back to assembly off lattices
+    for(int stencil = 0; stencil < 2; stencil++)
+    {
+        ParameterData input_data;
+        input_data.set_absolute(m_radius);
+        input_data.set_penalty(3.);
+        input_data.set_iterations(1);
+        input_data.set_spatial_searcher(spatial_searcher_t::recommended);
+        input_data.set_normalization(normalization_t::classical_row_normalization);
+        input_data.set_reproduction(reproduction_level_t::reproduce_constant);
+        input_data.set_matrix_assembly_agent(matrix_assembly_agent_t::by_row);
+        input_data.set_symmetry_plane_agent(symmetry_plane_agent_t::by_narrow_clone);
+        input_data.set_mesh_scale_agent(mesh_scale_agent_t::by_average_optimized_element_side);
+        input_data.set_matrix_normalization_agent(matrix_normalization_agent_t::default_agent);
+        input_data.set_point_ghosting_agent(point_ghosting_agent_t::by_narrow_share);
+        input_data.set_bounded_support_function(bounded_support_function_t::polynomial_tent_function);
+        input_data.set_kernel_filter_structured_stencil(stencil);
+        const std::string variant = (stencil ? "structured_stencil" : "assembled");
+
+        KernelFilter* filter = NULL;
+        time("kernel_filter_build/" + variant,
+             case_name,
+             num_points,
+             [&]()
+             {
+                 safe_free(filter);
+                 filter = new KernelFilter(m_authority, &input_data, &mesh, &exchanger);
+             },
+             [&]()
+             {
+                 filter->build();
+             });
+
+        example::Interface_ParallelVector parallel_field(field);
+        example::Interface_ParallelVector parallel_gradient(field);
+        time("kernel_filter_apply/" + variant,
+             case_name,
+             num_points,
+             [&]()
+             {
+                 parallel_field.m_data = field;
+             },
+             [&]()
+             {
+                 filter->apply(&parallel_field);
+             });
+        time("kernel_filter_gradient/" + variant,
+             case_name,
+             num_points,
+             [&]()
+             {
+                 parallel_gradient.m_data = field;
+             },
+             [&]()
+             {
+                 filter->apply(NULL, &parallel_gradient);
+             });
+        safe_free(filter);
+    }
+}
+
+void Benchmark::run_am_filter_utilities(bool perturbed)
+{
+#ifdef AMFILTER_ENABLED
+    std::vector<std::vector<double> > coordinates;
+    std::vector<std::vector<int> > connectivity;
+    build_tet_mesh(perturbed, coordinates, connectivity);
+    const size_t num_nodes = coordinates.size();
+    const std::string case_name = get_case_name(perturbed);
+
+    // grid at the spacing of the tet mesh, building along z
+    TetMeshUtilities tet_utilities(coordinates, connectivity);
+    const Vector u_basis(std::vector<double>({1., 0., 0.}));
+    const Vector v_basis(std::vector<double>({0., 1., 0.}));
+    const Vector w_basis(std::vector<double>({0., 0., 1.}));
+    Vector max_uvw;
+    Vector min_uvw;
+    tet_utilities.computeBoundingBox(u_basis, v_basis, w_basis, max_uvw, min_uvw);
+    OrthogonalGridUtilities grid_utilities(u_basis, v_basis, w_basis, max_uvw, min_uvw, 1.);
+    const double p_norm = 20.;
+
+    AMFilterUtilities* am_utilities = NULL;
+    time("am_filter/construction",
+         case_name,
+         num_nodes,
+         [&]()
+         {
+             safe_free(am_utilities);
+         },
+         [&]()
+         {
+             am_utilities = new AMFilterUtilities(tet_utilities, grid_utilities, p_norm);
+         });
+
+    std::vector<double> blueprint(num_nodes);
+    uniform_rand_double(0.1, 0.9, blueprint);
+    std::vector<double> weights(num_nodes);
+    uniform_rand_double(-1., 1., weights);
+    example::Interface_ParallelVector tet_density(blueprint);
+    example::Interface_ParallelVector tet_gradient(weights);
+    std::vector<double> grid_blueprint;
+    std::vector<double> grid_printable;
+    std::vector<double> grid_printable_gradient;
+    std::vector<double> grid_blueprint_gradient;
+    const std::function<void()> no_setup = []() {};
+
+    time("am_filter/grid_blueprint_density", case_name, num_nodes, no_setup,
+         [&]()
+         {
+             am_utilities->computeGridBlueprintDensity(&tet_density, grid_blueprint);
+         });
+    time("am_filter/grid_printable_density", case_name, num_nodes, no_setup,
+         [&]()
+         {
+             am_utilities->computeGridPrintableDensity(grid_blueprint, grid_printable);
+         });
+    time("am_filter/tet_mesh_printable_density", case_name, num_nodes,
+         [&]()
+         {
+             tet_density.m_data = blueprint;
+         },
+         [&]()
+         {
+             am_utilities->computeTetMeshPrintableDensity(grid_printable, &tet_density);
+         });
+    tet_density.m_data = blueprint;
+    time("am_filter/grid_printable_density_gradient", case_name, num_nodes, no_setup,
+         [&]()
+         {
+             am_utilities->computeGridPrintableDensityGradient(&tet_gradient, grid_printable_gradient);
+         });
+    time("am_filter/grid_blueprint_density_gradient", case_name, num_nodes, no_setup,
+         [&]()
+         {
+             am_utilities->computeGridBlueprintDensityGradient(grid_blueprint, grid_printable, grid_printable_gradient, grid_blueprint_gradient);
+         });
+    time("am_filter/tet_mesh_blueprint_density_gradient", case_name, num_nodes,
+         [&]()
+         {
+             tet_gradient.m_data = weights;
+         },
+         [&]()
+         {
+             am_utilities->computeTetMeshBlueprintDensityGradient(&tet_density, grid_blueprint_gradient, &tet_gradient);
+         });
+    safe_free(am_utilities);
+#else
+    (void)perturbed;
+#endif
+}
+
+void Benchmark::build_point_cloud(bool perturbed, PointCloud* cloud)
+{
+    // unit spaced lattice, processors side by side along x
+    const size_t n = m_points_per_side;
+    const double x_offset = double(n * m_authority->mpi_wrapper->get_rank());
+    std::vector<Point> points(n * n * n);
+    std::vector<double> coordinates(3u);
+    size_t counter = 0u;
+    for(size_t i = 0u; i < n; i++)
+    {
+        for(size_t j = 0u; j < n; j++)
+        {
+            for(size_t k = 0u; k < n; k++)
+            {
+                coordinates[0] = x_offset + double(i);
+                coordinates[1] = double(j);
+                coordinates[2] = double(k);
+                if(perturbed)
+                {
+                    for(size_t d = 0u; d < 3u; d++)
+                    {
+                        coordinates[d] += uniform_rand_double(-m_perturbation, m_perturbation);
+                    }
+                }
+                points[counter].set(counter, coordinates);
+                counter++;
+            }
+        }
+    }
+    cloud->assign(points);
+}
+
+void Benchmark::build_tet_mesh(bool perturbed, std::vector<std::vector<double> >& coordinates, std::vector<std::vector<int> >& connectivity)
+{
+    // unit cubes each split into 6 tets sharing the cube diagonal, interior nodes perturbed
+    const size_t num_cubes = m_points_per_side - 1u;
+    const size_t n = m_points_per_side;
+    coordinates.clear();
+    connectivity.clear();
+    for(size_t i = 0u; i < n; i++)
+    {
+        for(size_t j = 0u; j < n; j++)
+        {
+            for(size_t k = 0u; k < n; k++)
+            {
+                std::vector<double> node = {double(i), double(j), double(k)};
+                const bool interior = (0u < i && i + 1u < n && 0u < j && j + 1u < n && 0u < k && k + 1u < n);
+                if(perturbed && interior)
+                {
+                    for(size_t d = 0u; d < 3u; d++)
+                    {
+                        node[d] += uniform_rand_double(-m_perturbation, m_perturbation);
+                    }
+                }
+                coordinates.push_back(node);
+            }
+        }
+    }
+    const std::vector<std::vector<size_t> > permutations = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for(size_t i = 0u; i < num_cubes; i++)
+    {
+        for(size_t j = 0u; j < num_cubes; j++)
+        {
+            for(size_t k = 0u; k < num_cubes; k++)
+            {
+                for(size_t p = 0u; p < permutations.size(); p++)
+                {
+                    std::vector<size_t> corner = {i, j, k};
+                    std::vector<int> tet(1u, int((corner[0] * n + corner[1]) * n + corner[2]));
+                    for(size_t d = 0u; d < 3u; d++)
+                    {
+                        corner[permutations[p][d]]++;
+                        tet.push_back(int((corner[0] * n + corner[1]) * n + corner[2]));
+                    }
+                    connectivity.push_back(tet);
+                }
+            }
+        }
+    }
+}
+
+std::string Benchmark::get_case_name(bool perturbed)
+{
+    return (perturbed ? "perturbed" : "structured");
+}
+
+void Benchmark::time(const std::string& benchmark,
+                     const std::string& case_name,
+                     size_t local_size,
+                     const std::function<void()>& setup,
+                     const std::function<void()>& function)
+{
+    std::vector<double> seconds(m_repetitions);
+    for(size_t repetition = 0u; repetition < m_repetitions; repetition++)
+    {
+        setup();
+
+        // start together, so the slowest processor is the time of the repetition
+        int local_ready = 1;
+        int global_ready = 0;
+        m_authority->mpi_wrapper->all_reduce_max(local_ready, global_ready);
+
+        const double start = getTimeInSeconds();
+        function();
+        double local_seconds = getTimeInSeconds() - start;
+        m_authority->mpi_wrapper->all_reduce_max(local_seconds, seconds[repetition]);
+    }
+    record(benchmark, case_name, local_size, seconds);
+}
+
+void Benchmark::record(const std::string& benchmark, const std::string& case_name, size_t local_size, const std::vector<double>& seconds)
+{
+    int local_size_int = local_size;
+    int max_local_size = 0;
+    m_authority->mpi_wrapper->all_reduce_max(local_size_int, max_local_size);
+    if(m_authority->mpi_wrapper->get_rank() != 0u)
+    {
+        return;
+    }
+
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+
+    std::stringstream stream;
+    stream << "{\"benchmark\":\"" << benchmark << "\""
+           << ",\"case\":\"" << case_name << "\""
+           << ",\"processors\":" << m_authority->mpi_wrapper->get_size()
+           << ",\"threads\":" << num_threads
+           << ",\"points_per_processor\":" << max_local_size
+           << ",\"radius\":" << m_radius
+           << ",\"repetitions\":" << seconds.size()
+           << ",\"min_seconds\":" << min(seconds)
+           << ",\"mean_seconds\":" << mean(seconds)
+           << ",\"max_seconds\":" << max(seconds)
+           << "}" << std::endl;
+    (*m_output) << stream.str();
+}
+
+}
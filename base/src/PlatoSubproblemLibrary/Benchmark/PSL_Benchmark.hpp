@@ -0,0 +1,64 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Times the hot paths of the library on synthetic inputs.
+ *
+ * Each measurement is one line of json written by rank 0, with the maximum time over ranks of every repetition.
+ */
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <ostream>
+#include <functional>
+
+namespace PlatoSubproblemLibrary
+{
+class AbstractAuthority;
+class PointCloud;
+
+class Benchmark
+{
+public:
+    Benchmark(AbstractAuthority* authority, std::ostream* output);
+    ~Benchmark();
+
+    // lattice points per side on each processor
+    void set_points_per_side(size_t points_per_side);
+    // fraction of the lattice spacing that perturbed points move in each coordinate
+    void set_perturbation(double perturbation);
+    // filter and search radius, in lattice spacings
+    void set_radius(double radius);
+    void set_repetitions(size_t repetitions);
+    // brute force searchers are skipped above this many points per processor
+    void set_brute_force_limit(size_t brute_force_limit);
+
+    void run_all();
+    void run_spatial_searchers(bool perturbed);
+    void run_matrix_assembly(bool perturbed);
+    void run_kernel_filter(bool perturbed);
+    void run_am_filter_utilities(bool perturbed);
+
+private:
+    void build_point_cloud(bool perturbed, PointCloud* cloud);
+    void build_tet_mesh(bool perturbed, std::vector<std::vector<double> >& coordinates, std::vector<std::vector<int> >& connectivity);
+    std::string get_case_name(bool perturbed);
+
+    // run setup untimed then function timed, for each repetition
+    void time(const std::string& benchmark,
+              const std::string& case_name,
+              size_t local_size,
+              const std::function<void()>& setup,
+              const std::function<void()>& function);
+    void record(const std::string& benchmark, const std::string& case_name, size_t local_size, const std::vector<double>& seconds);
+
+    AbstractAuthority* m_authority;
+    std::ostream* m_output;
+    size_t m_points_per_side;
+    double m_perturbation;
+    double m_radius;
+    size_t m_repetitions;
+    size_t m_brute_force_limit;
+};
+
+}
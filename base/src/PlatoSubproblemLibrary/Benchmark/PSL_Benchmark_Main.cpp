@@ -0,0 +1,160 @@
+/*
+//@HEADER
+// *************************************************************************
+//   Plato Engine v.1.0: Copyright 2018, National Technology & Engineering
+//                    Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Sandia Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact the Plato team (plato3D-help@sandia.gov)
+//
+// *************************************************************************
+//@HEADER
+*/
+
+#include <mpi.h>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+
+#ifdef AMFILTER_ENABLED
+#include <Kokkos_Core.hpp>
+#endif
+
+#include "PSL_Benchmark.hpp"
+#include "PSL_AbstractAuthority.hpp"
+#include "PSL_Abstract_MpiWrapper.hpp"
+#include "PSL_Random.hpp"
+
+void print_usage()
+{
+    std::cout << "\n\nUsage: PlatoPSLBenchmark [options]\n"
+              << "  --side <n>                lattice points per side on each rank (default 24)\n"
+              << "  --perturbation <p>        perturbation as a fraction of the spacing (default 0.25)\n"
+              << "  --radius <r>              filter and search radius in spacings (default 2)\n"
+              << "  --repetitions <n>         timed repetitions of each benchmark (default 5)\n"
+              << "  --brute-force-limit <n>   skip brute force searchers above this many points (default 8000)\n"
+              << "  --output <file>           json lines are appended to this file instead of stdout\n\n";
+}
+
+/******************************************************************************/
+int main(int argc, char *argv[])
+/******************************************************************************/
+{
+    MPI_Init(&argc, &argv);
+#ifdef AMFILTER_ENABLED
+    Kokkos::initialize(argc, argv);
+#endif
+
+    int return_code = 0;
+    {
+        PlatoSubproblemLibrary::AbstractAuthority authority;
+        PlatoSubproblemLibrary::set_rand_seed();
+
+        std::ofstream output_file;
+        std::ostream* output = &std::cout;
+        size_t side = 24u;
+        double perturbation = 0.25;
+        double radius = 2.;
+        size_t repetitions = 5u;
+        size_t brute_force_limit = 8000u;
+        bool print_help = false;
+        for(int i = 1; i < argc; i++)
+        {
+            const bool has_value = (i + 1 < argc);
+            if(!std::strcmp(argv[i], "-h") || !std::strcmp(argv[i], "--help"))
+            {
+                print_help = true;
+            }
+            else if(has_value && !std::strcmp(argv[i], "--side"))
+            {
+                side = std::atoi(argv[++i]);
+            }
+            else if(has_value && !std::strcmp(argv[i], "--perturbation"))
+            {
+                perturbation = std::atof(argv[++i]);
+            }
+            else if(has_value && !std::strcmp(argv[i], "--radius"))
+            {
+                radius = std::atof(argv[++i]);
+            }
+            else if(has_value && !std::strcmp(argv[i], "--repetitions"))
+            {
+                repetitions = std::atoi(argv[++i]);
+            }
+            else if(has_value && !std::strcmp(argv[i], "--brute-force-limit"))
+            {
+                brute_force_limit = std::atoi(argv[++i]);
+            }
+            else if(has_value && !std::strcmp(argv[i], "--output"))
+            {
+                // only rank 0 records
+                const char* filename = argv[++i];
+                if(authority.mpi_wrapper->get_rank() == 0u)
+                {
+                    output_file.open(filename, std::ios::app);
+                    output = &output_file;
+                }
+            }
+            else
+            {
+                print_help = true;
+                return_code = 1;
+            }
+        }
+
+        if(print_help)
+        {
+            if(authority.mpi_wrapper->get_rank() == 0u)
+            {
+                print_usage();
+            }
+        }
+        else
+        {
+            PlatoSubproblemLibrary::Benchmark benchmark(&authority, output);
+            benchmark.set_points_per_side(side);
+            benchmark.set_perturbation(perturbation);
+            benchmark.set_radius(radius);
+            benchmark.set_repetitions(repetitions);
+            benchmark.set_brute_force_limit(brute_force_limit);
+            benchmark.run_all();
+        }
+    }
+
+#ifdef AMFILTER_ENABLED
+    Kokkos::finalize();
+#endif
+    MPI_Finalize();
+    return return_code;
+}
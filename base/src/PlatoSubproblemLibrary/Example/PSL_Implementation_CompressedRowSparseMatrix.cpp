@@ -7,8 +7,9 @@
 #include <vector>
 #include <cassert>
 #include <algorithm>
-#include <map>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <mpi.h>
 
 namespace PlatoSubproblemLibrary
@@ -17,6 +18,57 @@ namespace PlatoSubproblemLibrary
 namespace example
 {
 
+// below this many nonzeros, products are not worth distributing over threads
+static const size_t s_min_nonzeros_for_parallel_product = 16384u;
+
+// products over any storage of columns and values, always accumulating in double
+template<typename ColumnType, typename ValueType>
+static double row_product(const ColumnType* columns,
+                          const ValueType* data,
+                          size_t nz_begin,
+                          size_t nz_end,
+                          const double* input_data)
+{
+    // vector lanes change the order of summation, but deterministically for a given build
+    double result = 0.;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:result)
+#endif
+    for(size_t nz = nz_begin; nz < nz_end; nz++)
+    {
+        result += double(data[nz]) * input_data[columns[nz]];
+    }
+    return result;
+}
+
+template<typename ColumnType, typename ValueType>
+static void row_multi_product(const ColumnType* columns,
+                              const ValueType* data,
+                              size_t nz_begin,
+                              size_t nz_end,
+                              const double* input_data,
+                              size_t num_vectors,
+                              double* output)
+{
+    // vector lanes run across the interleaved vectors, so each vector sums in nonzero order
+    for(size_t vector = 0; vector < num_vectors; vector++)
+    {
+        output[vector] = 0.;
+    }
+    for(size_t nz = nz_begin; nz < nz_end; nz++)
+    {
+        const double value = data[nz];
+        const double* input_row = input_data + size_t(columns[nz]) * num_vectors;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for(size_t vector = 0; vector < num_vectors; vector++)
+        {
+            output[vector] += value * input_row[vector];
+        }
+    }
+}
+
 CompressedRowSparseMatrix::CompressedRowSparseMatrix(const size_t num_rows,
                                                      const size_t num_columns,
                                                      const std::vector<size_t>& integer_row_bounds,
@@ -30,13 +82,21 @@ CompressedRowSparseMatrix::CompressedRowSparseMatrix(const size_t num_rows,
         m_num_columns(num_columns),
         m_built_nonzero_sorted_rows_and_columns(false),
         m_nonzero_sorted_rows(),
-        m_nonzero_sorted_columns()
+        m_nonzero_sorted_columns(),
+        m_full_column_to_reduced_column(),
+        m_store_transpose(false),
+        m_transpose(NULL),
+        m_compact_storage(false),
+        m_single_precision(false),
+        m_compact_columns(),
+        m_single_precision_data()
 {
     assert(m_num_rows + 1u == m_matrix_row_bounds.size());
 }
 
 CompressedRowSparseMatrix::~CompressedRowSparseMatrix()
 {
+    internal_clear_transpose();
 }
 
 size_t CompressedRowSparseMatrix::getNumRows()
@@ -55,18 +115,23 @@ void CompressedRowSparseMatrix::matVec(const std::vector<double>& input, std::ve
         // output = M * input
 
         assert(m_num_columns == input.size());
-        output.assign(m_num_rows, 0.);
+        output.resize(m_num_rows);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(internal_is_parallel_product())
+#endif
         for(size_t row = 0; row < m_num_rows; row++)
         {
-            const size_t nz_begin = m_matrix_row_bounds[row];
-            const size_t nz_end = m_matrix_row_bounds[row + 1u];
-
-            for(size_t nz = nz_begin; nz < nz_end; nz++)
-            {
-                output[row] += m_matrix_data[nz] * input[m_matrix_columns[nz]];
-            }
+            output[row] = internal_row_product(row, input);
         }
     }
+    else if(m_store_transpose)
+    {
+        // output = M' * input, by rows of the stored transpose
+
+        assert(m_num_rows == input.size());
+        internal_build_transpose();
+        m_transpose->matVec(input, output, false);
+    }
     else
     {
         // output = M' * input
@@ -81,7 +146,7 @@ void CompressedRowSparseMatrix::matVec(const std::vector<double>& input, std::ve
 
             for(size_t nz = nz_begin; nz < nz_end; nz++)
             {
-                output[m_matrix_columns[nz]] += m_matrix_data[nz] * input[row];
+                output[internal_get_column(nz)] += internal_get_value(nz) * input[row];
             }
         }
     }
@@ -108,30 +173,151 @@ void CompressedRowSparseMatrix::matVecToReduced(const std::vector<double>& input
         // output = M * input
 
         assert(m_num_columns == input.size());
-        output.assign(m_nonzero_sorted_rows.size(), 0.);
-        size_t reduced_row = 0;
+        const size_t num_nonzero_rows = m_nonzero_sorted_rows.size();
+        output.resize(num_nonzero_rows);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(internal_is_parallel_product())
+#endif
+        for(size_t reduced_row = 0; reduced_row < num_nonzero_rows; reduced_row++)
+        {
+            output[reduced_row] = internal_row_product(m_nonzero_sorted_rows[reduced_row], input);
+        }
+    }
+    else if(m_store_transpose)
+    {
+        // output = M' * input, the nonzero rows of the stored transpose are the nonzero columns
+
+        assert(m_num_rows == input.size());
+        internal_build_transpose();
+        m_transpose->matVecToReduced(input, output, false);
+    }
+    else
+    {
+        // output = M' * input
+
+        assert(transpose);
+        assert(m_num_rows == input.size());
+        size_t num_nonzero_columns = m_nonzero_sorted_columns.size();
+        output.assign(num_nonzero_columns, 0.);
         for(size_t row = 0; row < m_num_rows; row++)
         {
             const size_t nz_begin = m_matrix_row_bounds[row];
             const size_t nz_end = m_matrix_row_bounds[row + 1];
-            if(nz_begin != nz_end)
+
+            for(size_t nz = nz_begin; nz < nz_end; nz++)
             {
-                for(size_t nz = nz_begin; nz < nz_end; nz++)
+                const size_t reduced_column = m_full_column_to_reduced_column[internal_get_column(nz)];
+                output[reduced_column] += internal_get_value(nz) * input[row];
+            }
+        }
+    }
+}
+
+void CompressedRowSparseMatrix::matMultiVec(const std::vector<double>& input,
+                                            std::vector<double>& output,
+                                            size_t num_vectors,
+                                            bool transpose)
+{
+    // a single vector keeps the summation order of matVec
+    if(num_vectors == 1u)
+    {
+        matVec(input, output, transpose);
+        return;
+    }
+
+    if(!transpose)
+    {
+        // output = M * input, each matrix entry loaded once for all vectors
+
+        assert(m_num_columns * num_vectors == input.size());
+        output.resize(m_num_rows * num_vectors);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(internal_is_parallel_product())
+#endif
+        for(size_t row = 0; row < m_num_rows; row++)
+        {
+            internal_row_multi_product(row, input, num_vectors, &output[row * num_vectors]);
+        }
+    }
+    else if(m_store_transpose)
+    {
+        // output = M' * input, by rows of the stored transpose
+
+        assert(m_num_rows * num_vectors == input.size());
+        internal_build_transpose();
+        m_transpose->matMultiVec(input, output, num_vectors, false);
+    }
+    else
+    {
+        // output = M' * input
+
+        assert(transpose);
+        assert(m_num_rows * num_vectors == input.size());
+        output.assign(m_num_columns * num_vectors, 0.);
+        for(size_t row = 0; row < m_num_rows; row++)
+        {
+            const size_t nz_begin = m_matrix_row_bounds[row];
+            const size_t nz_end = m_matrix_row_bounds[row + 1u];
+
+            for(size_t nz = nz_begin; nz < nz_end; nz++)
+            {
+                const size_t column = internal_get_column(nz);
+                const double value = internal_get_value(nz);
+                for(size_t vector = 0; vector < num_vectors; vector++)
                 {
-                    output[reduced_row] += m_matrix_data[nz] * input[m_matrix_columns[nz]];
+                    output[column * num_vectors + vector] += value * input[row * num_vectors + vector];
                 }
-                reduced_row++;
             }
         }
     }
+}
+
+void CompressedRowSparseMatrix::matMultiVecToReduced(const std::vector<double>& input,
+                                                     std::vector<double>& output,
+                                                     size_t num_vectors,
+                                                     bool transpose)
+{
+    // a single vector keeps the summation order of matVecToReduced
+    if(num_vectors == 1u)
+    {
+        matVecToReduced(input, output, transpose);
+        return;
+    }
+
+    this->internal_build_nonzero_sorted_rows_and_columns();
+    assert(m_built_nonzero_sorted_rows_and_columns);
+
+    if(!transpose)
+    {
+        // output = M * input
+
+        assert(m_num_columns * num_vectors == input.size());
+        const size_t num_nonzero_rows = m_nonzero_sorted_rows.size();
+        output.resize(num_nonzero_rows * num_vectors);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(internal_is_parallel_product())
+#endif
+        for(size_t reduced_row = 0; reduced_row < num_nonzero_rows; reduced_row++)
+        {
+            internal_row_multi_product(m_nonzero_sorted_rows[reduced_row], input, num_vectors, &output[reduced_row * num_vectors]);
+        }
+    }
+    else if(m_store_transpose)
+    {
+        // output = M' * input, the nonzero rows of the stored transpose are the nonzero columns
+
+        assert(m_num_rows * num_vectors == input.size());
+        internal_build_transpose();
+        m_transpose->matMultiVecToReduced(input, output, num_vectors, false);
+    }
     else
     {
         // output = M' * input
 
         assert(transpose);
-        assert(m_num_rows == input.size());
+        assert(m_num_rows * num_vectors == input.size());
         size_t num_nonzero_columns = m_nonzero_sorted_columns.size();
-        output.assign(num_nonzero_columns, 0.);
+        output.assign(num_nonzero_columns * num_vectors, 0.);
         for(size_t row = 0; row < m_num_rows; row++)
         {
             const size_t nz_begin = m_matrix_row_bounds[row];
@@ -139,8 +325,12 @@ void CompressedRowSparseMatrix::matVecToReduced(const std::vector<double>& input
 
             for(size_t nz = nz_begin; nz < nz_end; nz++)
             {
-                const size_t reduced_column = m_full_column_to_reduced_column[m_matrix_columns[nz]];
-                output[reduced_column] += m_matrix_data[nz] * input[row];
+                const size_t reduced_column = m_full_column_to_reduced_column[internal_get_column(nz)];
+                const double value = internal_get_value(nz);
+                for(size_t vector = 0; vector < num_vectors; vector++)
+                {
+                    output[reduced_column * num_vectors + vector] += value * input[row * num_vectors + vector];
+                }
             }
         }
     }
@@ -157,9 +347,10 @@ void CompressedRowSparseMatrix::rowNormalize(const std::vector<double>& rowNorma
         const size_t nz_end = m_matrix_row_bounds[row + 1];
         for(size_t nz = nz_begin; nz < nz_end; nz++)
         {
-            m_matrix_data[nz] *= rowNormalizationFactors[row];
+            internal_set_value(nz, internal_get_value(nz) * rowNormalizationFactors[row]);
         }
     }
+    internal_clear_transpose();
 }
 
 void CompressedRowSparseMatrix::columnNormalize(const std::vector<double>& columnNormalizationFactors)
@@ -167,12 +358,13 @@ void CompressedRowSparseMatrix::columnNormalize(const std::vector<double>& colum
     // multiply each row by its normalization factor
 
     assert(m_num_columns == columnNormalizationFactors.size());
-    size_t nnz = m_matrix_data.size();
+    size_t nnz = m_matrix_row_bounds[m_num_rows];
     for(size_t nz = 0; nz < nnz; nz++)
     {
-        const size_t column = m_matrix_columns[nz];
-        m_matrix_data[nz] *= columnNormalizationFactors[column];
+        const size_t column = internal_get_column(nz);
+        internal_set_value(nz, internal_get_value(nz) * columnNormalizationFactors[column]);
     }
+    internal_clear_transpose();
 }
 
 void CompressedRowSparseMatrix::getNonZeroSortedRows(std::vector<size_t>& nonZeroRows)
@@ -207,14 +399,52 @@ void CompressedRowSparseMatrix::getRow(size_t row, std::vector<double>& data, st
 {
     const size_t nz_begin = m_matrix_row_bounds[row];
     const size_t nz_end = m_matrix_row_bounds[row + 1];
-    data.assign(&m_matrix_data[nz_begin], &m_matrix_data[nz_end]);
-    columns.assign(&m_matrix_columns[nz_begin], &m_matrix_columns[nz_end]);
+    data.resize(nz_end - nz_begin);
+    columns.resize(nz_end - nz_begin);
+    for(size_t nz = nz_begin; nz < nz_end; nz++)
+    {
+        data[nz - nz_begin] = internal_get_value(nz);
+        columns[nz - nz_begin] = internal_get_column(nz);
+    }
 }
 
 void CompressedRowSparseMatrix::setRow(size_t row, const std::vector<double>& data)
 {
     const size_t nz_begin = m_matrix_row_bounds[row];
-    std::copy(data.begin(), data.end(), &m_matrix_data[nz_begin]);
+    const size_t num_row_nonzeros = data.size();
+    for(size_t nz = 0; nz < num_row_nonzeros; nz++)
+    {
+        internal_set_value(nz_begin + nz, data[nz]);
+    }
+    internal_clear_transpose();
+}
+
+void CompressedRowSparseMatrix::storeTranspose()
+{
+    // transpose is built on first transposed product, and rebuilt after any modification
+    m_store_transpose = true;
+}
+
+void CompressedRowSparseMatrix::compactStorage(bool singlePrecision)
+{
+    // columns are local, so compact indexes fit unless the matrix is extraordinarily wide
+    if(std::numeric_limits<uint32_t>::max() < m_num_columns)
+    {
+        return;
+    }
+    if(!m_compact_storage)
+    {
+        m_compact_storage = true;
+        m_compact_columns.assign(m_matrix_columns.begin(), m_matrix_columns.end());
+        std::vector<size_t>().swap(m_matrix_columns);
+    }
+    if(singlePrecision && !m_single_precision)
+    {
+        m_single_precision = true;
+        m_single_precision_data.assign(m_matrix_data.begin(), m_matrix_data.end());
+        std::vector<double>().swap(m_matrix_data);
+    }
+    internal_clear_transpose();
 }
 
 void CompressedRowSparseMatrix::internal_build_nonzero_sorted_rows_and_columns()
@@ -236,7 +466,12 @@ void CompressedRowSparseMatrix::internal_build_nonzero_sorted_rows_and_columns()
     }
 
     // prepare all columns
-    std::vector<size_t> columns(m_matrix_columns);
+    const size_t num_nonzeros = m_matrix_row_bounds[m_num_rows];
+    std::vector<size_t> columns(num_nonzeros);
+    for(size_t nz = 0; nz < num_nonzeros; nz++)
+    {
+        columns[nz] = internal_get_column(nz);
+    }
     std::sort(columns.begin(), columns.end());
 
     // build nonzero sorted columns by intentional push backs
@@ -256,18 +491,114 @@ void CompressedRowSparseMatrix::internal_build_nonzero_sorted_rows_and_columns()
 
     // invert the nonzero sorted columns
     size_t num_nonzero_columns = m_nonzero_sorted_columns.size();
+    m_full_column_to_reduced_column.assign(m_num_columns, num_nonzero_columns);
     for(size_t nz_columns = 0; nz_columns < num_nonzero_columns; nz_columns++)
     {
         m_full_column_to_reduced_column[m_nonzero_sorted_columns[nz_columns]] = nz_columns;
     }
 }
 
+void CompressedRowSparseMatrix::internal_build_transpose()
+{
+    if(m_transpose)
+    {
+        return;
+    }
+    m_transpose = transposeCompressedRowSparseMatrix(this);
+    if(m_compact_storage)
+    {
+        m_transpose->compactStorage(m_single_precision);
+    }
+}
+
+void CompressedRowSparseMatrix::internal_clear_transpose()
+{
+    safe_free(m_transpose);
+}
+
+double CompressedRowSparseMatrix::internal_row_product(size_t row, const std::vector<double>& input) const
+{
+    const size_t nz_begin = m_matrix_row_bounds[row];
+    const size_t nz_end = m_matrix_row_bounds[row + 1u];
+    if(!m_compact_storage)
+    {
+        return row_product(m_matrix_columns.data(), m_matrix_data.data(), nz_begin, nz_end, input.data());
+    }
+    if(m_single_precision)
+    {
+        return row_product(m_compact_columns.data(), m_single_precision_data.data(), nz_begin, nz_end, input.data());
+    }
+    return row_product(m_compact_columns.data(), m_matrix_data.data(), nz_begin, nz_end, input.data());
+}
+
+void CompressedRowSparseMatrix::internal_row_multi_product(size_t row,
+                                                           const std::vector<double>& input,
+                                                           size_t num_vectors,
+                                                           double* output) const
+{
+    const size_t nz_begin = m_matrix_row_bounds[row];
+    const size_t nz_end = m_matrix_row_bounds[row + 1u];
+    if(!m_compact_storage)
+    {
+        row_multi_product(m_matrix_columns.data(), m_matrix_data.data(), nz_begin, nz_end, input.data(), num_vectors, output);
+    }
+    else if(m_single_precision)
+    {
+        row_multi_product(m_compact_columns.data(), m_single_precision_data.data(), nz_begin, nz_end, input.data(), num_vectors, output);
+    }
+    else
+    {
+        row_multi_product(m_compact_columns.data(), m_matrix_data.data(), nz_begin, nz_end, input.data(), num_vectors, output);
+    }
+}
+
+bool CompressedRowSparseMatrix::internal_is_parallel_product() const
+{
+    return (s_min_nonzeros_for_parallel_product <= m_matrix_row_bounds[m_num_rows]);
+}
+
+size_t CompressedRowSparseMatrix::internal_get_column(size_t nz) const
+{
+    return (m_compact_storage ? size_t(m_compact_columns[nz]) : m_matrix_columns[nz]);
+}
+
+double CompressedRowSparseMatrix::internal_get_value(size_t nz) const
+{
+    return (m_single_precision ? double(m_single_precision_data[nz]) : m_matrix_data[nz]);
+}
+
+void CompressedRowSparseMatrix::internal_set_value(size_t nz, double value)
+{
+    if(m_single_precision)
+    {
+        m_single_precision_data[nz] = float(value);
+    }
+    else
+    {
+        m_matrix_data[nz] = value;
+    }
+}
+
 CompressedRowSparseMatrix* transposeCompressedRowSparseMatrix(CompressedRowSparseMatrix* input)
 {
     // input sizes
-    const size_t input_num_nonzeros = input->m_matrix_data.size();
     const size_t input_num_rows = input->getNumRows();
     const size_t input_num_columns = input->getNumColumns();
+    const size_t input_num_nonzeros = input->m_matrix_row_bounds[input_num_rows];
+
+    // input entries in double precision, whatever the storage
+    std::vector<size_t> input_columns;
+    std::vector<double> input_values;
+    input_columns.reserve(input_num_nonzeros);
+    input_values.reserve(input_num_nonzeros);
+    std::vector<size_t> row_columns;
+    std::vector<double> row_values;
+    for(size_t input_row = 0; input_row < input_num_rows; input_row++)
+    {
+        input->getRow(input_row, row_values, row_columns);
+        input_columns.insert(input_columns.end(), row_columns.begin(), row_columns.end());
+        input_values.insert(input_values.end(), row_values.begin(), row_values.end());
+    }
 
     // output allocation
     const size_t output_num_nonzeros = input_num_nonzeros;
@@ -281,7 +612,7 @@ CompressedRowSparseMatrix* transposeCompressedRowSparseMatrix(CompressedRowSpars
     std::vector<size_t> tmp_ouput_row_bounds(output_num_rows + 1, 0);
     for(size_t nz = 0; nz < input_num_nonzeros; nz++)
     {
-        tmp_ouput_row_bounds[1 + input->m_matrix_columns[nz]]++;
+        tmp_ouput_row_bounds[1 + input_columns[nz]]++;
     }
     cumulative_sum(tmp_ouput_row_bounds, output_row_bounds);
 
@@ -294,8 +625,8 @@ CompressedRowSparseMatrix* transposeCompressedRowSparseMatrix(CompressedRowSpars
 
         for(size_t nz = nz_begin; nz < nz_end; nz++)
         {
-            const size_t input_column = input->m_matrix_columns[nz];
-            const double input_data = input->m_matrix_data[nz];
+            const size_t input_column = input_columns[nz];
+            const double input_data = input_values[nz];
 
             const size_t nonzero_index = output_row_bounds[input_column] + tmp_ouput_row_bounds[input_column]++;
 
@@ -328,16 +659,27 @@ void sendCompressedRowSparseMatrix(AbstractInterface::MpiWrapper* mpi_wrapper, s
     matrix_sizes[0] = num_rows;
     const size_t num_columns = input->getNumColumns();
     matrix_sizes[1] = num_columns;
-    const size_t num_nonzeros = input->m_matrix_data.size();
+    const size_t num_nonzeros = input->m_matrix_row_bounds[num_rows];
     matrix_sizes[2] = num_nonzeros;
     mpi_wrapper->send(send_rank, matrix_sizes);
 
-    // send data
+    // send data, values in double precision whatever the storage
     std::vector<int> row_bounds(input->m_matrix_row_bounds.begin(), input->m_matrix_row_bounds.end());
     mpi_wrapper->send(send_rank, row_bounds);
-    std::vector<int> columns(input->m_matrix_columns.begin(), input->m_matrix_columns.end());
+    std::vector<int> columns;
+    std::vector<double> data;
+    columns.reserve(num_nonzeros);
+    data.reserve(num_nonzeros);
+    std::vector<size_t> row_columns;
+    std::vector<double> row_data;
+    for(size_t row = 0; row < num_rows; row++)
+    {
+        input->getRow(row, row_data, row_columns);
+        columns.insert(columns.end(), row_columns.begin(), row_columns.end());
+        data.insert(data.end(), row_data.begin(), row_data.end());
+    }
     mpi_wrapper->send(send_rank, columns);
-    mpi_wrapper->send(send_rank, input->m_matrix_data);
+    mpi_wrapper->send(send_rank, data);
 }
 
 CompressedRowSparseMatrix* receiveCompressedRowSparseMatrix(AbstractInterface::MpiWrapper* mpi_wrapper, size_t recv_rank)
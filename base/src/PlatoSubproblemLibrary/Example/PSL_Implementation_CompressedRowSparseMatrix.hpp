@@ -2,8 +2,8 @@
 #pragma once
 
 #include <vector>
-#include <map>
 #include <cstddef>
+#include <cstdint>
 #include "PSL_Abstract_SparseMatrix.hpp"
 
 namespace PlatoSubproblemLibrary
@@ -31,6 +31,14 @@ public:
 
     void matVec(const std::vector<double>& input, std::vector<double>& output, bool transpose = false) override;
     void matVecToReduced(const std::vector<double>& input, std::vector<double>& output, bool transpose = false) override;
+    void matMultiVec(const std::vector<double>& input,
+                     std::vector<double>& output,
+                     size_t num_vectors,
+                     bool transpose = false) override;
+    void matMultiVecToReduced(const std::vector<double>& input,
+                              std::vector<double>& output,
+                              size_t num_vectors,
+                              bool transpose = false) override;
 
     void rowNormalize(const std::vector<double>& rowNormalizationFactors) override;
     void columnNormalize(const std::vector<double>& columnNormalizationFactors) override;
@@ -43,12 +51,24 @@ public:
     void getRow(size_t row, std::vector<double>& data, std::vector<size_t>& columns) override;
     void setRow(size_t row, const std::vector<double>& data) override;
 
+    void storeTranspose() override;
+    void compactStorage(bool singlePrecision) override;
+
+    // compact storage empties the columns, and the data if single precision
     std::vector<size_t> m_matrix_row_bounds;
     std::vector<size_t> m_matrix_columns;
     std::vector<double> m_matrix_data;
 
 private:
     void internal_build_nonzero_sorted_rows_and_columns();
+    void internal_build_transpose();
+    void internal_clear_transpose();
+    double internal_row_product(size_t row, const std::vector<double>& input) const;
+    void internal_row_multi_product(size_t row, const std::vector<double>& input, size_t num_vectors, double* output) const;
+    bool internal_is_parallel_product() const;
+    size_t internal_get_column(size_t nz) const;
+    double internal_get_value(size_t nz) const;
+    void internal_set_value(size_t nz, double value);
 
     size_t m_num_rows;
     size_t m_num_columns;
@@ -56,7 +76,15 @@ private:
     bool m_built_nonzero_sorted_rows_and_columns;
     std::vector<size_t> m_nonzero_sorted_rows;
     std::vector<size_t> m_nonzero_sorted_columns;
-    std::map<size_t, size_t> m_full_column_to_reduced_column;
+    std::vector<size_t> m_full_column_to_reduced_column;
+
+    bool m_store_transpose;
+    CompressedRowSparseMatrix* m_transpose;
+
+    bool m_compact_storage;
+    bool m_single_precision;
+    std::vector<uint32_t> m_compact_columns;
+    std::vector<float> m_single_precision_data;
 
     CompressedRowSparseMatrix(const CompressedRowSparseMatrix &);
     CompressedRowSparseMatrix operator=(const CompressedRowSparseMatrix &);
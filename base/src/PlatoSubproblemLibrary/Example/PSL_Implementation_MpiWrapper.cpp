@@ -60,6 +60,56 @@ void receive(MPI_Comm& comm, size_t source_rank, std::vector<double>& receive_ve
     MPI_Recv(receive_vector.data(), size, MPI_DOUBLE, source_rank, 0, comm, &status);
 }
 
+// int MPI_Isend (void* message, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm, MPI_Request* request);
+void isend(MPI_Comm& comm, size_t target_rank, std::vector<int>& send_vector, MPI_Request& request)
+{
+    const size_t size = send_vector.size();
+    MPI_Isend(send_vector.data(), size, MPI_INT, target_rank, 0, comm, &request);
+}
+void isend(MPI_Comm& comm, size_t target_rank, std::vector<float>& send_vector, MPI_Request& request)
+{
+    const size_t size = send_vector.size();
+    MPI_Isend(send_vector.data(), size, MPI_FLOAT, target_rank, 0, comm, &request);
+}
+void isend(MPI_Comm& comm, size_t target_rank, std::vector<double>& send_vector, MPI_Request& request)
+{
+    const size_t size = send_vector.size();
+    MPI_Isend(send_vector.data(), size, MPI_DOUBLE, target_rank, 0, comm, &request);
+}
+
+// int MPI_Irecv (void* message, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Request* request);
+void ireceive(MPI_Comm& comm, size_t source_rank, std::vector<int>& receive_vector, MPI_Request& request)
+{
+    const size_t size = receive_vector.size();
+    MPI_Irecv(receive_vector.data(), size, MPI_INT, source_rank, 0, comm, &request);
+}
+void ireceive(MPI_Comm& comm, size_t source_rank, std::vector<float>& receive_vector, MPI_Request& request)
+{
+    const size_t size = receive_vector.size();
+    MPI_Irecv(receive_vector.data(), size, MPI_FLOAT, source_rank, 0, comm, &request);
+}
+void ireceive(MPI_Comm& comm, size_t source_rank, std::vector<double>& receive_vector, MPI_Request& request)
+{
+    const size_t size = receive_vector.size();
+    MPI_Irecv(receive_vector.data(), size, MPI_DOUBLE, source_rank, 0, comm, &request);
+}
+
+// int MPI_Waitall (int count, MPI_Request array_of_requests[], MPI_Status array_of_statuses[]);
+void wait_all(std::vector<MPI_Request>& requests)
+{
+    const size_t num_requests = requests.size();
+    MPI_Waitall(num_requests, requests.data(), MPI_STATUSES_IGNORE);
+    requests.clear();
+}
+
+//int MPI_Alltoall ( void *sendbuf, int sendcount, MPI_Datatype sendtype,
+//                   void *recvbuf, int recvcount, MPI_Datatype recvtype,
+//                   MPI_Comm comm );
+void all_to_all(MPI_Comm& comm, std::vector<int>& send_vector, std::vector<int>& recv_vector)
+{
+    MPI_Alltoall(send_vector.data(), 1, MPI_INT, recv_vector.data(), 1, MPI_INT, comm);
+}
+
 //int MPI_Allgather ( void *sendbuf, int sendcount, MPI_Datatype sendtype,
 //                    void *recvbuf, int recvcount, MPI_Datatype recvtype,
 //                    MPI_Comm comm );
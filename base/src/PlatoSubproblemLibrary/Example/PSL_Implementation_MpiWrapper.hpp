@@ -21,6 +21,17 @@ void receive(MPI_Comm& comm, size_t source_rank, std::vector<int>& receive_vecto
 void receive(MPI_Comm& comm, size_t source_rank, std::vector<float>& receive_vector);
 void receive(MPI_Comm& comm, size_t source_rank, std::vector<double>& receive_vector);
 
+void isend(MPI_Comm& comm, size_t target_rank, std::vector<int>& send_vector, MPI_Request& request);
+void isend(MPI_Comm& comm, size_t target_rank, std::vector<float>& send_vector, MPI_Request& request);
+void isend(MPI_Comm& comm, size_t target_rank, std::vector<double>& send_vector, MPI_Request& request);
+
+void ireceive(MPI_Comm& comm, size_t source_rank, std::vector<int>& receive_vector, MPI_Request& request);
+void ireceive(MPI_Comm& comm, size_t source_rank, std::vector<float>& receive_vector, MPI_Request& request);
+void ireceive(MPI_Comm& comm, size_t source_rank, std::vector<double>& receive_vector, MPI_Request& request);
+
+void wait_all(std::vector<MPI_Request>& requests);
+
+void all_to_all(MPI_Comm& comm, std::vector<int>& send_vector, std::vector<int>& recv_vector);
 void all_gather(MPI_Comm& comm, std::vector<int>& local_portion, std::vector<int>& global_portion);
 void all_gather(MPI_Comm& comm, std::vector<float>& local_portion, std::vector<float>& global_portion);
 void all_gather(MPI_Comm& comm, std::vector<double>& local_portion, std::vector<double>& global_portion);
@@ -0,0 +1,64 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_Interface_CholeskySolver.hpp"
+
+#include "PSL_Abstract_PositiveDefiniteLinearSolver.hpp"
+#include "PSL_Abstract_DenseMatrix.hpp"
+#include "PSL_Abstract_GlobalUtilities.hpp"
+#include "PSL_Interface_ContiguousDenseMatrix.hpp"
+
+#include <vector>
+#include <cstddef>
+
+namespace PlatoSubproblemLibrary
+{
+namespace example
+{
+
+Interface_CholeskySolver::Interface_CholeskySolver(AbstractInterface::GlobalUtilities* utilities) :
+        AbstractInterface::PositiveDefiniteLinearSolver(),
+        m_utilities(utilities)
+{
+}
+
+Interface_CholeskySolver::~Interface_CholeskySolver()
+{
+}
+
+// true if success
+bool Interface_CholeskySolver::solve(AbstractInterface::DenseMatrix* matrix, const std::vector<double>& rhs, std::vector<double>& sol)
+{
+    std::vector<std::vector<double> > rhs_wrapper(1u, rhs);
+    std::vector<std::vector<double> > sol_wrapper;
+    const bool success = solve_multiple(matrix, rhs_wrapper, sol_wrapper);
+    sol.swap(sol_wrapper[0]);
+    return success;
+}
+
+// true if success
+bool Interface_CholeskySolver::solve_multiple(AbstractInterface::DenseMatrix* matrix,
+                                              const std::vector<std::vector<double> >& rhs,
+                                              std::vector<std::vector<double> >& sol)
+{
+    const size_t num_rhs = rhs.size();
+    sol.resize(num_rhs);
+
+    // the factor is kept by a copy, so the input matrix is unchanged
+    Interface_ContiguousDenseMatrix factored(m_utilities, matrix->get_builder());
+    factored.copy(matrix);
+    if(!factored.factor_cholesky())
+    {
+        for(size_t r = 0u; r < num_rhs; r++)
+        {
+            sol[r].assign(rhs[r].size(), 0.);
+        }
+        return false;
+    }
+    for(size_t r = 0u; r < num_rhs; r++)
+    {
+        factored.solve_factored(rhs[r], sol[r]);
+    }
+    return true;
+}
+
+}
+}
@@ -0,0 +1,39 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+#include "PSL_Abstract_PositiveDefiniteLinearSolver.hpp"
+
+#include <vector>
+
+namespace PlatoSubproblemLibrary
+{
+namespace AbstractInterface
+{
+class GlobalUtilities;
+class DenseMatrix;
+}
+
+namespace example
+{
+
+// direct solves by a cholesky factorization of a contiguous copy of the matrix
+class Interface_CholeskySolver : public AbstractInterface::PositiveDefiniteLinearSolver
+{
+public:
+    Interface_CholeskySolver(AbstractInterface::GlobalUtilities* utilities);
+    ~Interface_CholeskySolver() override;
+
+    // true if success
+    bool solve(AbstractInterface::DenseMatrix* matrix, const std::vector<double>& rhs, std::vector<double>& sol) override;
+    // true if success; factors once for every right hand side
+    bool solve_multiple(AbstractInterface::DenseMatrix* matrix,
+                        const std::vector<std::vector<double> >& rhs,
+                        std::vector<std::vector<double> >& sol) override;
+
+protected:
+    AbstractInterface::GlobalUtilities* m_utilities;
+
+};
+
+}
+}
@@ -6,6 +6,11 @@
 #include "PSL_Abstract_GlobalUtilities.hpp"
 #include "PSL_Abstract_DenseVectorOperations.hpp"
 
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
 namespace PlatoSubproblemLibrary
 {
 namespace example
@@ -17,7 +22,12 @@ Interface_CojugateGradient::Interface_CojugateGradient(AbstractInterface::Global
         m_utilities(utilities),
         m_operations(operations),
         m_tolerance(1e-8),
-        m_verbosity(false)
+        m_verbosity(false),
+        m_preconditioner(preconditioner_t::no_preconditioner),
+        m_num_iterations(0u),
+        m_inverse_diagonal(),
+        m_cholesky_factor(),
+        m_factor_dimension(0u)
 {
 }
 
@@ -35,41 +45,111 @@ void Interface_CojugateGradient::setVerbosity(bool verbose_)
     m_verbosity = verbose_;
 }
 
+void Interface_CojugateGradient::setPreconditioner(preconditioner_t::preconditioner_t preconditioner_)
+{
+    m_preconditioner = preconditioner_;
+}
+
+size_t Interface_CojugateGradient::getNumIterations()
+{
+    return m_num_iterations;
+}
+
 // true if success
 bool Interface_CojugateGradient::solve(AbstractInterface::DenseMatrix* matrix, const std::vector<double>& rhs, std::vector<double>& sol)
+{
+    m_num_iterations = 0u;
+    internal_build_preconditioner(matrix);
+    sol.assign(rhs.size(), 0.);
+    return internal_solve(matrix, rhs, sol);
+}
+
+// true if success
+bool Interface_CojugateGradient::solve_multiple(AbstractInterface::DenseMatrix* matrix,
+                                                const std::vector<std::vector<double> >& rhs,
+                                                std::vector<std::vector<double> >& sol)
+{
+    m_num_iterations = 0u;
+    internal_build_preconditioner(matrix);
+    const size_t num_rhs = rhs.size();
+    sol.resize(num_rhs);
+    for(size_t r = 0u; r < num_rhs; r++)
+    {
+        sol[r].assign(rhs[r].size(), 0.);
+    }
+    if(num_rhs == 0u)
+    {
+        return true;
+    }
+    if(num_rhs == 1u)
+    {
+        return internal_solve(matrix, rhs[0], sol[0]);
+    }
+    if(internal_block_solve(matrix, rhs, sol))
+    {
+        return true;
+    }
+
+    // block broke down, finish each right hand side from the block iterate
+    bool success = true;
+    for(size_t r = 0u; r < num_rhs; r++)
+    {
+        success = internal_solve(matrix, rhs[r], sol[r]) && success;
+    }
+    return success;
+}
+
+bool Interface_CojugateGradient::internal_solve(AbstractInterface::DenseMatrix* matrix,
+                                                const std::vector<double>& rhs,
+                                                std::vector<double>& sol)
 {
     // initialize and allocate
     const size_t n = rhs.size();
-    sol.assign(n, 0.);
-
     std::vector<double> r(rhs);
-    std::vector<double> p(r);
     std::vector<double> Ap(n);
+    if(m_operations->dot(sol, sol) > 0.)
+    {
+        matrix->matvec(sol, Ap, false);
+        m_operations->axpy(-1., Ap, r);
+    }
+    std::vector<double> z;
+    internal_apply_preconditioner(r, z);
+    std::vector<double> p(z);
 
-    double r_dot = m_operations->dot(r, r);
-    double r_dot_next = -1.;
+    // residual and preconditioned residual products reduce together
+    std::vector<const std::vector<double>*> dot_left = {&r, &r};
+    std::vector<const std::vector<double>*> dot_right = {&r, &z};
+    std::vector<double> dots;
+    m_operations->fused_dot(dot_left, dot_right, dots);
+    if(dots[0] < m_tolerance)
+    {
+        return true;
+    }
+    double rz_dot = dots[1];
 
     // iteratively solve
     const size_t max_repetition = 10 * n;
     for(size_t repetition = 0u; repetition < max_repetition; repetition++)
     {
+        m_num_iterations++;
         matrix->matvec(p, Ap, false);
 
-        const double alpha = r_dot / m_operations->dot(p, Ap);
+        const double alpha = rz_dot / m_operations->dot(p, Ap);
 
         m_operations->axpy(alpha, p, sol);
         m_operations->axpy(-alpha, Ap, r);
 
-        r_dot_next = m_operations->dot(r, r);
-        if(r_dot_next < m_tolerance)
+        internal_apply_preconditioner(r, z);
+        m_operations->fused_dot(dot_left, dot_right, dots);
+        if(dots[0] < m_tolerance)
         {
             return true;
         }
 
-        m_operations->scale(r_dot_next / r_dot, p);
-        m_operations->axpy(1., r, p);
+        m_operations->scale(dots[1] / rz_dot, p);
+        m_operations->axpy(1., z, p);
 
-        r_dot = r_dot_next;
+        rz_dot = dots[1];
     }
 
     if(m_verbosity)
@@ -79,5 +159,277 @@ bool Interface_CojugateGradient::solve(AbstractInterface::DenseMatrix* matrix, c
     return false;
 }
 
+bool Interface_CojugateGradient::internal_block_solve(AbstractInterface::DenseMatrix* matrix,
+                                                      const std::vector<std::vector<double> >& rhs,
+                                                      std::vector<std::vector<double> >& sol)
+{
+    // initialize and allocate
+    const size_t s = rhs.size();
+    const size_t n = rhs[0].size();
+    std::vector<std::vector<double> > R(rhs);
+    std::vector<std::vector<double> > Z(s);
+    for(size_t j = 0u; j < s; j++)
+    {
+        internal_apply_preconditioner(R[j], Z[j]);
+    }
+    std::vector<std::vector<double> > P(Z);
+    std::vector<std::vector<double> > Q(s, std::vector<double>(n));
+
+    // every product of an iteration reduces together: residual norms and R'Z, or P'Q
+    std::vector<const std::vector<double>*> residual_left;
+    std::vector<const std::vector<double>*> residual_right;
+    std::vector<const std::vector<double>*> search_left;
+    std::vector<const std::vector<double>*> search_right;
+    for(size_t j = 0u; j < s; j++)
+    {
+        residual_left.push_back(&R[j]);
+        residual_right.push_back(&R[j]);
+    }
+    for(size_t k = 0u; k < s; k++)
+    {
+        for(size_t j = 0u; j < s; j++)
+        {
+            residual_left.push_back(&R[k]);
+            residual_right.push_back(&Z[j]);
+            search_left.push_back(&P[k]);
+            search_right.push_back(&Q[j]);
+        }
+    }
+    std::vector<double> residual_dots;
+    m_operations->fused_dot(residual_left, residual_right, residual_dots);
+    std::vector<double> RtZ(residual_dots.begin() + s, residual_dots.end());
+
+    // iteratively solve
+    std::vector<double> PtQ;
+    std::vector<double> alpha;
+    std::vector<double> beta;
+    std::vector<double> gram;
+    const size_t max_repetition = 10 * n;
+    for(size_t repetition = 0u; repetition < max_repetition; repetition++)
+    {
+        bool converged = true;
+        for(size_t j = 0u; j < s; j++)
+        {
+            converged = converged && (residual_dots[j] < m_tolerance);
+        }
+        if(converged)
+        {
+            return true;
+        }
+
+        m_num_iterations++;
+        for(size_t j = 0u; j < s; j++)
+        {
+            matrix->matvec(P[j], Q[j], false);
+        }
+        m_operations->fused_dot(search_left, search_right, PtQ);
+
+        // alpha = (P'Q)^-1 R'Z
+        alpha = RtZ;
+        gram = PtQ;
+        if(!internal_small_cholesky_solve(gram, s, alpha))
+        {
+            return false;
+        }
+        for(size_t j = 0u; j < s; j++)
+        {
+            for(size_t k = 0u; k < s; k++)
+            {
+                m_operations->axpy(alpha[k * s + j], P[k], sol[j]);
+                m_operations->axpy(-alpha[k * s + j], Q[k], R[j]);
+            }
+        }
+
+        for(size_t j = 0u; j < s; j++)
+        {
+            internal_apply_preconditioner(R[j], Z[j]);
+        }
+        m_operations->fused_dot(residual_left, residual_right, residual_dots);
+
+        // beta = (R'Z)^-1 R'Z next
+        beta.assign(residual_dots.begin() + s, residual_dots.end());
+        gram = RtZ;
+        if(!internal_small_cholesky_solve(gram, s, beta))
+        {
+            return false;
+        }
+        RtZ.assign(residual_dots.begin() + s, residual_dots.end());
+
+        // P = Z + P beta
+        const std::vector<std::vector<double> > P_previous(P);
+        for(size_t j = 0u; j < s; j++)
+        {
+            P[j] = Z[j];
+            for(size_t k = 0u; k < s; k++)
+            {
+                m_operations->axpy(beta[k * s + j], P_previous[k], P[j]);
+            }
+        }
+    }
+    return false;
+}
+
+void Interface_CojugateGradient::internal_build_preconditioner(AbstractInterface::DenseMatrix* matrix)
+{
+    m_inverse_diagonal.clear();
+    m_cholesky_factor.clear();
+    m_factor_dimension = 0u;
+    if(m_preconditioner == preconditioner_t::no_preconditioner)
+    {
+        return;
+    }
+
+    const size_t n = matrix->get_num_rows();
+    if(m_preconditioner == preconditioner_t::incomplete_cholesky_preconditioner)
+    {
+        // zero fill: factor entries only where the lower triangle is nonzero
+        std::vector<double> factor(n * n, 0.);
+        bool factored = true;
+        for(size_t row = 0u; row < n && factored; row++)
+        {
+            for(size_t column = 0u; column <= row; column++)
+            {
+                const double value = matrix->get_value(row, column);
+                if(value == 0.)
+                {
+                    continue;
+                }
+                double sum = value;
+                for(size_t k = 0u; k < column; k++)
+                {
+                    sum -= factor[row * n + k] * factor[column * n + k];
+                }
+                if(row == column)
+                {
+                    if(!(sum > 0.))
+                    {
+                        factored = false;
+                        break;
+                    }
+                    factor[row * n + row] = std::sqrt(sum);
+                }
+                else
+                {
+                    factor[row * n + column] = sum / factor[column * n + column];
+                }
+            }
+            factored = factored && (factor[row * n + row] > 0.);
+        }
+        if(factored)
+        {
+            m_cholesky_factor.swap(factor);
+            m_factor_dimension = n;
+            return;
+        }
+        if(m_verbosity)
+        {
+            m_utilities->print("PlatoSubproblemLibrary: warning incomplete cholesky broke down, preconditioning by jacobi.\n");
+        }
+    }
+
+    // jacobi, identity where the diagonal is not positive
+    std::vector<double> diagonal;
+    matrix->get_diagonal(diagonal);
+    m_inverse_diagonal.resize(n);
+    for(size_t row = 0u; row < n; row++)
+    {
+        m_inverse_diagonal[row] = (diagonal[row] > 0. ? 1. / diagonal[row] : 1.);
+    }
+}
+
+void Interface_CojugateGradient::internal_apply_preconditioner(const std::vector<double>& r, std::vector<double>& z)
+{
+    if(!m_inverse_diagonal.empty())
+    {
+        m_operations->multiply(m_inverse_diagonal, r, z);
+        return;
+    }
+    z = r;
+    if(m_cholesky_factor.empty())
+    {
+        return;
+    }
+
+    // solve L L' z = r
+    const size_t n = m_factor_dimension;
+    for(size_t row = 0u; row < n; row++)
+    {
+        double sum = z[row];
+        for(size_t k = 0u; k < row; k++)
+        {
+            sum -= m_cholesky_factor[row * n + k] * z[k];
+        }
+        z[row] = sum / m_cholesky_factor[row * n + row];
+    }
+    for(size_t row = n; row > 0u; row--)
+    {
+        const size_t r_index = row - 1u;
+        double sum = z[r_index];
+        for(size_t k = row; k < n; k++)
+        {
+            sum -= m_cholesky_factor[k * n + r_index] * z[k];
+        }
+        z[r_index] = sum / m_cholesky_factor[r_index * n + r_index];
+    }
+}
+
+bool Interface_CojugateGradient::internal_small_cholesky_solve(std::vector<double>& gram, size_t dimension, std::vector<double>& rhs)
+{
+    // rhs holds dimension columns, row major; pivots relative to the diagonal detect rank loss
+    const size_t s = dimension;
+    double max_diagonal = 0.;
+    for(size_t i = 0u; i < s; i++)
+    {
+        max_diagonal = std::max(max_diagonal, std::fabs(gram[i * s + i]));
+    }
+    const double pivot_threshold = 1e-14 * max_diagonal;
+    for(size_t row = 0u; row < s; row++)
+    {
+        for(size_t column = 0u; column <= row; column++)
+        {
+            double sum = 0.5 * (gram[row * s + column] + gram[column * s + row]);
+            for(size_t k = 0u; k < column; k++)
+            {
+                sum -= gram[row * s + k] * gram[column * s + k];
+            }
+            if(row == column)
+            {
+                if(!(sum > pivot_threshold))
+                {
+                    return false;
+                }
+                gram[row * s + row] = std::sqrt(sum);
+            }
+            else
+            {
+                gram[row * s + column] = sum / gram[column * s + column];
+            }
+        }
+    }
+    for(size_t j = 0u; j < s; j++)
+    {
+        for(size_t row = 0u; row < s; row++)
+        {
+            double sum = rhs[row * s + j];
+            for(size_t k = 0u; k < row; k++)
+            {
+                sum -= gram[row * s + k] * rhs[k * s + j];
+            }
+            rhs[row * s + j] = sum / gram[row * s + row];
+        }
+        for(size_t row = s; row > 0u; row--)
+        {
+            const size_t r_index = row - 1u;
+            double sum = rhs[r_index * s + j];
+            for(size_t k = row; k < s; k++)
+            {
+                sum -= gram[k * s + r_index] * rhs[k * s + j];
+            }
+            rhs[r_index * s + j] = sum / gram[r_index * s + r_index];
+        }
+    }
+    return true;
+}
+
 }
 }
@@ -2,6 +2,10 @@
 #pragma once
 
 #include "PSL_Abstract_PositiveDefiniteLinearSolver.hpp"
+#include "PSL_ParameterDataEnums.hpp"
+
+#include <vector>
+#include <cstddef>
 
 namespace PlatoSubproblemLibrary
 {
@@ -24,15 +28,40 @@ public:
 
     void setTolerance(double tolerance_);
     void setVerbosity(bool verbose_);
+    void setPreconditioner(preconditioner_t::preconditioner_t preconditioner_);
+    // iterations of the last solve
+    size_t getNumIterations();
 
     // true if success
     bool solve(AbstractInterface::DenseMatrix* matrix, const std::vector<double>& rhs, std::vector<double>& sol) override;
+    // true if success; block conjugate gradient, falling back to warm started single solves if the block breaks down
+    bool solve_multiple(AbstractInterface::DenseMatrix* matrix,
+                        const std::vector<std::vector<double> >& rhs,
+                        std::vector<std::vector<double> >& sol) override;
 
 protected:
+    // sol is the initial guess
+    bool internal_solve(AbstractInterface::DenseMatrix* matrix, const std::vector<double>& rhs, std::vector<double>& sol);
+    bool internal_block_solve(AbstractInterface::DenseMatrix* matrix,
+                              const std::vector<std::vector<double> >& rhs,
+                              std::vector<std::vector<double> >& sol);
+
+    void internal_build_preconditioner(AbstractInterface::DenseMatrix* matrix);
+    void internal_apply_preconditioner(const std::vector<double>& r, std::vector<double>& z);
+    // overwrites gram with its factor and rhs with the solution, false if not numerically positive definite
+    bool internal_small_cholesky_solve(std::vector<double>& gram, size_t dimension, std::vector<double>& rhs);
+
     AbstractInterface::GlobalUtilities* m_utilities;
     AbstractInterface::DenseVectorOperations* m_operations;
     double m_tolerance;
     bool m_verbosity;
+    preconditioner_t::preconditioner_t m_preconditioner;
+    size_t m_num_iterations;
+
+    // inverse diagonal if jacobi, row major lower factor if incomplete cholesky
+    std::vector<double> m_inverse_diagonal;
+    std::vector<double> m_cholesky_factor;
+    size_t m_factor_dimension;
 
 };
 
@@ -0,0 +1,487 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_Interface_ContiguousDenseMatrix.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#include "PSL_Abstract_DenseMatrix.hpp"
+#include "PSL_Abstract_GlobalUtilities.hpp"
+#include "PSL_Abstract_DenseMatrixBuilder.hpp"
+
+namespace PlatoSubproblemLibrary
+{
+namespace example
+{
+
+// tiles of the product: a block of result rows per thread, an inner by column tile of the right operand kept in cache
+static const size_t s_product_block_rows = 64u;
+static const size_t s_product_block_inner = 128u;
+static const size_t s_product_block_columns = 512u;
+// below this many multiplies, products are not worth distributing over threads
+static const size_t s_min_multiplies_for_parallel_product = 262144u;
+
+// result = alpha * A * B, with A num_rows by num_inner and B num_inner by num_columns, all row major
+static void blocked_product(const double alpha,
+                            const double* A,
+                            const double* B,
+                            size_t num_rows,
+                            size_t num_inner,
+                            size_t num_columns,
+                            double* result)
+{
+    std::fill(result, result + num_rows * num_columns, 0.);
+    const size_t num_row_blocks = (num_rows + s_product_block_rows - 1u) / s_product_block_rows;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(s_min_multiplies_for_parallel_product <= num_rows * num_inner * num_columns)
+#endif
+    for(size_t row_block = 0; row_block < num_row_blocks; row_block++)
+    {
+        const size_t row_begin = row_block * s_product_block_rows;
+        const size_t row_end = std::min(row_begin + s_product_block_rows, num_rows);
+        for(size_t column_begin = 0; column_begin < num_columns; column_begin += s_product_block_columns)
+        {
+            const size_t column_end = std::min(column_begin + s_product_block_columns, num_columns);
+            for(size_t inner_begin = 0; inner_begin < num_inner; inner_begin += s_product_block_inner)
+            {
+                const size_t inner_end = std::min(inner_begin + s_product_block_inner, num_inner);
+                for(size_t row = row_begin; row < row_end; row++)
+                {
+                    double* result_row = result + row * num_columns;
+                    for(size_t inner = inner_begin; inner < inner_end; inner++)
+                    {
+                        const double a = alpha * A[row * num_inner + inner];
+                        const double* B_row = B + inner * num_columns;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                        for(size_t column = column_begin; column < column_end; column++)
+                        {
+                            result_row[column] += a * B_row[column];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+static double contiguous_dot(const double* x, const double* y, size_t length)
+{
+    double result = 0.;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:result)
+#endif
+    for(size_t i = 0; i < length; i++)
+    {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+static void contiguous_axpy(const double alpha, const double* x, double* y, size_t length)
+{
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for(size_t i = 0; i < length; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+Interface_ContiguousDenseMatrix::Interface_ContiguousDenseMatrix(AbstractInterface::GlobalUtilities* utilities,
+                                                                 AbstractInterface::DenseMatrixBuilder* builder) :
+        AbstractInterface::DenseMatrix(utilities, builder),
+        m_data(),
+        m_num_rows(0u),
+        m_num_columns(0u),
+        m_factor(),
+        m_pivots(),
+        m_is_cholesky_factor(false)
+{
+}
+
+Interface_ContiguousDenseMatrix::~Interface_ContiguousDenseMatrix()
+{
+}
+
+void Interface_ContiguousDenseMatrix::receive(std::vector<double>& row_major_data, size_t num_rows, size_t num_columns)
+{
+    assert(row_major_data.size() == num_rows * num_columns);
+    m_data.swap(row_major_data);
+    m_num_rows = num_rows;
+    m_num_columns = num_columns;
+}
+
+size_t Interface_ContiguousDenseMatrix::get_num_rows()
+{
+    return m_num_rows;
+}
+
+size_t Interface_ContiguousDenseMatrix::get_num_columns()
+{
+    return m_num_columns;
+}
+
+double Interface_ContiguousDenseMatrix::get_value(size_t row, size_t column)
+{
+    assert(row < m_num_rows);
+    assert(column < m_num_columns);
+    return m_data[row * m_num_columns + column];
+}
+
+void Interface_ContiguousDenseMatrix::set_value(size_t row, size_t column, double value)
+{
+    assert(row < m_num_rows);
+    assert(column < m_num_columns);
+    m_data[row * m_num_columns + column] = value;
+}
+
+void Interface_ContiguousDenseMatrix::matvec(const std::vector<double>& in, std::vector<double>& out, bool transpose)
+{
+    if(transpose)
+    {
+        assert(in.size() == m_num_rows);
+        out.assign(m_num_columns, 0.);
+        for(size_t row = 0u; row < m_num_rows; row++)
+        {
+            contiguous_axpy(in[row], &m_data[row * m_num_columns], out.data(), m_num_columns);
+        }
+    }
+    else
+    {
+        assert(in.size() == m_num_columns);
+        out.resize(m_num_rows);
+        for(size_t row = 0u; row < m_num_rows; row++)
+        {
+            out[row] = contiguous_dot(&m_data[row * m_num_columns], in.data(), m_num_columns);
+        }
+    }
+}
+
+void Interface_ContiguousDenseMatrix::fill(double alpha)
+{
+    std::fill(m_data.begin(), m_data.end(), alpha);
+}
+
+void Interface_ContiguousDenseMatrix::fill_by_row_major(const std::vector<double>& in)
+{
+    assert(in.size() >= m_num_rows * m_num_columns);
+    std::copy(in.begin(), in.begin() + m_num_rows * m_num_columns, m_data.begin());
+}
+
+void Interface_ContiguousDenseMatrix::set_to_identity()
+{
+    fill(0.);
+    const size_t min_size = std::min(m_num_rows, m_num_columns);
+    for(size_t i = 0u; i < min_size; i++)
+    {
+        m_data[i * m_num_columns + i] = 1.;
+    }
+}
+
+void Interface_ContiguousDenseMatrix::copy(AbstractInterface::DenseMatrix* source)
+{
+    if(source == this)
+    {
+        return;
+    }
+    m_num_rows = source->get_num_rows();
+    m_num_columns = source->get_num_columns();
+    internal_pack(source, false, m_data);
+}
+
+void Interface_ContiguousDenseMatrix::aXpY(double alpha, AbstractInterface::DenseMatrix* X)
+{
+    assert(X->get_num_rows() == m_num_rows);
+    assert(X->get_num_columns() == m_num_columns);
+    Interface_ContiguousDenseMatrix* X_casted = dynamic_cast<Interface_ContiguousDenseMatrix*>(X);
+    if(X_casted)
+    {
+        contiguous_axpy(alpha, X_casted->get_data(), m_data.data(), m_data.size());
+        return;
+    }
+    for(size_t row = 0u; row < m_num_rows; row++)
+    {
+        for(size_t column = 0u; column < m_num_columns; column++)
+        {
+            m_data[row * m_num_columns + column] += alpha * X->get_value(row, column);
+        }
+    }
+}
+
+void Interface_ContiguousDenseMatrix::matrix_matrix_product(double alpha,
+                                                            AbstractInterface::DenseMatrix* X,
+                                                            bool X_transpose,
+                                                            AbstractInterface::DenseMatrix* Y,
+                                                            bool Y_transpose)
+{
+    // transposes are packed once, so every product is row major times row major; packing also allows X or Y to be this
+    const size_t num_rows = (X_transpose ? X->get_num_columns() : X->get_num_rows());
+    const size_t num_inner = (X_transpose ? X->get_num_rows() : X->get_num_columns());
+    const size_t num_columns = (Y_transpose ? Y->get_num_rows() : Y->get_num_columns());
+    if(num_inner != (Y_transpose ? Y->get_num_columns() : Y->get_num_rows()))
+    {
+        m_utilities->fatal_error("Interface_ContiguousDenseMatrix: product dimensions do not agree. Aborting.\n\n");
+    }
+    std::vector<double> packed_X;
+    std::vector<double> packed_Y;
+    internal_pack(X, X_transpose, packed_X);
+    internal_pack(Y, Y_transpose, packed_Y);
+
+    m_num_rows = num_rows;
+    m_num_columns = num_columns;
+    m_data.resize(num_rows * num_columns);
+    blocked_product(alpha, packed_X.data(), packed_Y.data(), num_rows, num_inner, num_columns, m_data.data());
+}
+
+void Interface_ContiguousDenseMatrix::scale(double alpha)
+{
+    const size_t length = m_data.size();
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for(size_t i = 0; i < length; i++)
+    {
+        m_data[i] *= alpha;
+    }
+}
+
+double Interface_ContiguousDenseMatrix::dot(AbstractInterface::DenseMatrix* other)
+{
+    // element-wise dot product as if matrix was interpreted as vector
+    assert(other->get_num_rows() == m_num_rows);
+    assert(other->get_num_columns() == m_num_columns);
+    Interface_ContiguousDenseMatrix* other_casted = dynamic_cast<Interface_ContiguousDenseMatrix*>(other);
+    if(other_casted)
+    {
+        return contiguous_dot(m_data.data(), other_casted->get_data(), m_data.size());
+    }
+    double result = 0.;
+    for(size_t row = 0u; row < m_num_rows; row++)
+    {
+        for(size_t column = 0u; column < m_num_columns; column++)
+        {
+            result += m_data[row * m_num_columns + column] * other->get_value(row, column);
+        }
+    }
+    return result;
+}
+
+void Interface_ContiguousDenseMatrix::get_row(const int& row_index, std::vector<double>& row)
+{
+    row.assign(m_data.begin() + row_index * m_num_columns, m_data.begin() + (row_index + 1) * m_num_columns);
+}
+
+void Interface_ContiguousDenseMatrix::get_column(const int& column_index, std::vector<double>& column)
+{
+    column.resize(m_num_rows);
+    for(size_t row = 0u; row < m_num_rows; row++)
+    {
+        column[row] = m_data[row * m_num_columns + column_index];
+    }
+}
+
+void Interface_ContiguousDenseMatrix::get_diagonal(std::vector<double>& diagonal)
+{
+    const size_t min_size = std::min(m_num_rows, m_num_columns);
+    diagonal.resize(min_size);
+    for(size_t i = 0u; i < min_size; i++)
+    {
+        diagonal[i] = m_data[i * m_num_columns + i];
+    }
+}
+
+void Interface_ContiguousDenseMatrix::permute_columns(const std::vector<int>& permutation)
+{
+    assert(permutation.size() == m_num_columns);
+    std::vector<double> this_row;
+    for(size_t row = 0u; row < m_num_rows; row++)
+    {
+        get_row(row, this_row);
+        for(size_t column = 0u; column < m_num_columns; column++)
+        {
+            assert(0 <= permutation[column]);
+            assert(permutation[column] < int(m_num_columns));
+            m_data[row * m_num_columns + column] = this_row[permutation[column]];
+        }
+    }
+}
+
+void Interface_ContiguousDenseMatrix::scale_column(const int& column_index, const double& scale)
+{
+    for(size_t row = 0u; row < m_num_rows; row++)
+    {
+        m_data[row * m_num_columns + column_index] *= scale;
+    }
+}
+
+bool Interface_ContiguousDenseMatrix::factor_cholesky()
+{
+    if(m_num_rows != m_num_columns)
+    {
+        return false;
+    }
+
+    // rows of the lower factor are contiguous, so every entry is a contiguous dot of two factor rows
+    const size_t n = m_num_rows;
+    std::vector<double> factor(n * n, 0.);
+    for(size_t row = 0u; row < n; row++)
+    {
+        double* factor_row = &factor[row * n];
+        for(size_t column = 0u; column < row; column++)
+        {
+            const double* factor_column_row = &factor[column * n];
+            const double sum = m_data[row * n + column] - contiguous_dot(factor_row, factor_column_row, column);
+            factor_row[column] = sum / factor_column_row[column];
+        }
+        const double pivot = m_data[row * n + row] - contiguous_dot(factor_row, factor_row, row);
+        if(!(pivot > 0.))
+        {
+            return false;
+        }
+        factor_row[row] = std::sqrt(pivot);
+    }
+
+    m_factor.swap(factor);
+    m_pivots.clear();
+    m_is_cholesky_factor = true;
+    return true;
+}
+
+bool Interface_ContiguousDenseMatrix::factor_lu()
+{
+    if(m_num_rows != m_num_columns)
+    {
+        return false;
+    }
+
+    // partial pivoting, eliminating by contiguous row updates
+    const size_t n = m_num_rows;
+    std::vector<double> factor(m_data);
+    std::vector<size_t> pivots(n);
+    for(size_t column = 0u; column < n; column++)
+    {
+        size_t pivot_row = column;
+        for(size_t row = column + 1u; row < n; row++)
+        {
+            if(std::fabs(factor[row * n + column]) > std::fabs(factor[pivot_row * n + column]))
+            {
+                pivot_row = row;
+            }
+        }
+        pivots[column] = pivot_row;
+        if(factor[pivot_row * n + column] == 0.)
+        {
+            return false;
+        }
+        if(pivot_row != column)
+        {
+            std::swap_ranges(factor.begin() + column * n, factor.begin() + (column + 1u) * n, factor.begin() + pivot_row * n);
+        }
+
+        const double* pivot_row_data = &factor[column * n];
+        for(size_t row = column + 1u; row < n; row++)
+        {
+            double* row_data = &factor[row * n];
+            const double multiplier = row_data[column] / pivot_row_data[column];
+            row_data[column] = multiplier;
+            contiguous_axpy(-multiplier, pivot_row_data + column + 1u, row_data + column + 1u, n - column - 1u);
+        }
+    }
+
+    m_factor.swap(factor);
+    m_pivots.swap(pivots);
+    m_is_cholesky_factor = false;
+    return true;
+}
+
+void Interface_ContiguousDenseMatrix::solve_factored(const std::vector<double>& rhs, std::vector<double>& sol)
+{
+    const size_t n = m_num_rows;
+    if(m_factor.size() != n * n)
+    {
+        m_utilities->fatal_error("Interface_ContiguousDenseMatrix: solve requested without a factorization. Aborting.\n\n");
+    }
+    sol = rhs;
+
+    if(m_is_cholesky_factor)
+    {
+        // L y = b, then L' x = y
+        for(size_t row = 0u; row < n; row++)
+        {
+            sol[row] = (sol[row] - contiguous_dot(&m_factor[row * n], sol.data(), row)) / m_factor[row * n + row];
+        }
+        for(size_t row = n; row > 0u; row--)
+        {
+            const size_t r = row - 1u;
+            sol[r] /= m_factor[r * n + r];
+            contiguous_axpy(-sol[r], &m_factor[r * n], sol.data(), r);
+        }
+        return;
+    }
+
+    // P b, then L y = P b, then U x = y
+    for(size_t row = 0u; row < n; row++)
+    {
+        std::swap(sol[row], sol[m_pivots[row]]);
+    }
+    for(size_t row = 0u; row < n; row++)
+    {
+        sol[row] -= contiguous_dot(&m_factor[row * n], sol.data(), row);
+    }
+    for(size_t row = n; row > 0u; row--)
+    {
+        const size_t r = row - 1u;
+        const size_t num_upper = n - row;
+        sol[r] = (sol[r] - contiguous_dot(&m_factor[r * n + row], &sol[row], num_upper)) / m_factor[r * n + r];
+    }
+}
+
+const double* Interface_ContiguousDenseMatrix::get_data() const
+{
+    return m_data.data();
+}
+
+void Interface_ContiguousDenseMatrix::internal_pack(AbstractInterface::DenseMatrix* matrix, bool transpose, std::vector<double>& packed)
+{
+    const size_t num_rows = matrix->get_num_rows();
+    const size_t num_columns = matrix->get_num_columns();
+    Interface_ContiguousDenseMatrix* matrix_casted = dynamic_cast<Interface_ContiguousDenseMatrix*>(matrix);
+    if(matrix_casted && !transpose)
+    {
+        packed.assign(matrix_casted->get_data(), matrix_casted->get_data() + num_rows * num_columns);
+        return;
+    }
+
+    std::vector<double> row_values;
+    packed.resize(num_rows * num_columns);
+    for(size_t row = 0u; row < num_rows; row++)
+    {
+        if(matrix_casted)
+        {
+            row_values.assign(matrix_casted->get_data() + row * num_columns, matrix_casted->get_data() + (row + 1u) * num_columns);
+        }
+        else
+        {
+            matrix->get_row(row, row_values);
+        }
+        for(size_t column = 0u; column < num_columns; column++)
+        {
+            if(transpose)
+            {
+                packed[column * num_rows + row] = row_values[column];
+            }
+            else
+            {
+                packed[row * num_columns + column] = row_values[column];
+            }
+        }
+    }
+}
+
+}
+}
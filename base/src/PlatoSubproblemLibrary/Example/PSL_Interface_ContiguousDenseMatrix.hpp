@@ -0,0 +1,75 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "PSL_Abstract_DenseMatrix.hpp"
+
+namespace PlatoSubproblemLibrary
+{
+namespace AbstractInterface
+{
+class GlobalUtilities;
+class DenseMatrixBuilder;
+}
+
+namespace example
+{
+
+// row major in one allocation, so products and factorizations run over contiguous, cache blocked rows
+class Interface_ContiguousDenseMatrix : public AbstractInterface::DenseMatrix
+{
+public:
+    Interface_ContiguousDenseMatrix(AbstractInterface::GlobalUtilities* global,
+                                    AbstractInterface::DenseMatrixBuilder* builder);
+    ~Interface_ContiguousDenseMatrix() override;
+
+    void receive(std::vector<double>& row_major_data, size_t num_rows, size_t num_columns);
+
+    size_t get_num_rows() override;
+    size_t get_num_columns() override;
+    double get_value(size_t row, size_t column) override;
+    void set_value(size_t row, size_t column, double value) override;
+
+    void matvec(const std::vector<double>& in, std::vector<double>& out, bool transpose) override;
+    void fill(double alpha) override;
+    void fill_by_row_major(const std::vector<double>& in) override;
+    void set_to_identity() override;
+    void copy(AbstractInterface::DenseMatrix* source) override;
+    void aXpY(double alpha, AbstractInterface::DenseMatrix* X) override;
+    void matrix_matrix_product(double alpha,
+                               AbstractInterface::DenseMatrix* X, bool X_transpose,
+                               AbstractInterface::DenseMatrix* Y, bool Y_transpose) override;
+    void scale(double alpha) override;
+    double dot(AbstractInterface::DenseMatrix* other) override;
+    void get_row(const int& row_index, std::vector<double>& row) override;
+    void get_column(const int& column_index, std::vector<double>& column) override;
+    void get_diagonal(std::vector<double>& diagonal) override;
+    void permute_columns(const std::vector<int>& permutation) override;
+    void scale_column(const int& column_index, const double& scale) override;
+
+    // factor current values, false if not positive definite or singular; later changes to values are not seen by the factor
+    bool factor_cholesky();
+    bool factor_lu();
+    // solve with the last successful factorization
+    void solve_factored(const std::vector<double>& rhs, std::vector<double>& sol);
+
+    const double* get_data() const;
+
+protected:
+    // row major copy of this, or its transpose
+    void internal_pack(AbstractInterface::DenseMatrix* matrix, bool transpose, std::vector<double>& packed);
+
+    std::vector<double> m_data;
+    size_t m_num_rows;
+    size_t m_num_columns;
+
+    // lower factor if cholesky, unit lower and upper factors with row pivots if lu
+    std::vector<double> m_factor;
+    std::vector<size_t> m_pivots;
+    bool m_is_cholesky_factor;
+};
+
+}
+}
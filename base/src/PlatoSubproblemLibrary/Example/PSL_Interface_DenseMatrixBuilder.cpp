@@ -6,6 +6,7 @@
 #include "PSL_Abstract_DenseMatrix.hpp"
 #include "PSL_Implementation_DenseMatrix.hpp"
 #include "PSL_Interface_DenseMatrix.hpp"
+#include "PSL_Interface_ContiguousDenseMatrix.hpp"
 #include "PSL_Interface_BasicGlobalUtilities.hpp"
 
 namespace PlatoSubproblemLibrary
@@ -14,7 +15,8 @@ namespace example
 {
 
 Interface_DenseMatrixBuilder::Interface_DenseMatrixBuilder(AbstractInterface::GlobalUtilities* utilities) :
-        AbstractInterface::DenseMatrixBuilder(utilities)
+        AbstractInterface::DenseMatrixBuilder(utilities),
+        m_contiguous_storage(false)
 {
 }
 
@@ -22,10 +24,23 @@ Interface_DenseMatrixBuilder::~Interface_DenseMatrixBuilder()
 {
 }
 
+void Interface_DenseMatrixBuilder::set_contiguous_storage(bool contiguous_storage)
+{
+    m_contiguous_storage = contiguous_storage;
+}
+
 AbstractInterface::DenseMatrix* Interface_DenseMatrixBuilder::build_by_row_major(size_t num_rows,
                                                                                  size_t num_columns,
                                                                                  const std::vector<double>& in)
 {
+    if(m_contiguous_storage)
+    {
+        std::vector<double> data(in.begin(), in.begin() + num_rows * num_columns);
+        Interface_ContiguousDenseMatrix* result = new Interface_ContiguousDenseMatrix(m_utilities, this);
+        result->receive(data, num_rows, num_columns);
+        return result;
+    }
+
     // build
     double** data = dense_matrix::create(num_rows, num_columns);
     dense_matrix::fill_by_row_major(in.data(), data, num_rows, num_columns);
@@ -23,8 +23,12 @@ public:
     Interface_DenseMatrixBuilder(AbstractInterface::GlobalUtilities* utilities);
     ~Interface_DenseMatrixBuilder() override;
 
+    // if true, builds contiguous matrices with cache blocked products and factorizations
+    void set_contiguous_storage(bool contiguous_storage);
+
     AbstractInterface::DenseMatrix* build_by_row_major(size_t num_rows, size_t num_columns, const std::vector<double>& in) override;
 protected:
+    bool m_contiguous_storage;
 };
 
 }
@@ -20,7 +20,8 @@ namespace example
 
 Interface_MpiWrapper::Interface_MpiWrapper(AbstractInterface::GlobalUtilities* utilities, MPI_Comm* comm) :
         AbstractInterface::MpiWrapper(utilities),
-        m_comm(comm)
+        m_comm(comm),
+        m_pending_requests()
 {
 }
 Interface_MpiWrapper::~Interface_MpiWrapper()
@@ -97,6 +98,48 @@ void Interface_MpiWrapper::receive(size_t source_rank, std::vector<double>& send
     example::receive(*m_comm, source_rank, send_vector);
 }
 
+void Interface_MpiWrapper::isend(size_t target_rank, std::vector<int>& send_vector)
+{
+    m_pending_requests.push_back(MPI_REQUEST_NULL);
+    example::isend(*m_comm, target_rank, send_vector, m_pending_requests.back());
+}
+void Interface_MpiWrapper::isend(size_t target_rank, std::vector<float>& send_vector)
+{
+    m_pending_requests.push_back(MPI_REQUEST_NULL);
+    example::isend(*m_comm, target_rank, send_vector, m_pending_requests.back());
+}
+void Interface_MpiWrapper::isend(size_t target_rank, std::vector<double>& send_vector)
+{
+    m_pending_requests.push_back(MPI_REQUEST_NULL);
+    example::isend(*m_comm, target_rank, send_vector, m_pending_requests.back());
+}
+
+void Interface_MpiWrapper::ireceive(size_t source_rank, std::vector<int>& recv_vector)
+{
+    m_pending_requests.push_back(MPI_REQUEST_NULL);
+    example::ireceive(*m_comm, source_rank, recv_vector, m_pending_requests.back());
+}
+void Interface_MpiWrapper::ireceive(size_t source_rank, std::vector<float>& recv_vector)
+{
+    m_pending_requests.push_back(MPI_REQUEST_NULL);
+    example::ireceive(*m_comm, source_rank, recv_vector, m_pending_requests.back());
+}
+void Interface_MpiWrapper::ireceive(size_t source_rank, std::vector<double>& recv_vector)
+{
+    m_pending_requests.push_back(MPI_REQUEST_NULL);
+    example::ireceive(*m_comm, source_rank, recv_vector, m_pending_requests.back());
+}
+
+void Interface_MpiWrapper::wait_all()
+{
+    example::wait_all(m_pending_requests);
+}
+
+void Interface_MpiWrapper::all_to_all(std::vector<int>& send_vector, std::vector<int>& recv_vector)
+{
+    example::all_to_all(*m_comm, send_vector, recv_vector);
+}
+
 void Interface_MpiWrapper::all_gather(std::vector<int>& local_portion, std::vector<int>& global_portion)
 {
     example::all_gather(*m_comm, local_portion, global_portion);
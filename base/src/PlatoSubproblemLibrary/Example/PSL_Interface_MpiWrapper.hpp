@@ -35,6 +35,16 @@ public:
     void receive(size_t source_rank, std::vector<float>& send_vector) override;
     void receive(size_t source_rank, std::vector<double>& send_vector) override;
 
+    void isend(size_t target_rank, std::vector<int>& send_vector) override;
+    void isend(size_t target_rank, std::vector<float>& send_vector) override;
+    void isend(size_t target_rank, std::vector<double>& send_vector) override;
+    void ireceive(size_t source_rank, std::vector<int>& recv_vector) override;
+    void ireceive(size_t source_rank, std::vector<float>& recv_vector) override;
+    void ireceive(size_t source_rank, std::vector<double>& recv_vector) override;
+    void wait_all() override;
+
+    void all_to_all(std::vector<int>& send_vector, std::vector<int>& recv_vector) override;
+
     void all_gather(std::vector<int>& local_portion, std::vector<int>& global_portion) override;
     void all_gather(std::vector<float>& local_portion, std::vector<float>& global_portion) override;
     void all_gather(std::vector<double>& local_portion, std::vector<double>& global_portion) override;
@@ -57,6 +67,7 @@ public:
 
 protected:
     MPI_Comm* m_comm;
+    std::vector<MPI_Request> m_pending_requests;
 
 };
 
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cassert>
 #include <utility>
+#include <tuple>
 
 namespace PlatoSubproblemLibrary
 {
@@ -41,64 +42,46 @@ void Interface_ParallelExchanger_global::build()
     const size_t num_local = m_globals.size();
     put_num_local_locations(num_local);
 
-    std::vector<std::pair<size_t, size_t> > global_and_local_pair(num_local);
+    // shared pairs are resolved by rendezvous: each global is registered at a directory processor
+    // chosen by hashing it, and the directory tells every holder of the global about the others
+    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+
+    // register globals and local indexes with directories
+    std::vector<std::vector<int> > registrations_to_send(mpi_size);
     for(size_t local_index = 0u; local_index < num_local; local_index++)
     {
-        global_and_local_pair[local_index] = std::make_pair(m_globals[local_index], local_index);
+        const size_t this_global = m_globals[local_index];
+        std::vector<int>& registrations = registrations_to_send[get_directory_rank(this_global)];
+        registrations.push_back(this_global);
+        registrations.push_back(local_index);
     }
-    std::sort(global_and_local_pair.begin(), global_and_local_pair.end());
-
-    // get minimums and maximums
-    size_t mpi_size = m_authority->mpi_wrapper->get_size();
-    const int global_minimum_index_on_local = global_and_local_pair.front().first;
-    std::vector<int> global_minimum_indexes(mpi_size, 0);
-    m_authority->mpi_wrapper->all_gather(global_minimum_index_on_local, global_minimum_indexes);
-    const int global_maximum_index_on_local = global_and_local_pair.back().first;
-    std::vector<int> global_maximum_indexes(mpi_size, 0);
-    m_authority->mpi_wrapper->all_gather(global_maximum_index_on_local, global_maximum_indexes);
-
-    // allocate
+    std::vector<std::vector<int> > registrations_received;
+    sparse_exchange(registrations_to_send, registrations_received);
+    registrations_to_send.clear();
+
+    // as directory, tell holders of each global about its other holders
+    std::vector<std::vector<int> > holders_to_send(mpi_size);
+    build_directory_replies(registrations_received, holders_to_send);
+    registrations_received.clear();
+    std::vector<std::vector<int> > holders_received;
+    sparse_exchange(holders_to_send, holders_received);
+    holders_to_send.clear();
+
+    // replies are triples of local index, holding processor, and index on holding processor
     std::vector<std::vector<std::pair<size_t, size_t> > > shared_local_and_nonlocal_pairs(mpi_size);
-
-    // communicate when globals intersect
-    size_t mpi_rank = m_authority->mpi_wrapper->get_rank();
-    for(size_t proc = 0u; proc < mpi_size; proc++)
+    for(size_t directory = 0u; directory < mpi_size; directory++)
     {
-        // do not communicate with yourself
-        if(proc == mpi_rank)
-        {
-            continue;
-        }
-
-        // no need to communicate
-        const bool intersects = intersect(global_minimum_index_on_local,
-                                          global_maximum_index_on_local,
-                                          global_minimum_indexes[proc],
-                                          global_maximum_indexes[proc]);
-        if(!intersects)
+        const std::vector<int>& holders = holders_received[directory];
+        const size_t num_holders = holders.size() / 3u;
+        for(size_t holder = 0u; holder < num_holders; holder++)
         {
-            continue;
-        }
-
-        // choose which processor does the matching for the two
-        const bool send_first = (proc < mpi_rank);
-        if(send_first)
-        {
-            build_send_first(num_local,
-                             proc,
-                             global_minimum_indexes,
-                             global_maximum_indexes,
-                             global_and_local_pair,
-                             shared_local_and_nonlocal_pairs);
-        }
-        else
-        {
-            build_receive_first(num_local,
-                                proc,
-                                global_and_local_pair,
-                                shared_local_and_nonlocal_pairs);
+            const size_t this_local = holders[3u * holder + 0u];
+            const size_t other_proc = holders[3u * holder + 1u];
+            const size_t this_nonlocal = holders[3u * holder + 2u];
+            shared_local_and_nonlocal_pairs[other_proc].push_back(std::make_pair(this_local, this_nonlocal));
         }
     }
+    holders_received.clear();
 
     // put shared pairs
     put_shared_pairs(shared_local_and_nonlocal_pairs);
@@ -109,150 +92,91 @@ void Interface_ParallelExchanger_global::build()
     m_globals.clear();
 }
 
-void Interface_ParallelExchanger_global::build_send_first(size_t num_local,
-                                                          size_t proc,
-                                                          const std::vector<int>& global_minimum_indexes,
-                                                          const std::vector<int>& global_maximum_indexes,
-                                                          const std::vector<std::pair<size_t, size_t> >& global_and_local_pair,
-                                                          std::vector<std::vector<std::pair<size_t, size_t> > >& shared_local_and_nonlocal_pairs)
+size_t Interface_ParallelExchanger_global::get_directory_rank(size_t global)
 {
-    // count for sending
-    size_t num_send = 0u;
-    for(size_t local_index = 0u; local_index < num_local; local_index++)
-    {
-        const int this_global = m_globals[local_index];
-        num_send += (global_minimum_indexes[proc] <= this_global) && (this_global <= global_maximum_indexes[proc]);
-    }
-
-    // allocate for sending
-    m_authority->mpi_wrapper->send(proc, (int)num_send);
-    std::vector<int> local_index_send(num_send);
-    std::vector<int> global_index_send(num_send);
+    return global % m_authority->mpi_wrapper->get_size();
+}
 
-    // fill for sending
-    size_t send_counter = 0u;
-    for(size_t local_index = 0u; local_index < num_local; local_index++)
+void Interface_ParallelExchanger_global::build_directory_replies(const std::vector<std::vector<int> >& registrations_received,
+                                                                 std::vector<std::vector<int> >& holders_to_send)
+{
+    // gather registrations as global, processor, and index on processor
+    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+    std::vector<std::tuple<size_t, size_t, size_t> > registrations;
+    for(size_t proc = 0u; proc < mpi_size; proc++)
     {
-        const int this_global = global_and_local_pair[local_index].first;
-
-        if((global_minimum_indexes[proc] <= this_global) && (this_global <= global_maximum_indexes[proc]))
+        const size_t num_registrations = registrations_received[proc].size() / 2u;
+        for(size_t registration = 0u; registration < num_registrations; registration++)
         {
-            const int this_local = global_and_local_pair[local_index].second;
-
-            local_index_send[send_counter] = this_local;
-            global_index_send[send_counter] = this_global;
-            send_counter++;
+            registrations.push_back(std::make_tuple(registrations_received[proc][2u * registration + 0u],
+                                                    proc,
+                                                    registrations_received[proc][2u * registration + 1u]));
         }
     }
+    std::sort(registrations.begin(), registrations.end());
 
-    // send pairs
-    m_authority->mpi_wrapper->send(proc, local_index_send);
-    m_authority->mpi_wrapper->send(proc, global_index_send);
-
-    // count for receiving
-    int num_pairs = 0;
-    m_authority->mpi_wrapper->receive(proc, num_pairs);
-
-    // allocate for receiving
-    std::vector<int> local_indexes_recv(num_pairs);
-    std::vector<int> nonlocal_indexes_recv(num_pairs);
-
-    // fill by receiving
-    m_authority->mpi_wrapper->receive(proc, local_indexes_recv);
-    m_authority->mpi_wrapper->receive(proc, nonlocal_indexes_recv);
-
-    shared_local_and_nonlocal_pairs[proc].resize(num_pairs);
-    for(int pair = 0u; pair < num_pairs; pair++)
-    {
-        const size_t this_local = local_indexes_recv[pair];
-        const size_t this_nonlocal = nonlocal_indexes_recv[pair];
-        shared_local_and_nonlocal_pairs[proc][pair] = std::make_pair(this_local, this_nonlocal);
-    }
-}
-
-void Interface_ParallelExchanger_global::build_receive_first(size_t num_local,
-                                                             size_t proc,
-                                                             const std::vector<std::pair<size_t, size_t> >& global_and_local_pair,
-                                                             std::vector<std::vector<std::pair<size_t, size_t> > >& shared_local_and_nonlocal_pairs)
-{
-    // receive count
-    int num_recv = 0;
-    m_authority->mpi_wrapper->receive(proc, num_recv);
-
-    // allocate for receive
-    std::vector<int> nonloal_index_recv(num_recv);
-    std::vector<int> global_index_recv(num_recv);
-
-    // receive
-    m_authority->mpi_wrapper->receive(proc, nonloal_index_recv);
-    m_authority->mpi_wrapper->receive(proc, global_index_recv);
-
-    size_t num_pairs = 0u;
-    std::vector<int> nonlocal_indexes_send;
-    std::vector<int> local_indexes_send;
-
-    // build pairs
-    for(size_t repeat = 0u; repeat < 2u; repeat++)
+    // for each run of a global held by several processors, reply to each holder with every other holder
+    const size_t num_registrations = registrations.size();
+    size_t run_begin = 0u;
+    while(run_begin < num_registrations)
     {
-        size_t local_index = 0u;
-        size_t nonlocal_index = 0u;
-
-        // linear matching search
-        const size_t local_index_max = num_local;
-        const size_t nonlocal_index_max = num_recv;
-        while(local_index != local_index_max && nonlocal_index != nonlocal_index_max)
+        const size_t this_global = std::get<0>(registrations[run_begin]);
+        size_t run_end = run_begin + 1u;
+        while(run_end < num_registrations && std::get<0>(registrations[run_end]) == this_global)
         {
-            const size_t global_from_local = global_and_local_pair[local_index].first;
-            const size_t global_from_nonlocal = global_index_recv[nonlocal_index];
+            run_end++;
+        }
 
-            if(global_from_local < global_from_nonlocal)
-            {
-                // advance
-                local_index++;
-            }
-            else if(global_from_nonlocal < global_from_local)
-            {
-                // advance
-                nonlocal_index++;
-            }
-            else
+        for(size_t holder = run_begin; holder < run_end; holder++)
+        {
+            const size_t holder_proc = std::get<1>(registrations[holder]);
+            for(size_t other = run_begin; other < run_end; other++)
             {
-                if(repeat == 1u)
+                const size_t other_proc = std::get<1>(registrations[other]);
+                if(other_proc == holder_proc)
                 {
-                    // fill
-                    const size_t this_local_index = global_and_local_pair[local_index].second;
-                    const size_t this_nonlocal_index = nonloal_index_recv[nonlocal_index];
-
-                    shared_local_and_nonlocal_pairs[proc][num_pairs] = std::make_pair(this_local_index, this_nonlocal_index);
-                    nonlocal_indexes_send[num_pairs] = this_nonlocal_index;
-                    local_indexes_send[num_pairs] = this_local_index;
+                    continue;
                 }
-                num_pairs++;
-                local_index++;
-                nonlocal_index++;
+                holders_to_send[holder_proc].push_back(std::get<2>(registrations[holder]));
+                holders_to_send[holder_proc].push_back(other_proc);
+                holders_to_send[holder_proc].push_back(std::get<2>(registrations[other]));
             }
         }
 
-        if(repeat == 0)
-        {
-            m_authority->mpi_wrapper->send(proc, (int)num_pairs);
-
-            // allocate
-            shared_local_and_nonlocal_pairs[proc].resize(num_pairs);
-            nonlocal_indexes_send.resize(num_pairs);
-            local_indexes_send.resize(num_pairs);
-            num_pairs = 0u;
-        }
+        run_begin = run_end;
     }
-
-    // send
-    m_authority->mpi_wrapper->send(proc, nonlocal_indexes_send);
-    m_authority->mpi_wrapper->send(proc, local_indexes_send);
 }
 
-bool Interface_ParallelExchanger_global::intersect(int a_lower, int a_upper, int b_lower, int b_upper)
+void Interface_ParallelExchanger_global::sparse_exchange(std::vector<std::vector<int> >& send_by_proc,
+                                                         std::vector<std::vector<int> >& recv_by_proc)
 {
-    return (b_lower <= a_upper) && (a_lower <= b_upper);
+    // exchange sizes, then only communicate with processors that have data to send or receive
+    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+    std::vector<int> send_sizes(mpi_size);
+    for(size_t proc = 0u; proc < mpi_size; proc++)
+    {
+        send_sizes[proc] = send_by_proc[proc].size();
+    }
+    std::vector<int> recv_sizes(mpi_size);
+    m_authority->mpi_wrapper->all_to_all(send_sizes, recv_sizes);
+
+    recv_by_proc.assign(mpi_size, std::vector<int>());
+    for(size_t proc = 0u; proc < mpi_size; proc++)
+    {
+        if(recv_sizes[proc] > 0)
+        {
+            recv_by_proc[proc].resize(recv_sizes[proc]);
+            m_authority->mpi_wrapper->ireceive(proc, recv_by_proc[proc]);
+        }
+    }
+    for(size_t proc = 0u; proc < mpi_size; proc++)
+    {
+        if(send_sizes[proc] > 0)
+        {
+            m_authority->mpi_wrapper->isend(proc, send_by_proc[proc]);
+        }
+    }
+    m_authority->mpi_wrapper->wait_all();
 }
 
 }
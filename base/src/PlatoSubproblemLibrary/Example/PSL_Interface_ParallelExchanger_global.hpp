@@ -30,18 +30,12 @@ public:
 
 protected:
 
-    void build_send_first(size_t num_local,
-                          size_t proc,
-                          const std::vector<int>& global_minimum_indexes,
-                          const std::vector<int>& global_maximum_indexes,
-                          const std::vector<std::pair<size_t, size_t> >& global_and_local_pair,
-                          std::vector<std::vector<std::pair<size_t, size_t> > >& shared_local_and_nonlocal_pairs);
-    void build_receive_first(size_t num_local,
-                             size_t proc,
-                             const std::vector<std::pair<size_t, size_t> >& global_and_local_pair,
-                             std::vector<std::vector<std::pair<size_t, size_t> > >& shared_local_and_nonlocal_pairs);
-
-    bool intersect(int a_lower, int a_upper, int b_lower, int b_upper);
+    size_t get_directory_rank(size_t global);
+    void build_directory_replies(const std::vector<std::vector<int> >& registrations_received,
+                                 std::vector<std::vector<int> >& holders_to_send);
+    // each processor sends send_by_proc[p] to processor p and receives recv_by_proc[p] from it
+    void sparse_exchange(std::vector<std::vector<int> >& send_by_proc,
+                         std::vector<std::vector<int> >& recv_by_proc);
 
     // received data
     std::vector<size_t> m_globals;
@@ -38,5 +38,10 @@ void Interface_ParallelVector::set_value(size_t index, double value)
     m_data[index] = value;
 }
 
+double* Interface_ParallelVector::get_data()
+{
+    return m_data.data();
+}
+
 }
 }
@@ -20,6 +20,7 @@ public:
     size_t get_length() override;
     double get_value(size_t index) override;
     void set_value(size_t index, double value) override;
+    double* get_data() override;
 
     std::vector<double> m_data;
 
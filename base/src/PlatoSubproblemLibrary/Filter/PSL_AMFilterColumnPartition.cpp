@@ -0,0 +1,440 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_AMFilterColumnPartition.hpp"
+
+#include "PSL_AMFilterUtilities.hpp"
+#include "PSL_TetMeshUtilities.hpp"
+#include "PSL_OrthogonalGridUtilities.hpp"
+#include "PSL_Abstract_ParallelVector.hpp"
+#include "PSL_Abstract_MpiWrapper.hpp"
+#include "PSL_AbstractAuthority.hpp"
+#include "PSL_Vector.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace PlatoSubproblemLibrary
+{
+
+bool AMFilterColumnPartition::IndexBox::isEmpty() const
+{
+    return mBegin[0] >= mEnd[0] || mBegin[1] >= mEnd[1] || mBegin[2] >= mEnd[2];
+}
+
+size_t AMFilterColumnPartition::IndexBox::getNumPoints() const
+{
+    if(isEmpty())
+        return 0u;
+
+    return (mEnd[0] - mBegin[0])*(mEnd[1] - mBegin[1])*(mEnd[2] - mBegin[2]);
+}
+
+AMFilterColumnPartition::AMFilterColumnPartition(AbstractAuthority* aAuthority,
+                                                 const TetMeshUtilities& aTetUtilities,
+                                                 const OrthogonalGridUtilities& aGridUtilities,
+                                                 double aPNorm)
+                                               :mAuthority(aAuthority),
+                                                mGridUtilities(aGridUtilities),
+                                                mRank(aAuthority->mpi_wrapper->get_rank()),
+                                                mNumRanks(aAuthority->mpi_wrapper->get_size()),
+                                                mGridDimensions(aGridUtilities.getGridDimensions())
+{
+    computeProcessorGrid();
+
+    mOwnedBox = getOwnedBox(mRank);
+    mBlockBox = mOwnedBox;
+    if(!mOwnedBox.isEmpty())
+    {
+        for(size_t tDim = 0; tDim < 2; ++tDim)
+        {
+            if(mBlockBox.mBegin[tDim] > 0)
+                --mBlockBox.mBegin[tDim];
+            if(mBlockBox.mEnd[tDim] < mGridDimensions[tDim])
+                ++mBlockBox.mEnd[tDim];
+        }
+
+        std::vector<size_t> tBlockDimensions = {mBlockBox.mEnd[0] - mBlockBox.mBegin[0],
+                                                mBlockBox.mEnd[1] - mBlockBox.mBegin[1],
+                                                mBlockBox.mEnd[2] - mBlockBox.mBegin[2]};
+        mBlockSweep.reset(new AMFilterLayerSweep(tBlockDimensions,aPNorm));
+    }
+
+    mMeshBox = computeMeshBox(aTetUtilities);
+    std::vector<size_t> tMeshBegin(mMeshBox.mBegin, mMeshBox.mBegin + 3);
+    std::vector<size_t> tMeshEnd(mMeshBox.mEnd, mMeshBox.mEnd + 3);
+    mMeshGridUtilities.reset(new OrthogonalGridUtilities(mGridUtilities.getSubGrid(tMeshBegin,tMeshEnd)));
+    mMeshAMFilterUtilities.reset(new AMFilterUtilities(aTetUtilities,*mMeshGridUtilities,aPNorm));
+
+    buildOwnerExchange();
+    buildHaloExchange();
+}
+
+AMFilterColumnPartition::~AMFilterColumnPartition()
+{
+}
+
+void AMFilterColumnPartition::computeProcessorGrid()
+{
+    // the per layer exchange grows with a block's perimeter, so take the squarest blocks; when the columns
+    // cannot be split between every processor, use fewer and leave the rest owning none
+    const double tNumColumnsU = mGridDimensions[0];
+    const double tNumColumnsV = mGridDimensions[1];
+    for(size_t tNumOwners = mNumRanks; tNumOwners > 0; --tNumOwners)
+    {
+        double tBestPerimeter = std::numeric_limits<double>::max();
+        for(size_t tNumBlocksU = 1; tNumBlocksU <= tNumOwners; ++tNumBlocksU)
+        {
+            if(tNumOwners % tNumBlocksU != 0)
+                continue;
+
+            const size_t tNumBlocksV = tNumOwners / tNumBlocksU;
+            if(tNumBlocksU > mGridDimensions[0] || tNumBlocksV > mGridDimensions[1])
+                continue;
+
+            const double tPerimeter = tNumColumnsU/tNumBlocksU + tNumColumnsV/tNumBlocksV;
+            if(tPerimeter < tBestPerimeter)
+            {
+                tBestPerimeter = tPerimeter;
+                mProcessorGrid[0] = tNumBlocksU;
+                mProcessorGrid[1] = tNumBlocksV;
+            }
+        }
+
+        if(tBestPerimeter < std::numeric_limits<double>::max())
+            return;
+    }
+}
+
+AMFilterColumnPartition::IndexBox AMFilterColumnPartition::getOwnedBox(const size_t& aRank) const
+{
+    IndexBox tBox = {{0u, 0u, 0u}, {0u, 0u, 0u}};
+    if(aRank >= mProcessorGrid[0]*mProcessorGrid[1])
+        return tBox;
+
+    const size_t tBlockIndex[2] = {aRank % mProcessorGrid[0], aRank / mProcessorGrid[0]};
+    for(size_t tDim = 0; tDim < 2; ++tDim)
+    {
+        tBox.mBegin[tDim] = (tBlockIndex[tDim]*mGridDimensions[tDim])/mProcessorGrid[tDim];
+        tBox.mEnd[tDim] = ((tBlockIndex[tDim] + 1)*mGridDimensions[tDim])/mProcessorGrid[tDim];
+    }
+    tBox.mEnd[2] = mGridDimensions[2];
+
+    return tBox;
+}
+
+void AMFilterColumnPartition::getOwnedColumns(const size_t& aRank, std::vector<size_t>& aBeginIndex, std::vector<size_t>& aEndIndex) const
+{
+    IndexBox tBox = getOwnedBox(aRank);
+    aBeginIndex.assign(tBox.mBegin, tBox.mBegin + 3);
+    aEndIndex.assign(tBox.mEnd, tBox.mEnd + 3);
+}
+
+AMFilterColumnPartition::IndexBox AMFilterColumnPartition::computeMeshBox(const TetMeshUtilities& aTetUtilities) const
+{
+    // grid elements containing the local nodes, which contain the local tets and the grid points inside them
+    IndexBox tBox = {{mGridDimensions[0], mGridDimensions[1], mGridDimensions[2]}, {0u, 0u, 0u}};
+    for(auto tCoordinates : aTetUtilities.getCoordinates())
+    {
+        Vector tPoint(tCoordinates);
+        for(size_t tDim = 0; tDim < 3; ++tDim)
+        {
+            std::vector<size_t> tSurroundingIndices = mGridUtilities.getSurroundingIndices(tDim,tPoint);
+            tBox.mBegin[tDim] = std::min(tBox.mBegin[tDim],tSurroundingIndices[0]);
+            tBox.mEnd[tDim] = std::max(tBox.mEnd[tDim],tSurroundingIndices[1] + 1);
+        }
+    }
+
+    return tBox;
+}
+
+AMFilterColumnPartition::IndexBox AMFilterColumnPartition::intersect(const IndexBox& aFirst, const IndexBox& aSecond) const
+{
+    IndexBox tBox;
+    for(size_t tDim = 0; tDim < 3; ++tDim)
+    {
+        tBox.mBegin[tDim] = std::max(aFirst.mBegin[tDim],aSecond.mBegin[tDim]);
+        tBox.mEnd[tDim] = std::min(aFirst.mEnd[tDim],aSecond.mEnd[tDim]);
+    }
+
+    return tBox;
+}
+
+void AMFilterColumnPartition::getLocalIndices(const IndexBox& aRegion, const IndexBox& aLocalBox, std::vector<size_t>& aLocalIndices) const
+{
+    const size_t tLocalDimensions[2] = {aLocalBox.mEnd[0] - aLocalBox.mBegin[0], aLocalBox.mEnd[1] - aLocalBox.mBegin[1]};
+
+    aLocalIndices.clear();
+    aLocalIndices.reserve(aRegion.getNumPoints());
+    for(size_t k = aRegion.mBegin[2]; k < aRegion.mEnd[2]; ++k)
+    {
+        for(size_t j = aRegion.mBegin[1]; j < aRegion.mEnd[1]; ++j)
+        {
+            for(size_t i = aRegion.mBegin[0]; i < aRegion.mEnd[0]; ++i)
+            {
+                aLocalIndices.push_back((i - aLocalBox.mBegin[0])
+                                        + (j - aLocalBox.mBegin[1])*tLocalDimensions[0]
+                                        + (k - aLocalBox.mBegin[2])*tLocalDimensions[0]*tLocalDimensions[1]);
+            }
+        }
+    }
+}
+
+void AMFilterColumnPartition::buildOwnerExchange()
+{
+    std::vector<int> tLocalMeshBox = {int(mMeshBox.mBegin[0]), int(mMeshBox.mBegin[1]), int(mMeshBox.mBegin[2]),
+                                      int(mMeshBox.mEnd[0]), int(mMeshBox.mEnd[1]), int(mMeshBox.mEnd[2])};
+    std::vector<int> tMeshBoxes(tLocalMeshBox.size()*mNumRanks);
+    mAuthority->mpi_wrapper->all_gather(tLocalMeshBox, tMeshBoxes);
+
+    for(size_t tRank = 0u; tRank < mNumRanks; tRank++)
+    {
+        IndexBox tOwnerRegion = intersect(mMeshBox,getOwnedBox(tRank));
+        if(!tOwnerRegion.isEmpty())
+        {
+            mOwnerRanks.push_back(tRank);
+            mOwnerMeshIndices.push_back(std::vector<size_t>());
+            getLocalIndices(tOwnerRegion,mMeshBox,mOwnerMeshIndices.back());
+        }
+
+        const int* tRankMeshBox = &tMeshBoxes[tLocalMeshBox.size()*tRank];
+        IndexBox tContributorMeshBox = {{size_t(tRankMeshBox[0]), size_t(tRankMeshBox[1]), size_t(tRankMeshBox[2])},
+                                        {size_t(tRankMeshBox[3]), size_t(tRankMeshBox[4]), size_t(tRankMeshBox[5])}};
+        IndexBox tContributorRegion = intersect(tContributorMeshBox,mOwnedBox);
+        if(!tContributorRegion.isEmpty())
+        {
+            mContributorRanks.push_back(tRank);
+            mContributorBlockIndices.push_back(std::vector<size_t>());
+            getLocalIndices(tContributorRegion,mBlockBox,mContributorBlockIndices.back());
+        }
+    }
+
+    // owners learn which of their points are inside each contributor's tets
+    const std::vector<int>& tContainingTetIDs = mMeshAMFilterUtilities->getContainingTetIDs();
+    std::vector<std::vector<int> > tContributorInside(mContributorRanks.size());
+    for(size_t tContributor = 0u; tContributor < mContributorRanks.size(); tContributor++)
+    {
+        tContributorInside[tContributor].resize(mContributorBlockIndices[tContributor].size());
+        mAuthority->mpi_wrapper->ireceive(mContributorRanks[tContributor], tContributorInside[tContributor]);
+    }
+    std::vector<std::vector<int> > tOwnerInside(mOwnerRanks.size());
+    for(size_t tOwner = 0u; tOwner < mOwnerRanks.size(); tOwner++)
+    {
+        for(size_t tMeshIndex : mOwnerMeshIndices[tOwner])
+        {
+            tOwnerInside[tOwner].push_back(tContainingTetIDs[tMeshIndex] != -1 ? 1 : 0);
+        }
+        mAuthority->mpi_wrapper->isend(mOwnerRanks[tOwner], tOwnerInside[tOwner]);
+    }
+    mAuthority->mpi_wrapper->wait_all();
+
+    // contributors are in rank order, so the first to claim a point is the lowest rank
+    std::vector<int> tAcceptedRank(mBlockBox.getNumPoints(), -1);
+    mContributorAccepted.resize(mContributorRanks.size());
+    for(size_t tContributor = 0u; tContributor < mContributorRanks.size(); tContributor++)
+    {
+        const std::vector<size_t>& tBlockIndices = mContributorBlockIndices[tContributor];
+        for(size_t tPoint = 0u; tPoint < tBlockIndices.size(); tPoint++)
+        {
+            if(tContributorInside[tContributor][tPoint] == 1 && tAcceptedRank[tBlockIndices[tPoint]] == -1)
+                tAcceptedRank[tBlockIndices[tPoint]] = mContributorRanks[tContributor];
+        }
+    }
+    for(size_t tContributor = 0u; tContributor < mContributorRanks.size(); tContributor++)
+    {
+        const std::vector<size_t>& tBlockIndices = mContributorBlockIndices[tContributor];
+        mContributorAccepted[tContributor].resize(tBlockIndices.size());
+        for(size_t tPoint = 0u; tPoint < tBlockIndices.size(); tPoint++)
+        {
+            mContributorAccepted[tContributor][tPoint] = (tAcceptedRank[tBlockIndices[tPoint]] == int(mContributorRanks[tContributor]));
+        }
+    }
+}
+
+void AMFilterColumnPartition::buildHaloExchange()
+{
+    if(mOwnedBox.isEmpty())
+        return;
+
+    // the support stencil reaches one column in i and j, so each layer exchanges the owned columns
+    // bordering each neighboring block, as layer indices of the block
+    const size_t tBlockIndex[2] = {mRank % mProcessorGrid[0], mRank / mProcessorGrid[0]};
+    for(size_t tDim = 0; tDim < 2; ++tDim)
+    {
+        for(int tSide = -1; tSide <= 1; tSide += 2)
+        {
+            if((tSide < 0 && tBlockIndex[tDim] == 0) || (tSide > 0 && tBlockIndex[tDim] + 1 == mProcessorGrid[tDim]))
+                continue;
+
+            size_t tNeighborBlockIndex[2] = {tBlockIndex[0], tBlockIndex[1]};
+            tNeighborBlockIndex[tDim] += tSide;
+            mHaloRanks.push_back(tNeighborBlockIndex[0] + tNeighborBlockIndex[1]*mProcessorGrid[0]);
+
+            IndexBox tSendBox = mOwnedBox;
+            IndexBox tReceiveBox = mOwnedBox;
+            tSendBox.mEnd[2] = tReceiveBox.mEnd[2] = 1u;
+            if(tSide < 0)
+            {
+                tSendBox.mEnd[tDim] = mOwnedBox.mBegin[tDim] + 1;
+                tReceiveBox.mBegin[tDim] = mOwnedBox.mBegin[tDim] - 1;
+                tReceiveBox.mEnd[tDim] = mOwnedBox.mBegin[tDim];
+            }
+            else
+            {
+                tSendBox.mBegin[tDim] = mOwnedBox.mEnd[tDim] - 1;
+                tReceiveBox.mBegin[tDim] = mOwnedBox.mEnd[tDim];
+                tReceiveBox.mEnd[tDim] = mOwnedBox.mEnd[tDim] + 1;
+            }
+
+            mHaloSendIndices.push_back(std::vector<size_t>());
+            getLocalIndices(tSendBox,mBlockBox,mHaloSendIndices.back());
+            mHaloReceiveIndices.push_back(std::vector<size_t>());
+            getLocalIndices(tReceiveBox,mBlockBox,mHaloReceiveIndices.back());
+        }
+    }
+}
+
+void AMFilterColumnPartition::exchangeValues(const std::vector<size_t>& aSendRanks,
+                                             const std::vector<std::vector<size_t> >& aSendIndices,
+                                             const double* aSendValues,
+                                             const std::vector<size_t>& aReceiveRanks,
+                                             const std::vector<std::vector<size_t> >& aReceiveIndices,
+                                             const size_t& aValuesPerPoint,
+                                             const std::vector<std::vector<char> >* aSendMask)
+{
+    mReceiveBuffers.resize(aReceiveRanks.size());
+    for(size_t tReceive = 0u; tReceive < aReceiveRanks.size(); tReceive++)
+    {
+        mReceiveBuffers[tReceive].resize(aReceiveIndices[tReceive].size()*aValuesPerPoint);
+        mAuthority->mpi_wrapper->ireceive(aReceiveRanks[tReceive], mReceiveBuffers[tReceive]);
+    }
+
+    mSendBuffers.resize(aSendRanks.size());
+    for(size_t tSend = 0u; tSend < aSendRanks.size(); tSend++)
+    {
+        const std::vector<size_t>& tIndices = aSendIndices[tSend];
+        std::vector<double>& tBuffer = mSendBuffers[tSend];
+        tBuffer.resize(tIndices.size()*aValuesPerPoint);
+        for(size_t tPoint = 0u; tPoint < tIndices.size(); tPoint++)
+        {
+            const bool tSendPoint = (aSendMask == NULL || (*aSendMask)[tSend][tPoint]);
+            for(size_t tValue = 0u; tValue < aValuesPerPoint; tValue++)
+            {
+                tBuffer[tPoint*aValuesPerPoint + tValue] = (tSendPoint ? aSendValues[tIndices[tPoint]*aValuesPerPoint + tValue] : 0.);
+            }
+        }
+        mAuthority->mpi_wrapper->isend(aSendRanks[tSend], tBuffer);
+    }
+
+    mAuthority->mpi_wrapper->wait_all();
+}
+
+void AMFilterColumnPartition::exchangeLayer(double* aLayerValues, const size_t& aValuesPerPoint)
+{
+    exchangeValues(mHaloRanks, mHaloSendIndices, aLayerValues, mHaloRanks, mHaloReceiveIndices, aValuesPerPoint);
+
+    for(size_t tNeighbor = 0u; tNeighbor < mHaloRanks.size(); tNeighbor++)
+    {
+        const std::vector<size_t>& tIndices = mHaloReceiveIndices[tNeighbor];
+        for(size_t tPoint = 0u; tPoint < tIndices.size(); tPoint++)
+        {
+            for(size_t tValue = 0u; tValue < aValuesPerPoint; tValue++)
+            {
+                aLayerValues[tIndices[tPoint]*aValuesPerPoint + tValue] = mReceiveBuffers[tNeighbor][tPoint*aValuesPerPoint + tValue];
+            }
+        }
+    }
+}
+
+void AMFilterColumnPartition::sendToOwners(const std::vector<double>& aMeshGridValues, std::vector<double>& aBlockValues, bool aSumContributions)
+{
+    exchangeValues(mOwnerRanks, mOwnerMeshIndices, aMeshGridValues.data(), mContributorRanks, mContributorBlockIndices, 1u);
+
+    aBlockValues.assign(mBlockBox.getNumPoints(), 0.);
+    for(size_t tContributor = 0u; tContributor < mContributorRanks.size(); tContributor++)
+    {
+        const std::vector<size_t>& tBlockIndices = mContributorBlockIndices[tContributor];
+        for(size_t tPoint = 0u; tPoint < tBlockIndices.size(); tPoint++)
+        {
+            if(aSumContributions)
+                aBlockValues[tBlockIndices[tPoint]] += mReceiveBuffers[tContributor][tPoint];
+            else if(mContributorAccepted[tContributor][tPoint])
+                aBlockValues[tBlockIndices[tPoint]] = mReceiveBuffers[tContributor][tPoint];
+        }
+    }
+}
+
+void AMFilterColumnPartition::sendToContributors(const std::vector<double>& aBlockValues, std::vector<double>& aMeshGridValues, bool aOnlyAccepted)
+{
+    exchangeValues(mContributorRanks,
+                   mContributorBlockIndices,
+                   aBlockValues.data(),
+                   mOwnerRanks,
+                   mOwnerMeshIndices,
+                   1u,
+                   (aOnlyAccepted ? &mContributorAccepted : NULL));
+
+    aMeshGridValues.assign(mMeshBox.getNumPoints(), 0.);
+    for(size_t tOwner = 0u; tOwner < mOwnerRanks.size(); tOwner++)
+    {
+        const std::vector<size_t>& tMeshIndices = mOwnerMeshIndices[tOwner];
+        for(size_t tPoint = 0u; tPoint < tMeshIndices.size(); tPoint++)
+        {
+            aMeshGridValues[tMeshIndices[tPoint]] = mReceiveBuffers[tOwner][tPoint];
+        }
+    }
+}
+
+void AMFilterColumnPartition::computeBlockPrintableDensity(AbstractInterface::ParallelVector* const aBlueprintDensity,
+                                                           std::vector<double>& aBlockBlueprintDensity,
+                                                           std::vector<double>& aBlockPrintableDensity)
+{
+    std::vector<double> tMeshGridBlueprintDensity;
+    mMeshAMFilterUtilities->computeGridBlueprintDensity(aBlueprintDensity,tMeshGridBlueprintDensity);
+    sendToOwners(tMeshGridBlueprintDensity,aBlockBlueprintDensity,false);
+
+    if(mBlockSweep)
+        mBlockSweep->computeGridPrintableDensity(aBlockBlueprintDensity,aBlockPrintableDensity,this);
+}
+
+void AMFilterColumnPartition::computeTetMeshPrintableDensity(AbstractInterface::ParallelVector* aDensity)
+{
+    std::vector<double> tBlockBlueprintDensity;
+    std::vector<double> tBlockPrintableDensity;
+    computeBlockPrintableDensity(aDensity,tBlockBlueprintDensity,tBlockPrintableDensity);
+
+    std::vector<double> tMeshGridPrintableDensity;
+    sendToContributors(tBlockPrintableDensity,tMeshGridPrintableDensity,false);
+    mMeshAMFilterUtilities->computeTetMeshPrintableDensity(tMeshGridPrintableDensity,aDensity);
+}
+
+void AMFilterColumnPartition::computeTetMeshBlueprintDensityGradient(AbstractInterface::ParallelVector* const aBlueprintDensity,
+                                                                     AbstractInterface::ParallelVector* aGradient)
+{
+    // recompute the printable density the gradient was evaluated at, including the neighboring columns
+    std::vector<double> tBlockBlueprintDensity;
+    std::vector<double> tBlockPrintableDensity;
+    computeBlockPrintableDensity(aBlueprintDensity,tBlockBlueprintDensity,tBlockPrintableDensity);
+
+    // every processor interpolating a grid point contributes to its gradient
+    std::vector<double> tMeshGridPrintableDensityGradient;
+    mMeshAMFilterUtilities->computeGridPrintableDensityGradient(aGradient,tMeshGridPrintableDensityGradient);
+    std::vector<double> tBlockPrintableDensityGradient;
+    sendToOwners(tMeshGridPrintableDensityGradient,tBlockPrintableDensityGradient,true);
+
+    std::vector<double> tBlockBlueprintDensityGradient;
+    if(mBlockSweep)
+    {
+        mBlockSweep->computeGridBlueprintDensityGradient(tBlockBlueprintDensity,
+                                                         tBlockPrintableDensity,
+                                                         tBlockPrintableDensityGradient,
+                                                         tBlockBlueprintDensityGradient,
+                                                         this);
+    }
+
+    // only the processor a grid point's blueprint density was taken from gets its gradient
+    std::vector<double> tMeshGridBlueprintDensityGradient;
+    sendToContributors(tBlockBlueprintDensityGradient,tMeshGridBlueprintDensityGradient,true);
+    mMeshAMFilterUtilities->computeTetMeshBlueprintDensityGradient(aBlueprintDensity,tMeshGridBlueprintDensityGradient,aGradient);
+}
+
+}
@@ -0,0 +1,124 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Class: Structured grid of the AM filter distributed across processors by build direction columns.
+*
+* The (i,j) columns of the global grid are split into blocks, one per processor, and each processor
+* runs the layer sweep over every layer of its block, exchanging the columns bordering its neighbors
+* once per layer. Tet densities are interpolated on a sub grid covering only the local mesh and sent
+* to the owners of the columns they land in; printable densities come back the same way. Memory then
+* scales with the local mesh rather than the global one.
+*/
+
+#include "PSL_AMFilterLayerSweep.hpp"
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace PlatoSubproblemLibrary
+{
+namespace AbstractInterface
+{
+class ParallelVector;
+}
+class AbstractAuthority;
+class TetMeshUtilities;
+class OrthogonalGridUtilities;
+class AMFilterUtilities;
+
+class AMFilterColumnPartition : public AMFilterLayerExchange
+{
+public:
+    // aTetUtilities is this processor's part of the mesh and aGridUtilities is the global grid, the same on every processor
+    AMFilterColumnPartition(AbstractAuthority* aAuthority,
+                            const TetMeshUtilities& aTetUtilities,
+                            const OrthogonalGridUtilities& aGridUtilities,
+                            double aPNorm);
+    virtual ~AMFilterColumnPartition();
+
+    // replace the blueprint density on the local tet mesh with its printable density
+    void computeTetMeshPrintableDensity(AbstractInterface::ParallelVector* aDensity);
+    // replace the gradient with respect to the printable density with the gradient with respect to the blueprint density
+    void computeTetMeshBlueprintDensityGradient(AbstractInterface::ParallelVector* const aBlueprintDensity,
+                                                AbstractInterface::ParallelVector* aGradient);
+
+    // half open ranges of grid point indices of the columns a processor owns, empty if it owns none
+    void getOwnedColumns(const size_t& aRank, std::vector<size_t>& aBeginIndex, std::vector<size_t>& aEndIndex) const;
+
+    virtual void exchangeLayer(double* aLayerValues, const size_t& aValuesPerPoint);
+
+private:
+
+    // half open ranges of global grid point indices in each direction
+    struct IndexBox
+    {
+        size_t mBegin[3];
+        size_t mEnd[3];
+
+        bool isEmpty() const;
+        size_t getNumPoints() const;
+    };
+
+    void computeProcessorGrid();
+    IndexBox getOwnedBox(const size_t& aRank) const;
+    IndexBox computeMeshBox(const TetMeshUtilities& aTetUtilities) const;
+    IndexBox intersect(const IndexBox& aFirst, const IndexBox& aSecond) const;
+    // serialized indices, within aLocalBox, of the points of aRegion in k, j, i order
+    void getLocalIndices(const IndexBox& aRegion, const IndexBox& aLocalBox, std::vector<size_t>& aLocalIndices) const;
+
+    void buildOwnerExchange();
+    void buildHaloExchange();
+
+    // send aValuesPerPoint values per point at aSendIndices to each of aSendRanks, zero where aSendMask is given
+    // and unset, and receive from each of aReceiveRanks into mReceiveBuffers
+    void exchangeValues(const std::vector<size_t>& aSendRanks,
+                        const std::vector<std::vector<size_t> >& aSendIndices,
+                        const double* aSendValues,
+                        const std::vector<size_t>& aReceiveRanks,
+                        const std::vector<std::vector<size_t> >& aReceiveIndices,
+                        const size_t& aValuesPerPoint,
+                        const std::vector<std::vector<char> >* aSendMask = NULL);
+
+    void sendToOwners(const std::vector<double>& aMeshGridValues, std::vector<double>& aBlockValues, bool aSumContributions);
+    void sendToContributors(const std::vector<double>& aBlockValues, std::vector<double>& aMeshGridValues, bool aOnlyAccepted);
+    void computeBlockPrintableDensity(AbstractInterface::ParallelVector* const aBlueprintDensity,
+                                      std::vector<double>& aBlockBlueprintDensity,
+                                      std::vector<double>& aBlockPrintableDensity);
+
+    AbstractAuthority* mAuthority;
+    const OrthogonalGridUtilities& mGridUtilities;
+
+    size_t mRank;
+    size_t mNumRanks;
+    std::vector<size_t> mGridDimensions;
+    // blocks of columns are laid out on a processor grid, processors past its size own no columns
+    size_t mProcessorGrid[2];
+
+    IndexBox mMeshBox;  // points the local mesh is interpolated on
+    IndexBox mOwnedBox; // owned columns, every layer
+    IndexBox mBlockBox; // owned columns and the neighboring columns the sweep reads
+
+    std::unique_ptr<OrthogonalGridUtilities> mMeshGridUtilities;
+    std::unique_ptr<AMFilterUtilities> mMeshAMFilterUtilities;
+    std::unique_ptr<AMFilterLayerSweep> mBlockSweep;
+
+    // processors owning columns of the mesh box, and the mesh grid indices sent to each
+    std::vector<size_t> mOwnerRanks;
+    std::vector<std::vector<size_t> > mOwnerMeshIndices;
+    // processors whose mesh box meets the owned box, and the block indices received from each
+    std::vector<size_t> mContributorRanks;
+    std::vector<std::vector<size_t> > mContributorBlockIndices;
+    // a grid point inside tets of several processors takes its blueprint density from the lowest of them
+    std::vector<std::vector<char> > mContributorAccepted;
+
+    // neighboring blocks, with layer indices of the owned points they read and of the points read from them
+    std::vector<size_t> mHaloRanks;
+    std::vector<std::vector<size_t> > mHaloSendIndices;
+    std::vector<std::vector<size_t> > mHaloReceiveIndices;
+
+    std::vector<std::vector<double> > mSendBuffers;
+    std::vector<std::vector<double> > mReceiveBuffers;
+};
+
+}
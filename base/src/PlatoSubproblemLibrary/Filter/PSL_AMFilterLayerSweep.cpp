@@ -0,0 +1,279 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_AMFilterLayerSweep.hpp"
+#include "PSL_AMFilterUtilities.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+namespace PlatoSubproblemLibrary
+{
+
+const size_t AMFilterLayerSweep::mMaxNumSupports;
+
+AMFilterLayerSweep::AMFilterLayerSweep(const std::vector<size_t>& aGridDimensions, double aPNorm)
+                                     :mGridDimensions(aGridDimensions),
+                                      mPNorm(aPNorm)
+{
+    if(aGridDimensions.size() != 3u)
+        throw(std::domain_error("AMFilterLayerSweep: Grid dimension must be 3"));
+
+    for(size_t tNumSupports = 1; tNumSupports <= mMaxNumSupports; ++tNumSupports)
+        mSupportQNorms[tNumSupports] = aPNorm + std::log(tNumSupports)/std::log(0.5);
+    mSupportQNorms[0] = aPNorm;
+}
+
+size_t AMFilterLayerSweep::getLayerSupportStencil(const size_t& i, const size_t& j, size_t* aSupports, size_t* aDirections) const
+{
+    // same points and order as OrthogonalGridUtilities::getSupportIndices, as indices within a layer, with
+    // the direction to each support so the transpose can be gathered: 0 (i,j), 1 (i,j-1), 2 (i,j+1), 3 (i-1,j), 4 (i+1,j)
+    const size_t tLayerIndex = i + j*mGridDimensions[0];
+
+    size_t tNumSupports = 0;
+    aSupports[tNumSupports] = tLayerIndex;
+    aDirections[tNumSupports++] = 0;
+    if(j > 0)
+    {
+        aSupports[tNumSupports] = tLayerIndex - mGridDimensions[0];
+        aDirections[tNumSupports++] = 1;
+    }
+    if(j < mGridDimensions[1] - 1)
+    {
+        aSupports[tNumSupports] = tLayerIndex + mGridDimensions[0];
+        aDirections[tNumSupports++] = 2;
+    }
+    if(i > 0)
+    {
+        aSupports[tNumSupports] = tLayerIndex - 1;
+        aDirections[tNumSupports++] = 3;
+    }
+    if(i < mGridDimensions[0] - 1)
+    {
+        aSupports[tNumSupports] = tLayerIndex + 1;
+        aDirections[tNumSupports++] = 4;
+    }
+
+    return tNumSupports;
+}
+
+bool AMFilterLayerSweep::computeGridLayerPoweredDensity(const size_t& k,
+                                                        const std::vector<double>& aGridPrintableDensity,
+                                                        std::vector<double>& aLayerPoweredDensity) const
+{
+    const size_t tLayerSize = mGridDimensions[0]*mGridDimensions[1];
+    const double* tLayerDensity = aGridPrintableDensity.data() + k*tLayerSize;
+
+    // each point supports up to five points above it, so raise it to the p norm once
+    aLayerPoweredDensity.resize(tLayerSize);
+    bool tHasNegativeDensity = false;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(||:tHasNegativeDensity)
+#endif
+    for(size_t tLayerIndex = 0; tLayerIndex < tLayerSize; ++tLayerIndex)
+    {
+        const double tDensity = tLayerDensity[tLayerIndex];
+        tHasNegativeDensity = tHasNegativeDensity || (tDensity < 0);
+        aLayerPoweredDensity[tLayerIndex] = std::pow(std::abs(tDensity),mPNorm);
+    }
+
+    return !tHasNegativeDensity;
+}
+
+void AMFilterLayerSweep::computeGridLayerSupportDensityFromPowers(const size_t& k,
+                                                                  const std::vector<double>& aLayerPoweredDensityBelow,
+                                                                  std::vector<double>& aGridSupportDensity) const
+{
+    const size_t tLayerSize = mGridDimensions[0]*mGridDimensions[1];
+    double* tLayerSupportDensity = aGridSupportDensity.data() + k*tLayerSize;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(size_t tLayerIndex = 0; tLayerIndex < tLayerSize; ++tLayerIndex)
+    {
+        if(k == 0)
+        {
+            tLayerSupportDensity[tLayerIndex] = 1.0;
+            continue;
+        }
+
+        size_t tSupports[mMaxNumSupports];
+        size_t tDirections[mMaxNumSupports];
+        const size_t tNumSupports = getLayerSupportStencil(tLayerIndex % mGridDimensions[0], tLayerIndex / mGridDimensions[0], tSupports, tDirections);
+
+        // smax with the powers already taken
+        double tSum = 0;
+        for(size_t tSupport = 0; tSupport < tNumSupports; ++tSupport)
+            tSum += aLayerPoweredDensityBelow[tSupports[tSupport]];
+
+        tLayerSupportDensity[tLayerIndex] = std::pow(tSum,1.0/mSupportQNorms[tNumSupports]);
+    }
+}
+
+void AMFilterLayerSweep::computeGridLayerSupportDensity(const int& k,
+                                                        const std::vector<double>& aGridPrintableDensity,
+                                                        std::vector<double>& aGridSupportDensity) const
+{
+    size_t tGridSize = mGridDimensions[0]*mGridDimensions[1]*mGridDimensions[2];
+
+    if(aGridPrintableDensity.size() != tGridSize || aGridSupportDensity.size() != tGridSize)
+        throw(std::domain_error("AMFilterLayerSweep::computeGridLayerSupportDensity: Density vectors do not match grid size"));
+
+    std::vector<double> tLayerPoweredDensityBelow;
+    if(k > 0 && !computeGridLayerPoweredDensity(k-1,aGridPrintableDensity,tLayerPoweredDensityBelow))
+        throw(std::domain_error("AMFilterLayerSweep: Smooth max arguments must be positive"));
+
+    computeGridLayerSupportDensityFromPowers(k,tLayerPoweredDensityBelow,aGridSupportDensity);
+}
+
+void AMFilterLayerSweep::computeGridLayerPrintableDensity(const int& k,
+                                                          const std::vector<double>& aGridBlueprintDensity,
+                                                          const std::vector<double>& aGridSupportDensity,
+                                                          std::vector<double>& aGridPrintableDensity) const
+{
+    size_t tGridSize = mGridDimensions[0]*mGridDimensions[1]*mGridDimensions[2];
+
+    if(aGridBlueprintDensity.size() != tGridSize || aGridPrintableDensity.size() != tGridSize || aGridSupportDensity.size() != tGridSize)
+        throw(std::domain_error("AMFilterLayerSweep::computeGridLayerPrintableDensity: Density vectors do not match grid size"));
+
+    const size_t tLayerSize = mGridDimensions[0]*mGridDimensions[1];
+    const size_t tLayerBegin = k*tLayerSize;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(size_t tSerializedIndex = tLayerBegin; tSerializedIndex < tLayerBegin + tLayerSize; ++tSerializedIndex)
+    {
+        aGridPrintableDensity[tSerializedIndex] = smin(aGridBlueprintDensity[tSerializedIndex],aGridSupportDensity[tSerializedIndex]);
+    }
+}
+
+void AMFilterLayerSweep::computeGridPrintableDensity(const std::vector<double>& aGridBlueprintDensity,
+                                                     std::vector<double>& aGridPrintableDensity,
+                                                     AMFilterLayerExchange* aExchange) const
+{
+
+    aGridPrintableDensity.resize(mGridDimensions[0]*mGridDimensions[1]*mGridDimensions[2]);
+
+    std::vector<double> tGridSupportDensity(aGridPrintableDensity.size());
+    std::vector<double> tLayerPoweredDensityBelow;
+    for(size_t k = 0; k < mGridDimensions[2]; ++k)
+    {
+        if(k > 0 && !computeGridLayerPoweredDensity(k-1,aGridPrintableDensity,tLayerPoweredDensityBelow))
+            throw(std::domain_error("AMFilterLayerSweep: Smooth max arguments must be positive"));
+
+        computeGridLayerSupportDensityFromPowers(k,tLayerPoweredDensityBelow,tGridSupportDensity);
+        computeGridLayerPrintableDensity(k,aGridBlueprintDensity,tGridSupportDensity,aGridPrintableDensity);
+
+        if(aExchange)
+            aExchange->exchangeLayer(aGridPrintableDensity.data() + k*mGridDimensions[0]*mGridDimensions[1], 1u);
+    }
+}
+
+void AMFilterLayerSweep::computeGridBlueprintDensityGradient(const std::vector<double>& aGridBlueprintDensity,
+                                                             const std::vector<double>& aGridPrintableDensity,
+                                                             const std::vector<double>& aGridPrintableDensityGradient,
+                                                             std::vector<double>& aGridBlueprintDensityGradient,
+                                                             AMFilterLayerExchange* aExchange) const
+{
+    size_t tGridSize = mGridDimensions[0]*mGridDimensions[1]*mGridDimensions[2];
+
+    if(aGridBlueprintDensity.size() != tGridSize || aGridPrintableDensity.size() != tGridSize || aGridPrintableDensityGradient.size() != tGridSize)
+        throw(std::domain_error("AMFilterLayerSweep::computeGridBlueprintDensityGradient: Vectors do not match grid size"));
+
+    // a layer's printable density depends on the layer below through its support density, so sweep
+    // layers top down, finishing each layer's gradient before passing it to the layer below
+    std::vector<double> tGridPrintableDensityGradient(aGridPrintableDensityGradient);
+    aGridBlueprintDensityGradient.assign(tGridSize, 0.0);
+
+    const size_t tLayerSize = mGridDimensions[0]*mGridDimensions[1];
+    std::vector<double> tGridSupportDensity(tGridSize);
+    std::vector<double> tLayerPoweredDensityBelow;
+    // contribution of each point to each of its supports, by direction, so the layer below can gather them
+    std::vector<double> tLayerSupportGradients(mMaxNumSupports*tLayerSize);
+    for(size_t k = mGridDimensions[2]; k-- > 0;)
+    {
+        if(k > 0 && !computeGridLayerPoweredDensity(k-1,aGridPrintableDensity,tLayerPoweredDensityBelow))
+            throw(std::domain_error("AMFilterLayerSweep: Smooth max arguments must be positive"));
+        computeGridLayerSupportDensityFromPowers(k,tLayerPoweredDensityBelow,tGridSupportDensity);
+
+        const size_t tLayerBegin = k*tLayerSize;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for(size_t tLayerIndex = 0; tLayerIndex < tLayerSize; ++tLayerIndex)
+        {
+            const size_t tSerializedIndex = tLayerBegin + tLayerIndex;
+
+            double tBlueprintPartial, tSupportPartial;
+            sminGradient(aGridBlueprintDensity[tSerializedIndex],tGridSupportDensity[tSerializedIndex],tBlueprintPartial,tSupportPartial);
+
+            const double tPrintableGradient = tGridPrintableDensityGradient[tSerializedIndex];
+            aGridBlueprintDensityGradient[tSerializedIndex] = tPrintableGradient*tBlueprintPartial;
+
+            // the first layer is fully supported
+            if(k == 0)
+                continue;
+
+            size_t tSupports[mMaxNumSupports];
+            size_t tDirections[mMaxNumSupports];
+            const size_t tNumSupports = getLayerSupportStencil(tLayerIndex % mGridDimensions[0], tLayerIndex / mGridDimensions[0], tSupports, tDirections);
+
+            // smaxGradient on the fixed size stencil, scaled by the largest argument so the sum of powers does not underflow
+            const double* tLayerDensityBelow = aGridPrintableDensity.data() + tLayerBegin - tLayerSize;
+            double* tSupportGradients = tLayerSupportGradients.data() + mMaxNumSupports*tLayerIndex;
+            std::fill(tSupportGradients, tSupportGradients + mMaxNumSupports, 0.0);
+
+            double tMaxArgument = 0;
+            for(size_t tSupport = 0; tSupport < tNumSupports; ++tSupport)
+                tMaxArgument = std::max(tMaxArgument,tLayerDensityBelow[tSupports[tSupport]]);
+            if(tMaxArgument == 0)
+                continue;
+
+            double tScaledSum = 0;
+            for(size_t tSupport = 0; tSupport < tNumSupports; ++tSupport)
+                tScaledSum += std::pow(tLayerDensityBelow[tSupports[tSupport]]/tMaxArgument,mPNorm);
+
+            const double tQNorm = mSupportQNorms[tNumSupports];
+            const double tSupportGradient = tPrintableGradient*tSupportPartial;
+            for(size_t tSupport = 0; tSupport < tNumSupports; ++tSupport)
+            {
+                const double tArgument = tLayerDensityBelow[tSupports[tSupport]];
+                if(tArgument > 0)
+                {
+                    double tRatio = std::pow(tArgument/tMaxArgument,mPNorm)/tScaledSum;
+                    tSupportGradients[tDirections[tSupport]] = tSupportGradient*((mPNorm/tQNorm)*tGridSupportDensity[tSerializedIndex]*tRatio/tArgument);
+                }
+            }
+        }
+
+        if(k == 0)
+            break;
+
+        if(aExchange)
+            aExchange->exchangeLayer(tLayerSupportGradients.data(), mMaxNumSupports);
+
+        // gather into the layer below, visiting each point's dependents in the serial scatter's order
+        const size_t tLayerBelowBegin = tLayerBegin - tLayerSize;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for(size_t tLayerIndex = 0; tLayerIndex < tLayerSize; ++tLayerIndex)
+        {
+            const size_t i = tLayerIndex % mGridDimensions[0];
+            const size_t j = tLayerIndex / mGridDimensions[0];
+            double& tGradient = tGridPrintableDensityGradient[tLayerBelowBegin + tLayerIndex];
+
+            if(i > 0)
+                tGradient += tLayerSupportGradients[mMaxNumSupports*(tLayerIndex - 1) + 4];
+            if(j > 0)
+                tGradient += tLayerSupportGradients[mMaxNumSupports*(tLayerIndex - mGridDimensions[0]) + 2];
+            tGradient += tLayerSupportGradients[mMaxNumSupports*tLayerIndex + 0];
+            if(j < mGridDimensions[1] - 1)
+                tGradient += tLayerSupportGradients[mMaxNumSupports*(tLayerIndex + mGridDimensions[0]) + 1];
+            if(i < mGridDimensions[0] - 1)
+                tGradient += tLayerSupportGradients[mMaxNumSupports*(tLayerIndex + 1) + 3];
+        }
+    }
+}
+
+}
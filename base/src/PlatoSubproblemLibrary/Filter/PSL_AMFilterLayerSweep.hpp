@@ -0,0 +1,81 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Class: Layer by layer printability sweep of the AM filter on a structured grid.
+*
+* The printable density of a layer is the smooth min of its blueprint density and its support density,
+* the smooth max of the printable density of up to five points in the layer below. Grid vectors are
+* serialized as OrthogonalGridUtilities::getSerializedIndex, with i fastest and k slowest.
+*/
+
+#include <vector>
+#include <cstddef>
+
+namespace PlatoSubproblemLibrary
+{
+
+/* Class: Fills in values of layer points that are computed elsewhere.
+*
+* Called once per layer of a sweep, so a grid split into columns across processors can exchange
+* the columns bordering its neighbors before the next layer reads them.
+*/
+class AMFilterLayerExchange
+{
+public:
+    virtual ~AMFilterLayerExchange(){}
+
+    // aLayerValues holds aValuesPerPoint values for each point of one layer, point major
+    virtual void exchangeLayer(double* aLayerValues, const size_t& aValuesPerPoint) = 0;
+};
+
+class AMFilterLayerSweep
+{
+public:
+    AMFilterLayerSweep(const std::vector<size_t>& aGridDimensions, double aPNorm);
+
+    // a grid point is supported by at most five points in the layer below, in the directions
+    // 0 (i,j), 1 (i,j-1), 2 (i,j+1), 3 (i-1,j), 4 (i+1,j)
+    static const size_t mMaxNumSupports = 5;
+
+    void computeGridLayerSupportDensity(const int& k,
+                                        const std::vector<double>& aGridPrintableDensity,
+                                        std::vector<double>& aGridSupportDensity) const;
+    void computeGridLayerPrintableDensity(const int& k,
+                                          const std::vector<double>& aGridBlueprintDensity,
+                                          const std::vector<double>& aGridSupportDensity,
+                                          std::vector<double>& aGridPrintableDensity) const;
+
+    // aExchange, if given, is passed each layer's printable density once it is computed
+    void computeGridPrintableDensity(const std::vector<double>& aGridBlueprintDensity,
+                                     std::vector<double>& aGridPrintableDensity,
+                                     AMFilterLayerExchange* aExchange = NULL) const;
+
+    // aExchange, if given, is passed each layer's contributions to the gradient of the layer below, by direction
+    void computeGridBlueprintDensityGradient(const std::vector<double>& aGridBlueprintDensity,
+                                             const std::vector<double>& aGridPrintableDensity,
+                                             const std::vector<double>& aGridPrintableDensityGradient,
+                                             std::vector<double>& aGridBlueprintDensityGradient,
+                                             AMFilterLayerExchange* aExchange = NULL) const;
+
+    const std::vector<size_t>& getGridDimensions() const {return mGridDimensions;}
+
+private:
+
+    // layers are swept bottom up and each layer's points are independent, so these work on one layer
+    // of the serialized grid at a time without allocating or throwing inside the threaded loops
+    size_t getLayerSupportStencil(const size_t& i, const size_t& j, size_t* aSupports, size_t* aDirections) const;
+    bool computeGridLayerPoweredDensity(const size_t& k,
+                                        const std::vector<double>& aGridPrintableDensity,
+                                        std::vector<double>& aLayerPoweredDensity) const;
+    void computeGridLayerSupportDensityFromPowers(const size_t& k,
+                                                  const std::vector<double>& aLayerPoweredDensityBelow,
+                                                  std::vector<double>& aGridSupportDensity) const;
+
+    const std::vector<size_t> mGridDimensions;
+    const double mPNorm;
+
+    // the smooth max exponent 1/q only depends on the number of supports, so it is computed once per stencil size
+    double mSupportQNorms[mMaxNumSupports + 1];
+};
+
+}
@@ -1,36 +1,124 @@
 #include <PSL_AMFilterUtilities.hpp>
 #include "PSL_Abstract_ParallelVector.hpp"
+#include "PSL_Implementation_CompressedRowSparseMatrix.hpp"
 
 namespace PlatoSubproblemLibrary
 {
 
-double AMFilterUtilities::computeGridPointBlueprintDensity(const int& i, const int& j, const int&k, AbstractInterface::ParallelVector* const aTetMeshBlueprintDensity) const
+AMFilterUtilities::AMFilterUtilities(const TetMeshUtilities& aTetUtilities,
+                                     const OrthogonalGridUtilities& aGridUtilities,
+                                     double aPNorm)
+                                   :mTetUtilities(aTetUtilities),
+                                    mGridUtilities(aGridUtilities),
+                                    mPNorm(aPNorm),
+                                    mLayerSweep(aGridUtilities.getGridDimensions(),aPNorm)
 {
+    if(aPNorm < 1)
+        throw(std::domain_error("AMFilterUtilities: P norm must be greater than 1"));
+
+     // std::cout << "Computing grid XYZ coordinates" << std::endl;
+     mGridUtilities.computeGridXYZCoordinates(mGridPointCoordinates);
+     // std::cout << "Finding containing tet for each point" << std::endl;
+     mTetUtilities.getTetIDForEachPoint(mGridPointCoordinates,mContainingTetID);
+     // std::cout << "Building interpolation operators" << std::endl;
+     buildInterpolationOperators();
+     // std::cout << "AMFilterUtilities initialized" << std::endl;
+}
 
+AMFilterUtilities::~AMFilterUtilities()
+{
+}
 
+void AMFilterUtilities::buildInterpolationOperators()
+{
+    buildTetToGridOperator();
+    buildGridToTetOperator();
+
+    // gradients apply the transposes, so store them for row-wise products
+    mTetToGridOperator->storeTranspose();
+    mGridToTetOperator->storeTranspose();
+}
+
+void AMFilterUtilities::buildTetToGridOperator()
+{
+    const std::vector<std::vector<double>>& tCoordinates = mTetUtilities.getCoordinates();
     const std::vector<std::vector<int>>& tConnectivity = mTetUtilities.getConnectivity();
+    const size_t tNumGridPoints = mGridPointCoordinates.size();
+
+    std::vector<size_t> tRowBounds(1, 0u);
+    std::vector<size_t> tColumns;
+    std::vector<double> tData;
+    for(size_t tGridIndex = 0; tGridIndex < tNumGridPoints; ++tGridIndex)
+    {
+        int tContainingTetID = mContainingTetID[tGridIndex];
+
+        // grid points outside of the mesh have no density
+        if(tContainingTetID != -1)
+        {
+            auto tTet = tConnectivity[tContainingTetID];
+            std::vector<double> tBaryCentricCoordinates = mTetUtilities.computeBarycentricCoordinates(tTet, mGridPointCoordinates[tGridIndex]);
 
-    int tContainingTetID = mContainingTetID[mGridUtilities.getSerializedIndex(i,j,k)];
-    
-    if(tContainingTetID == -1)
-        return 0;
+            if(tBaryCentricCoordinates.size() != 4)
+                throw(std::runtime_error("Incorrect barycentric coordinates"));
 
-    auto tTet = tConnectivity[tContainingTetID];
-    Vector tGridPoint = mGridPointCoordinates[mGridUtilities.getSerializedIndex(i,j,k)];
+            for(auto tCoordinate : tBaryCentricCoordinates)
+                if(tCoordinate > 1 + 1e-14 || tCoordinate < 0 - 1e-14)
+                    throw(std::runtime_error("Grid point outside of TET"));
 
-    std::vector<double> tBaryCentricCoordinates = mTetUtilities.computeBarycentricCoordinates(tTet, tGridPoint);
+            for(int tNodeIndex = 0; tNodeIndex < (int) tTet.size(); ++tNodeIndex)
+            {
+                tColumns.push_back(tTet[tNodeIndex]);
+                tData.push_back(tBaryCentricCoordinates[tNodeIndex]);
+            }
+        }
+        tRowBounds.push_back(tColumns.size());
+    }
 
-    if(tBaryCentricCoordinates.size() != 4)
-        throw(std::runtime_error("Incorrect barycentric coordinates"));
+    mTetToGridOperator.reset(new example::CompressedRowSparseMatrix(tNumGridPoints, tCoordinates.size(), tRowBounds, tColumns, tData));
+}
 
-    for(auto tCoordinate : tBaryCentricCoordinates)
-        if(tCoordinate > 1 + 1e-14 || tCoordinate < 0 - 1e-14)
-            throw(std::runtime_error("Grid point outside of TET"));
+void AMFilterUtilities::buildGridToTetOperator()
+{
+    const std::vector<std::vector<double>>& tCoordinates = mTetUtilities.getCoordinates();
+    const size_t tNumTetNodes = tCoordinates.size();
+
+    std::vector<size_t> tRowBounds(1, 0u);
+    std::vector<size_t> tColumns;
+    std::vector<double> tData;
+    for(size_t tTetNodeIndex = 0; tTetNodeIndex < tNumTetNodes; ++tTetNodeIndex)
+    {
+        std::vector<std::vector<size_t>> tContainingElementIndicies = mGridUtilities.getContainingGridElement(tCoordinates[tTetNodeIndex]);
+
+        // trilinear weights are the interpolants of unit nodal values
+        std::vector<double> tUnitDensities(tContainingElementIndicies.size(), 0.0);
+        for(size_t tLocalIndex = 0; tLocalIndex < tContainingElementIndicies.size(); ++tLocalIndex)
+        {
+            tUnitDensities[tLocalIndex] = 1.0;
+            double tWeight = mGridUtilities.interpolateScalar(tContainingElementIndicies,tUnitDensities,Vector(tCoordinates[tTetNodeIndex]));
+            tUnitDensities[tLocalIndex] = 0.0;
+
+            if(tWeight != 0.0)
+            {
+                tColumns.push_back(mGridUtilities.getSerializedIndex(tContainingElementIndicies[tLocalIndex]));
+                tData.push_back(tWeight);
+            }
+        }
+        tRowBounds.push_back(tColumns.size());
+    }
+
+    mGridToTetOperator.reset(new example::CompressedRowSparseMatrix(tNumTetNodes, mGridPointCoordinates.size(), tRowBounds, tColumns, tData));
+}
+
+double AMFilterUtilities::computeGridPointBlueprintDensity(const int& i, const int& j, const int&k, AbstractInterface::ParallelVector* const aTetMeshBlueprintDensity) const
+{
+    std::vector<double> tWeights;
+    std::vector<size_t> tTetNodes;
+    mTetToGridOperator->getRow(mGridUtilities.getSerializedIndex(i,j,k), tWeights, tTetNodes);
 
     double tGridPointDensity = 0;
-    for(int tNodeIndex = 0; tNodeIndex < (int) tTet.size(); ++tNodeIndex)
+    for(size_t tNodeIndex = 0; tNodeIndex < tTetNodes.size(); ++tNodeIndex)
     {
-       tGridPointDensity += tBaryCentricCoordinates[tNodeIndex]*(aTetMeshBlueprintDensity->get_value(tTet[tNodeIndex])); 
+       tGridPointDensity += tWeights[tNodeIndex]*(aTetMeshBlueprintDensity->get_value(tTetNodes[tNodeIndex]));
     }
 
     if(tGridPointDensity < 0)
@@ -49,18 +137,15 @@ double AMFilterUtilities::computeGridPointBlueprintDensity(const std::vector<int
 
 void AMFilterUtilities::computeGridBlueprintDensity(AbstractInterface::ParallelVector* const aTetMeshBlueprintDensity, std::vector<double>& aGridBlueprintDensity) const
 {
-    auto tGridDimensions = mGridUtilities.getGridDimensions();
-    aGridBlueprintDensity.resize(tGridDimensions[0]*tGridDimensions[1]*tGridDimensions[2]);
+    std::vector<double> tTetMeshBlueprintDensity;
+    aTetMeshBlueprintDensity->get_values(tTetMeshBlueprintDensity);
+
+    mTetToGridOperator->matVec(tTetMeshBlueprintDensity, aGridBlueprintDensity, false);
 
-    for(size_t i = 0; i < tGridDimensions[0]; ++i)
+    for(auto& tGridPointDensity : aGridBlueprintDensity)
     {
-        for(size_t j = 0; j < tGridDimensions[1]; ++j)
-        {
-            for(size_t k = 0; k < tGridDimensions[2]; ++k)
-            {
-                aGridBlueprintDensity[mGridUtilities.getSerializedIndex(i,j,k)] = computeGridPointBlueprintDensity(i,j,k,aTetMeshBlueprintDensity);
-            }
-        }
+        if(tGridPointDensity < 0)
+            tGridPointDensity = 0;
     }
 }
 
@@ -68,35 +153,7 @@ void AMFilterUtilities::computeGridLayerSupportDensity(const int& k,
                                                        const std::vector<double>& aGridPrintableDensity,
                                                        std::vector<double>& aGridSupportDensity) const
 {
-    auto tGridDimensions = mGridUtilities.getGridDimensions();
-    size_t tGridSize = tGridDimensions[0]*tGridDimensions[1]*tGridDimensions[2];
-
-    if(aGridPrintableDensity.size() != tGridSize || aGridSupportDensity.size() != tGridSize)
-        throw(std::domain_error("AMFilterUtilities::computeGridLayerSupportDensity: Density vectors do not match grid size"));
-
-    for(size_t i = 0; i < tGridDimensions[0]; ++i)
-    {
-        for(size_t j = 0; j < tGridDimensions[1]; ++j)
-        {
-            if(k == 0)
-            {
-                aGridSupportDensity[mGridUtilities.getSerializedIndex(i,j,k)] = 1.0;
-            }
-            else
-            {
-                auto tSupportIndices = mGridUtilities.getSupportIndices(i,j,k);
-                std::vector<double> tSupportDensityBelow;
-                for(auto tSupportIndex : tSupportIndices)
-                {
-                    tSupportDensityBelow.push_back(aGridPrintableDensity[mGridUtilities.getSerializedIndex(tSupportIndex)]);
-                }
-
-                double tVal = smax(tSupportDensityBelow,mPNorm);
-
-                aGridSupportDensity[mGridUtilities.getSerializedIndex(i,j,k)] = tVal;
-            }
-        }
-    }
+    mLayerSweep.computeGridLayerSupportDensity(k,aGridPrintableDensity,aGridSupportDensity);
 }
 
 void AMFilterUtilities::computeGridLayerPrintableDensity(const int& k,
@@ -104,34 +161,12 @@ void AMFilterUtilities::computeGridLayerPrintableDensity(const int& k,
                                                          const std::vector<double>& aGridSupportDensity,
                                                          std::vector<double>& aGridPrintableDensity) const
 {
-    auto tGridDimensions = mGridUtilities.getGridDimensions();
-    size_t tGridSize = tGridDimensions[0]*tGridDimensions[1]*tGridDimensions[2];
-
-    if(aGridBlueprintDensity.size() != tGridSize || aGridPrintableDensity.size() != tGridSize || aGridSupportDensity.size() != tGridSize)
-        throw(std::domain_error("AMFilterUtilities::computeGridLayerPrintableDensity: Density vectors do not match grid size"));
-
-    for(size_t i = 0; i < tGridDimensions[0]; ++i)
-    {
-        for(size_t j = 0; j < tGridDimensions[1]; ++j)
-        {
-            size_t tSerializedIndex = mGridUtilities.getSerializedIndex(i,j,k);
-            aGridPrintableDensity[tSerializedIndex] = smin(aGridBlueprintDensity[tSerializedIndex],aGridSupportDensity[tSerializedIndex]);
-        }
-    }
+    mLayerSweep.computeGridLayerPrintableDensity(k,aGridBlueprintDensity,aGridSupportDensity,aGridPrintableDensity);
 }
 
 void AMFilterUtilities::computeGridPrintableDensity(const std::vector<double>& aGridBlueprintDensity, std::vector<double>& aGridPrintableDensity) const
 {
-    auto tGridDimensions = mGridUtilities.getGridDimensions();
-
-    aGridPrintableDensity.resize(tGridDimensions[0]*tGridDimensions[1]*tGridDimensions[2]);
-
-    std::vector<double> tGridSupportDensity(aGridPrintableDensity.size());
-    for(size_t k = 0; k < tGridDimensions[2]; ++k)
-    {
-        computeGridLayerSupportDensity(k,aGridPrintableDensity,tGridSupportDensity);
-        computeGridLayerPrintableDensity(k,aGridBlueprintDensity,tGridSupportDensity,aGridPrintableDensity);
-    }
+    mLayerSweep.computeGridPrintableDensity(aGridBlueprintDensity,aGridPrintableDensity);
 }
 
 double AMFilterUtilities::computeTetNodePrintableDensity(const int& aTetNodeIndex,
@@ -144,17 +179,16 @@ double AMFilterUtilities::computeTetNodePrintableDensity(const int& aTetNodeInde
     if(aGridPrintableDensity.size() != mGridPointCoordinates.size())
         throw(std::domain_error("AMFilterUtilities: Provided grid density vector does not match grid size"));
 
-    std::vector<std::vector<size_t>> tContainingElementIndicies = mGridUtilities.getContainingGridElement(tCoordinates[aTetNodeIndex]);
-
-    std::vector<double> tContainingElementDensities;
+    std::vector<double> tWeights;
+    std::vector<size_t> tGridPoints;
+    mGridToTetOperator->getRow(aTetNodeIndex, tWeights, tGridPoints);
 
-    for(auto tIndex : tContainingElementIndicies)
+    double tVal = 0;
+    for(size_t tIndex = 0; tIndex < tGridPoints.size(); ++tIndex)
     {
-        tContainingElementDensities.push_back(aGridPrintableDensity[mGridUtilities.getSerializedIndex(tIndex)]);
+        tVal += tWeights[tIndex]*aGridPrintableDensity[tGridPoints[tIndex]];
     }
 
-    double tVal = mGridUtilities.interpolateScalar(tContainingElementIndicies,tContainingElementDensities,Vector(tCoordinates[aTetNodeIndex]));
-
     return tVal;
 }
 
@@ -163,12 +197,62 @@ void AMFilterUtilities::computeTetMeshPrintableDensity(const std::vector<double>
     const std::vector<std::vector<double>>& tCoordinates = mTetUtilities.getCoordinates();
     if(aDensity->get_length() != tCoordinates.size())
         throw(std::domain_error("AMFilterUtilities: Tet mesh density vector does not match the mesh size"));
+    if(aGridPrintableDensity.size() != mGridPointCoordinates.size())
+        throw(std::domain_error("AMFilterUtilities: Provided grid density vector does not match grid size"));
+
+    std::vector<double> tTetMeshPrintableDensity;
+    mGridToTetOperator->matVec(aGridPrintableDensity, tTetMeshPrintableDensity, false);
+    aDensity->set_values(tTetMeshPrintableDensity);
+}
+
+void AMFilterUtilities::computeGridPrintableDensityGradient(AbstractInterface::ParallelVector* const aTetMeshPrintableDensityGradient,
+                                                            std::vector<double>& aGridPrintableDensityGradient) const
+{
+    const std::vector<std::vector<double>>& tCoordinates = mTetUtilities.getCoordinates();
+    if(aTetMeshPrintableDensityGradient->get_length() != tCoordinates.size())
+        throw(std::domain_error("AMFilterUtilities: Tet mesh gradient vector does not match the mesh size"));
+
+    std::vector<double> tTetMeshPrintableDensityGradient;
+    aTetMeshPrintableDensityGradient->get_values(tTetMeshPrintableDensityGradient);
+
+    mGridToTetOperator->matVec(tTetMeshPrintableDensityGradient, aGridPrintableDensityGradient, true);
+}
+
+void AMFilterUtilities::computeGridBlueprintDensityGradient(const std::vector<double>& aGridBlueprintDensity,
+                                                            const std::vector<double>& aGridPrintableDensity,
+                                                            const std::vector<double>& aGridPrintableDensityGradient,
+                                                            std::vector<double>& aGridBlueprintDensityGradient) const
+{
+    mLayerSweep.computeGridBlueprintDensityGradient(aGridBlueprintDensity,aGridPrintableDensity,aGridPrintableDensityGradient,aGridBlueprintDensityGradient);
+}
+
+void AMFilterUtilities::computeTetMeshBlueprintDensityGradient(AbstractInterface::ParallelVector* const aTetMeshBlueprintDensity,
+                                                               const std::vector<double>& aGridBlueprintDensityGradient,
+                                                               AbstractInterface::ParallelVector* aTetMeshBlueprintDensityGradient) const
+{
+    const std::vector<std::vector<double>>& tCoordinates = mTetUtilities.getCoordinates();
 
-    for(size_t i = 0; i < aDensity->get_length(); ++i)
+    if(aTetMeshBlueprintDensityGradient->get_length() != tCoordinates.size())
+        throw(std::domain_error("AMFilterUtilities: Tet mesh gradient vector does not match the mesh size"));
+    if(aGridBlueprintDensityGradient.size() != mGridPointCoordinates.size())
+        throw(std::domain_error("AMFilterUtilities: Provided grid gradient vector does not match grid size"));
+
+    // the clamp at zero passes no gradient
+    std::vector<double> tTetMeshBlueprintDensity;
+    aTetMeshBlueprintDensity->get_values(tTetMeshBlueprintDensity);
+    std::vector<double> tUnclampedGridBlueprintDensity;
+    mTetToGridOperator->matVec(tTetMeshBlueprintDensity, tUnclampedGridBlueprintDensity, false);
+
+    std::vector<double> tGridBlueprintDensityGradient(aGridBlueprintDensityGradient);
+    for(size_t tGridIndex = 0; tGridIndex < tGridBlueprintDensityGradient.size(); ++tGridIndex)
     {
-        double tVal = computeTetNodePrintableDensity(i, aGridPrintableDensity);
-        aDensity->set_value(i, tVal);
+        if(tUnclampedGridBlueprintDensity[tGridIndex] < 0)
+            tGridBlueprintDensityGradient[tGridIndex] = 0;
     }
+
+    std::vector<double> tTetMeshGradient;
+    mTetToGridOperator->matVec(tGridBlueprintDensityGradient, tTetMeshGradient, true);
+    aTetMeshBlueprintDensityGradient->set_values(tTetMeshGradient);
 }
 
 double smax(const std::vector<double>& aArguments, const double& aPNorm)
@@ -190,9 +274,48 @@ double smax(const std::vector<double>& aArguments, const double& aPNorm)
 
 double smin(const double& aArg1, const double& aArg2, double aEps)
 {
-    double tVal = 0.5*(aArg1 + aArg2 - std::pow(std::pow((aArg1 - aArg2),2) + aEps,0.5) + std::sqrt(aEps));
+    double tDifference = aArg1 - aArg2;
+    double tVal = 0.5*(aArg1 + aArg2 - std::sqrt(tDifference*tDifference + aEps) + std::sqrt(aEps));
 
     return tVal;
 }
 
+void smaxGradient(const std::vector<double>& aArguments, const double& aPNorm, std::vector<double>& aGradient)
+{
+    aGradient.assign(aArguments.size(), 0.0);
+
+    double aQNorm = aPNorm + std::log(aArguments.size())/std::log(0.5);
+    double tSmax = smax(aArguments,aPNorm);
+
+    // scale by the largest argument so the sum of powers does not underflow
+    double tMaxArgument = 0;
+    for(auto tArgument : aArguments)
+        tMaxArgument = std::max(tMaxArgument,tArgument);
+    if(tMaxArgument == 0)
+        return;
+
+    double tScaledSum = 0;
+    for(auto tArgument : aArguments)
+        tScaledSum += std::pow(tArgument/tMaxArgument,aPNorm);
+
+    // d/dx_i (sum x^p)^(1/q) = (p/q) * smax * x_i^(p-1) / sum x^p
+    for(size_t i = 0; i < aArguments.size(); ++i)
+    {
+        if(aArguments[i] > 0)
+        {
+            double tRatio = std::pow(aArguments[i]/tMaxArgument,aPNorm)/tScaledSum;
+            aGradient[i] = (aPNorm/aQNorm)*tSmax*tRatio/aArguments[i];
+        }
+    }
+}
+
+void sminGradient(const double& aArg1, const double& aArg2, double& aGradient1, double& aGradient2, double aEps)
+{
+    double tDifference = aArg1 - aArg2;
+    double tRatio = tDifference/std::sqrt(tDifference*tDifference + aEps);
+
+    aGradient1 = 0.5*(1.0 - tRatio);
+    aGradient2 = 0.5*(1.0 + tRatio);
+}
+
 }
@@ -2,6 +2,9 @@
 
 #include "PSL_TetMeshUtilities.hpp"
 #include "PSL_OrthogonalGridUtilities.hpp"
+#include "PSL_AMFilterLayerSweep.hpp"
+
+#include <memory>
 
 namespace PlatoSubproblemLibrary
 {
@@ -10,29 +13,18 @@ namespace AbstractInterface
 {
 class ParallelVector;
 }
+namespace example
+{
+class CompressedRowSparseMatrix;
+}
 
 class AMFilterUtilities
 {
 public:
     AMFilterUtilities(const TetMeshUtilities& aTetUtilities,
                       const OrthogonalGridUtilities& aGridUtilities,
-                      double aPNorm)
-                    :mTetUtilities(aTetUtilities),
-                     mGridUtilities(aGridUtilities),
-                     mPNorm(aPNorm)
-    {
-        if(aPNorm < 1)
-            throw(std::domain_error("AMFilterUtilities: P norm must be greater than 1"));
-
-         // std::cout << "Computing grid XYZ coordinates" << std::endl;
-         mGridUtilities.computeGridXYZCoordinates(mGridPointCoordinates);
-         // std::cout << "Finding containing tet for each point" << std::endl;
-         mTetUtilities.getTetIDForEachPoint(mGridPointCoordinates,mContainingTetID);
-         // std::cout << "AMFilterUtilities initialized" << std::endl;
-        
-        auto tGridDimensions = mGridUtilities.getGridDimensions();
-        mGridPointCoordinates.resize(tGridDimensions[0]*tGridDimensions[1]*tGridDimensions[2]);
-    }
+                      double aPNorm);
+    ~AMFilterUtilities();
 
     void computeGridBlueprintDensity(AbstractInterface::ParallelVector* const aTetMeshBlueprintDensity, std::vector<double>& aGridBlueprintDensity) const;
     double computeGridPointBlueprintDensity(const int& i, const int& j, const int&k, AbstractInterface::ParallelVector* const aTetMeshBlueprintDensity) const;
@@ -49,20 +41,48 @@ public:
     double computeTetNodePrintableDensity(const int& aTetNodeIndex,
                                           const std::vector<double>& aGridPrintableDensity) const;
 
+    // adjoints of the above, each maps a gradient with respect to an output to a gradient with respect to its input
+    void computeGridPrintableDensityGradient(AbstractInterface::ParallelVector* const aTetMeshPrintableDensityGradient,
+                                             std::vector<double>& aGridPrintableDensityGradient) const;
+    void computeGridBlueprintDensityGradient(const std::vector<double>& aGridBlueprintDensity,
+                                             const std::vector<double>& aGridPrintableDensity,
+                                             const std::vector<double>& aGridPrintableDensityGradient,
+                                             std::vector<double>& aGridBlueprintDensityGradient) const;
+    void computeTetMeshBlueprintDensityGradient(AbstractInterface::ParallelVector* const aTetMeshBlueprintDensity,
+                                                const std::vector<double>& aGridBlueprintDensityGradient,
+                                                AbstractInterface::ParallelVector* aTetMeshBlueprintDensityGradient) const;
+
     const std::vector<Vector>& getGridPointCoordinates() const {return mGridPointCoordinates;}
+    const std::vector<int>& getContainingTetIDs() const {return mContainingTetID;}
 
 
 private:
 
+    void buildInterpolationOperators();
+    void buildTetToGridOperator();
+    void buildGridToTetOperator();
+
     const TetMeshUtilities& mTetUtilities;
     const OrthogonalGridUtilities& mGridUtilities;
     const double mPNorm;
 
+    AMFilterLayerSweep mLayerSweep;
+
     std::vector<int> mContainingTetID;
     std::vector<Vector> mGridPointCoordinates;
+
+    // the mesh and grid are fixed, so interpolation between them is linear and computed once
+    std::unique_ptr<example::CompressedRowSparseMatrix> mTetToGridOperator; // barycentric, rows are grid points
+    std::unique_ptr<example::CompressedRowSparseMatrix> mGridToTetOperator; // trilinear, rows are tet nodes
 };
 
 double smax(const std::vector<double>& aArguments, const double& aPNorm);
 double smin(const double& aArg1, const double& aArg2, double aEps = std::numeric_limits<double>::epsilon());
+void smaxGradient(const std::vector<double>& aArguments, const double& aPNorm, std::vector<double>& aGradient);
+void sminGradient(const double& aArg1,
+                  const double& aArg2,
+                  double& aGradient1,
+                  double& aGradient2,
+                  double aEps = std::numeric_limits<double>::epsilon());
 
 }
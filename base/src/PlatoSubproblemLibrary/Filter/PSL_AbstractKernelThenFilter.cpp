@@ -64,7 +64,10 @@ AbstractKernelThenFilter::AbstractKernelThenFilter(AbstractAuthority* authority,
         m_input_data(data),
         m_original_points(points),
         m_parallel_exchanger(exchanger),
-        m_kernel(NULL)
+        m_kernel(NULL),
+        m_fused_derivatives_valid(false),
+        m_fused_input(),
+        m_fused_derivatives()
 {
 }
 
@@ -122,8 +125,26 @@ void AbstractKernelThenFilter::build()
     }
 }
 
+void AbstractKernelThenFilter::update()
+{
+    if(!m_kernel)
+    {
+        build();
+        return;
+    }
+
+    m_kernel->update();
+    forget_fused_derivatives();
+}
+
 void AbstractKernelThenFilter::apply(AbstractInterface::ParallelVector* field)
 {
+    if(is_fused())
+    {
+        fused_apply(field);
+        return;
+    }
+
     m_kernel->apply(field);
 
     // apply post filter
@@ -134,6 +155,12 @@ void AbstractKernelThenFilter::apply(AbstractInterface::ParallelVector* base_fie
 {
     assert(m_kernel);
 
+    if(is_fused())
+    {
+        fused_gradient(base_field, gradient);
+        return;
+    }
+
     // stash base field
     std::vector<double> base;
     base_field->get_values(base);
@@ -149,4 +176,65 @@ void AbstractKernelThenFilter::apply(AbstractInterface::ParallelVector* base_fie
     m_kernel->apply(base_field, gradient);
 }
 
+bool AbstractKernelThenFilter::is_elementwise() const
+{
+    return false;
+}
+
+void AbstractKernelThenFilter::elementwise_apply(double* /*values*/, double* /*derivatives*/, size_t /*length*/) const
+{
+    m_authority->utilities->fatal_error("AbstractKernelThenFilter: filter is not elementwise. Aborting.\n\n");
+}
+
+void AbstractKernelThenFilter::forget_fused_derivatives()
+{
+    m_fused_derivatives_valid = false;
+}
+
+bool AbstractKernelThenFilter::is_fused() const
+{
+    return is_elementwise() && m_input_data->didUserInput_kernel_filter_fused_projection()
+           && m_input_data->get_kernel_filter_fused_projection();
+}
+
+void AbstractKernelThenFilter::fused_apply(AbstractInterface::ParallelVector* field)
+{
+    // the elementwise function is applied once each locally owned value is filtered, before values are shared,
+    // so shared copies are written once and derivatives are kept for the gradient
+    std::vector<double> input = m_kernel->internal_get_field_at_local_points(field);
+    std::vector<double> output = m_kernel->internal_apply_at_local_points(input, false);
+    m_fused_derivatives.resize(output.size());
+    elementwise_apply(output.data(), m_fused_derivatives.data(), output.size());
+    m_fused_input.swap(input);
+    m_fused_derivatives_valid = true;
+
+    m_kernel->internal_set_field_at_local_points(field, output);
+}
+
+void AbstractKernelThenFilter::fused_gradient(AbstractInterface::ParallelVector* base_field, AbstractInterface::ParallelVector* gradient)
+{
+    // derivatives of the last apply are reused when it was of the same base field on every processor
+    std::vector<double> base = m_kernel->internal_get_field_at_local_points(base_field);
+    int local_reusable = (m_fused_derivatives_valid && base == m_fused_input) ? 1 : 0;
+    int global_reusable = 0;
+    m_authority->mpi_wrapper->all_reduce_min(local_reusable, global_reusable);
+    if(global_reusable == 0)
+    {
+        std::vector<double> output = m_kernel->internal_apply_at_local_points(base, false);
+        m_fused_derivatives.resize(output.size());
+        elementwise_apply(output.data(), m_fused_derivatives.data(), output.size());
+        m_fused_input.swap(base);
+        m_fused_derivatives_valid = true;
+    }
+
+    // scale gradient by the derivatives, then apply the transposed kernel filter
+    std::vector<double> gradient_at_local_points = m_kernel->internal_get_field_at_local_points(gradient);
+    const size_t num_local_points = gradient_at_local_points.size();
+    for(size_t local_point = 0u; local_point < num_local_points; local_point++)
+    {
+        gradient_at_local_points[local_point] *= m_fused_derivatives[local_point];
+    }
+    m_kernel->internal_set_field_at_local_points(gradient, m_kernel->internal_apply_at_local_points(gradient_at_local_points, true));
+}
+
 }
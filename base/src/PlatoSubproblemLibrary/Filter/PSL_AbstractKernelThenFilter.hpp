@@ -39,10 +39,23 @@ public:
 
     // Filter operations
     void build() override;
+    // updates the kernel filter; derivatives kept by a fused apply are discarded
+    void update() override;
     void apply(AbstractInterface::ParallelVector* field) override;
     void apply(AbstractInterface::ParallelVector* base_field, AbstractInterface::ParallelVector* gradient) override;
 
+protected:
+    // a filter that is an elementwise function of the kernel filtered field may be fused with the kernel filter,
+    // computing the function and its derivative in place of the values at the locally owned points
+    virtual bool is_elementwise() const;
+    virtual void elementwise_apply(double* values, double* derivatives, size_t length) const;
+    // to be called when the elementwise function changes
+    void forget_fused_derivatives();
+
 private:
+    bool is_fused() const;
+    void fused_apply(AbstractInterface::ParallelVector* field);
+    void fused_gradient(AbstractInterface::ParallelVector* base_field, AbstractInterface::ParallelVector* gradient);
 
     bool m_built;
     bool m_announce_radius;
@@ -52,6 +65,11 @@ private:
     AbstractInterface::ParallelExchanger* m_parallel_exchanger;
     KernelFilter* m_kernel;
 
+    // of the last fused apply, at the locally owned points
+    bool m_fused_derivatives_valid;
+    std::vector<double> m_fused_input;
+    std::vector<double> m_fused_derivatives;
+
     virtual void internal_apply(AbstractInterface::ParallelVector* field) = 0;
     virtual void internal_gradient(AbstractInterface::ParallelVector* const density_field, AbstractInterface::ParallelVector* gradient) const = 0;
 };
@@ -93,12 +93,14 @@ void AbstractKernelThenProjection::advance_continuation()
 {
     m_current_heaviside_parameter = std::min(m_current_heaviside_parameter * m_heaviside_parameter_continuation_scale,
                                              m_max_heaviside_parameter);
+    forget_fused_derivatives();
     std::cout << "INFO: KernelThenProjectionFilter advanced continuation on parameters." << std::endl; 
 }
 void AbstractKernelThenProjection::additive_advance_continuation()
 {
     m_current_heaviside_parameter = std::min(m_current_heaviside_parameter + m_heaviside_parameter_continuation_scale,
                                              m_max_heaviside_parameter);
+    forget_fused_derivatives();
     std::cout << "INFO: KernelThenProjectionFilter advanced additive continuation on parameters." << std::endl; 
 }
 
@@ -128,4 +130,14 @@ void AbstractKernelThenProjection::internal_gradient(AbstractInterface::Parallel
         projection_gradient(m_current_heaviside_parameter, field, gradient);
 }
 
+bool AbstractKernelThenProjection::is_elementwise() const
+{
+    return true;
+}
+
+void AbstractKernelThenProjection::elementwise_apply(double* values, double* derivatives, size_t length) const
+{
+    projection_apply_with_derivative(m_current_heaviside_parameter, values, derivatives, length);
+}
+
 }
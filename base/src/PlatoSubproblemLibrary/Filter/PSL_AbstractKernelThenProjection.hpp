@@ -53,9 +53,13 @@ private:
 
     void internal_apply(AbstractInterface::ParallelVector* field) override;
     void internal_gradient(AbstractInterface::ParallelVector* const field, AbstractInterface::ParallelVector* gradient) const override;
+    bool is_elementwise() const override;
+    void elementwise_apply(double* values, double* derivatives, size_t length) const override;
 
     virtual void projection_apply(const double& beta, AbstractInterface::ParallelVector* field) const = 0;
     virtual void projection_gradient(const double& beta, AbstractInterface::ParallelVector* const field, AbstractInterface::ParallelVector* gradient) const = 0;
+    // projects values in place and computes the projection derivative at each input value
+    virtual void projection_apply_with_derivative(const double& beta, double* values, double* derivatives, size_t length) const = 0;
 };
 
 }
@@ -117,27 +117,25 @@ void AbstractProjectionFilter::build()
 void AbstractProjectionFilter::apply(AbstractInterface::ParallelVector* field)
 {
     // apply heaviside
-    const size_t dimension = field->get_length();
+    AbstractInterface::ParallelVectorView field_values(field);
+    const size_t dimension = field_values.size();
     for(size_t i = 0u; i < dimension; i++)
     {
-        field->set_value(i, projection_apply(m_current_heaviside_parameter, field->get_value(i)));
+        field_values[i] = projection_apply(m_current_heaviside_parameter, field_values[i]);
     }
 }
 
 void AbstractProjectionFilter::apply(AbstractInterface::ParallelVector* base_field, AbstractInterface::ParallelVector* gradient)
 {
-    // stash base field
-    std::vector<double> base;
-    base_field->get_values(base);
-    
+    const AbstractInterface::ParallelVectorView base(base_field, true);
+    AbstractInterface::ParallelVectorView gradient_values(gradient);
+
     // scale gradient by heaviside projection contribution
     const size_t num_controls = base.size();
     for(size_t control_index = 0u; control_index < num_controls; control_index++)
     {
-        double initial_gradient_value = gradient->get_value(control_index);
-        double filtered_value = base_field->get_value(control_index);
-        double heaviside_derivative_value = projection_gradient(m_current_heaviside_parameter, filtered_value);
-        gradient->set_value(control_index, initial_gradient_value * heaviside_derivative_value);
+        const double heaviside_derivative_value = projection_gradient(m_current_heaviside_parameter, base[control_index]);
+        gradient_values[control_index] *= heaviside_derivative_value;
     }
 }
 
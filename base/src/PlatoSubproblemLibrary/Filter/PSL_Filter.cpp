@@ -16,6 +16,11 @@ Filter::~Filter()
 {
 }
 
+void Filter::update()
+{
+    // intentionally do nothing
+}
+
 void Filter::advance_continuation()
 {
     // intentionally do nothing
@@ -19,6 +19,8 @@ public:
     virtual void build() = 0;
     virtual void apply(AbstractInterface::ParallelVector* field) = 0;
     virtual void apply(AbstractInterface::ParallelVector* base_field, AbstractInterface::ParallelVector* gradient) = 0;
+    // rebuild after the input data or the point coordinates changed
+    virtual void update();
     virtual void advance_continuation();
     virtual void additive_advance_continuation();
 
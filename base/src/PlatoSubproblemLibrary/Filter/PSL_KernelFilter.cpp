@@ -1,6 +1,9 @@
 // PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
 #include "PSL_KernelFilter.hpp"
 
+#include "PSL_KernelFilterCache.hpp"
+#include "PSL_MatrixFreeKernelOperator.hpp"
+#include "PSL_StructuredStencilKernelOperator.hpp"
 #include "PSL_Abstract_GlobalUtilities.hpp"
 #include "PSL_Abstract_MpiWrapper.hpp"
 #include "PSL_Abstract_ParallelExchanger.hpp"
@@ -8,6 +11,7 @@
 #include "PSL_Abstract_PointCloud.hpp"
 #include "PSL_Abstract_MatrixAssemblyAgent.hpp"
 #include "PSL_ByRow_MatrixAssemblyAgent.hpp"
+#include "PSL_ByRowSinglePass_MatrixAssemblyAgent.hpp"
 #include "PSL_Abstract_SymmetryPlaneAgent.hpp"
 #include "PSL_ByNarrowClone_SymmetryPlaneAgent.hpp"
 #include "PSL_Abstract_MeshScaleAgent.hpp"
@@ -24,12 +28,16 @@
 #include "PSL_Abstract_PositiveDefiniteLinearSolver.hpp"
 #include "PSL_Abstract_PointGhostingAgent.hpp"
 #include "PSL_ByNarrowShare_PointGhostingAgent.hpp"
+#include "PSL_ByNeighborExchange_PointGhostingAgent.hpp"
 #include "PSL_Abstract_BoundedSupportFunction.hpp"
 #include "PSL_BoundedSupportFunctionFactory.hpp"
 #include "PSL_Point.hpp"
+#include "PSL_AxisAlignedBoundingBox.hpp"
+#include "PSL_BoundingBoxMortonHierarchy.hpp"
 #include "PSL_FreeHelpers.hpp"
 #include "PSL_AbstractAuthority.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include <cstddef>
@@ -46,6 +54,11 @@ KernelFilter::KernelFilter(AbstractAuthority* authority,
         Filter(),
         m_built(false),
         m_announce_radius(false),
+        m_built_from_cache(false),
+        m_built_as_structured_stencil(false),
+        m_built_symmetric(false),
+        m_updated_incrementally(false),
+        m_cache_tag(),
         m_authority(authority),
         m_input_data(data),
         m_original_points(points),
@@ -59,38 +72,33 @@ KernelFilter::KernelFilter(AbstractAuthority* authority,
         m_local_kernel_matrix(),
         m_parallel_block_row_kernel_matrices(),
         m_parallel_block_column_kernel_matrices(),
+        m_transpose_plan(),
+        m_noTranspose_plan(),
+        m_matvec_input(),
+        m_inverse_row_sums(),
+        m_matrix_free_operator(NULL),
         m_maintain_kernel_points(false),
-        m_kernel_points()
+        m_kernel_points(),
+        m_kernel_point_order(),
+        m_incremental_update(false),
+        m_ghosting_support(-1.),
+        m_pattern_support(-1.),
+        m_nonlocal_kernel_points(),
+        m_processor_neighbors_below(),
+        m_processor_neighbors_above(),
+        m_ghost_neighbor_ranks(),
+        m_ghost_requested_indexes()
 {
 }
 
 KernelFilter::~KernelFilter()
 {
+    free_built_state();
+
     m_authority = NULL;
     m_input_data = NULL;
     m_original_points = NULL;
     m_parallel_exchanger = NULL;
-
-    safe_free(m_bounded_support_function);
-    safe_free(m_mesh_scale_agent);
-    safe_free(m_symmetry_plane_agent);
-    safe_free(m_matrix_assembly_agent);
-    safe_free(m_matrix_normalization_agent);
-    safe_free(m_point_ghosting_agent);
-    safe_free(m_local_kernel_matrix);
-    const size_t num_row_matrices = m_parallel_block_row_kernel_matrices.size();
-    for(size_t index = 0u; index < num_row_matrices; index++)
-    {
-        safe_free(m_parallel_block_row_kernel_matrices[index]);
-    }
-    m_parallel_block_row_kernel_matrices.clear();
-    const size_t num_column_matrices = m_parallel_block_column_kernel_matrices.size();
-    for(size_t index = 0u; index < num_column_matrices; index++)
-    {
-        safe_free(m_parallel_block_column_kernel_matrices[index]);
-    }
-    m_parallel_block_column_kernel_matrices.clear();
-    safe_free(m_kernel_points);
 }
 
 void KernelFilter::set_authority(AbstractAuthority* authority)
@@ -118,6 +126,14 @@ void KernelFilter::enable_maintain_kernel_points()
 {
     m_maintain_kernel_points = true;
 }
+void KernelFilter::set_cache_tag(const std::string& tag)
+{
+    m_cache_tag = tag;
+}
+void KernelFilter::enable_incremental_update()
+{
+    m_incremental_update = true;
+}
 
 void KernelFilter::build()
 {
@@ -135,6 +151,10 @@ void KernelFilter::build()
 
     // check parameters
     check_input_data();
+    if(m_input_data->didUserInput_kernel_filter_incremental_update() && m_input_data->get_kernel_filter_incremental_update())
+    {
+        enable_incremental_update();
+    }
 
     // build all agents
     build_agents();
@@ -163,43 +183,47 @@ void KernelFilter::build()
                                                                   m_input_data,
                                                                   m_original_points,
                                                                   indexes_of_local_points);
+    if(m_input_data->didUserInput_kernel_filter_morton_order() && m_input_data->get_kernel_filter_morton_order())
+    {
+        build_kernel_point_order();
+    }
 
-    // build ghosted kernel points
-    std::vector<PointCloud*> nonlocal_kernel_points;
-    std::vector<size_t> processor_neighbors_below;
-    std::vector<size_t> processor_neighbors_above;
-    m_point_ghosting_agent->share(m_bounded_support_function->get_support(),
-                                  m_kernel_points,
-                                  nonlocal_kernel_points,
-                                  processor_neighbors_below,
-                                  processor_neighbors_above);
-
-    // assemble kernel matrix with matrix assembly agent
-    m_matrix_assembly_agent->build(m_bounded_support_function,
-                                   m_kernel_points,
-                                   nonlocal_kernel_points,
-                                   processor_neighbors_below,
-                                   processor_neighbors_above,
-                                   &m_local_kernel_matrix,
-                                   m_parallel_block_row_kernel_matrices,
-                                   m_parallel_block_column_kernel_matrices);
+    if(m_input_data->didUserInput_kernel_filter_matrix_free() && m_input_data->get_kernel_filter_matrix_free())
+    {
+        // store only what is needed to evaluate the kernel during applies
+        build_matrix_free_operator();
+    }
+    else if(!build_structured_stencil_operator())
+    {
+        build_kernel_matrices();
 
-    // normalize kernel matrix with matrix normalization agent
-    m_matrix_normalization_agent->normalize(m_kernel_points,
-                                            nonlocal_kernel_points,
-                                            m_local_kernel_matrix,
-                                            m_parallel_block_row_kernel_matrices,
-                                            m_parallel_block_column_kernel_matrices,
-                                            processor_neighbors_below,
-                                            processor_neighbors_above);
+        // determine neighbor ranks and reduced indexes for applies
+        build_parallel_matvec_plans();
+        compact_kernel_matrices();
+    }
 
     // clean up
-    if(!m_maintain_kernel_points)
+    if(!m_maintain_kernel_points && !m_incremental_update)
     {
         safe_free(m_kernel_points);
     }
-    safe_free(nonlocal_kernel_points);
-    nonlocal_kernel_points.clear();
+}
+
+void KernelFilter::update()
+{
+    if(!m_built)
+    {
+        build();
+        return;
+    }
+
+    m_updated_incrementally = (m_incremental_update && update_kernel_matrices());
+    if(!m_updated_incrementally)
+    {
+        free_built_state();
+        m_built = false;
+        build();
+    }
 }
 
 void KernelFilter::apply(AbstractInterface::ParallelVector* field)
@@ -212,6 +236,37 @@ void KernelFilter::apply(AbstractInterface::ParallelVector* /*base_field*/, Abst
     internal_apply(gradient, true);
 }
 
+void KernelFilter::apply(const std::vector<AbstractInterface::ParallelVector*>& fields)
+{
+    internal_apply(fields, false);
+}
+
+void KernelFilter::apply(AbstractInterface::ParallelVector* /*base_field*/,
+                         const std::vector<AbstractInterface::ParallelVector*>& gradients)
+{
+    internal_apply(gradients, true);
+}
+
+bool KernelFilter::is_built_from_cache()
+{
+    return m_built_from_cache;
+}
+
+bool KernelFilter::is_built_as_structured_stencil()
+{
+    return m_built_as_structured_stencil;
+}
+
+bool KernelFilter::is_built_symmetric()
+{
+    return m_built_symmetric;
+}
+
+bool KernelFilter::is_updated_incrementally()
+{
+    return m_updated_incrementally;
+}
+
 bool KernelFilter::is_valid(AbstractInterface::ParallelVector* field)
 {
     bool valid = true;
@@ -228,13 +283,13 @@ bool KernelFilter::is_valid(AbstractInterface::ParallelVector* field)
         std::vector<double> initial_contracted_data(contracted_num_nodes, 0.);
         for(size_t cn = 0u; cn < contracted_num_nodes; cn++)
         {
-            initial_contracted_data[cn] = (*points->get_point(contracted_indexes[cn]))(d);
+            initial_contracted_data[cn] = points->get_coordinate(contracted_indexes[cn], d);
         }
         m_parallel_exchanger->get_expansion_to_parallel_vector(initial_contracted_data, field);
         for(size_t l = 0u; l < local_num_points; l++)
         {
             const double from_parallel_vector = field->get_value(l);
-            const double from_local_information = (*points->get_point(l))(d);
+            const double from_local_information = points->get_coordinate(l, d);
             if(fabs(from_parallel_vector - from_local_information) > data_tol)
             {
                 valid = false;
@@ -258,12 +313,32 @@ bool KernelFilter::is_valid(AbstractInterface::ParallelVector* field)
 
 PointCloud* KernelFilter::internal_transfer_kernel_points()
 {
+    // transferred points are in the order of fields at kernel points
+    if(!m_kernel_point_order.empty() && m_kernel_points)
+    {
+        PointCloud* result = permute_kernel_points(m_kernel_points, true);
+        safe_free(m_kernel_points);
+        return result;
+    }
     PointCloud* result = m_kernel_points;
     m_kernel_points = NULL;
     return result;
 }
 
 std::vector<double> KernelFilter::internal_get_field_at_kernel_points(AbstractInterface::ParallelVector* parallel_field)
+{
+    // clone field values with symmetry plane agent
+    return m_symmetry_plane_agent->expand_with_symmetry_points(internal_get_field_at_local_points(parallel_field));
+}
+
+void KernelFilter::internal_set_field_at_kernel_points(AbstractInterface::ParallelVector* parallel_field,
+                                                       const std::vector<double>& field_at_kernel_points)
+{
+    // forget clones with symmetry plane agent
+    internal_set_field_at_local_points(parallel_field, m_symmetry_plane_agent->contract_by_symmetry_points(field_at_kernel_points));
+}
+
+std::vector<double> KernelFilter::internal_get_field_at_local_points(AbstractInterface::ParallelVector* parallel_field)
 {
     if(!m_built)
     {
@@ -271,151 +346,915 @@ std::vector<double> KernelFilter::internal_get_field_at_kernel_points(AbstractIn
     }
 
     // contract to local indexes with parallel agent
-    std::vector<double> field_at_local_points = m_parallel_exchanger->get_contraction_to_local_indexes(parallel_field);
-    // clone field values with symmetry plane agent
-    return m_symmetry_plane_agent->expand_with_symmetry_points(field_at_local_points);
+    return m_parallel_exchanger->get_contraction_to_local_indexes(parallel_field);
 }
 
-void KernelFilter::internal_set_field_at_kernel_points(AbstractInterface::ParallelVector* parallel_field,
-                                                       const std::vector<double>& field_at_kernel_points)
+std::vector<double> KernelFilter::internal_apply_at_local_points(const std::vector<double>& field_at_local_points, const bool transpose)
+{
+    const std::vector<double> field_at_kernel_points = m_symmetry_plane_agent->expand_with_symmetry_points(field_at_local_points);
+
+    // matrix-vector product
+    const std::vector<double> output_field_at_kernel_points = internal_parallel_matvec_apply(field_at_kernel_points, transpose);
+
+    return m_symmetry_plane_agent->contract_by_symmetry_points(output_field_at_kernel_points);
+}
+
+void KernelFilter::internal_set_field_at_local_points(AbstractInterface::ParallelVector* parallel_field,
+                                                      const std::vector<double>& field_at_local_points)
 {
     if(!m_built)
     {
         m_authority->utilities->fatal_error("KernelFilter applied before being built. Aborting.\n\n");
     }
 
-    // forget clones with symmetry plane agent
-    std::vector<double> output_field_at_local_points =
-            m_symmetry_plane_agent->contract_by_symmetry_points(field_at_kernel_points);
     // send and receive with parallel agent
-    m_parallel_exchanger->get_expansion_to_parallel_vector(output_field_at_local_points, parallel_field);
+    m_parallel_exchanger->get_expansion_to_parallel_vector(field_at_local_points, parallel_field);
 }
 
 void KernelFilter::internal_apply(AbstractInterface::ParallelVector* parallel_field, bool transpose)
 {
-    if(!m_built)
+    const std::vector<double> field_at_local_points = internal_get_field_at_local_points(parallel_field);
+    internal_set_field_at_local_points(parallel_field, internal_apply_at_local_points(field_at_local_points, transpose));
+}
+
+void KernelFilter::internal_apply(const std::vector<AbstractInterface::ParallelVector*>& parallel_fields, bool transpose)
+{
+    const size_t num_vectors = parallel_fields.size();
+    if(num_vectors == 0u)
     {
-        m_authority->utilities->fatal_error("KernelFilter applied before being built. Aborting.\n\n");
+        return;
     }
 
-    std::vector<double> field_at_kernel_points = internal_get_field_at_kernel_points(parallel_field);
+    // interleave fields by kernel point, so each kernel weight is loaded once for all fields
+    std::vector<double> fields_at_kernel_points;
+    for(size_t vector = 0u; vector < num_vectors; vector++)
+    {
+        const std::vector<double> field_at_kernel_points = internal_get_field_at_kernel_points(parallel_fields[vector]);
+        const size_t num_kernel_points = field_at_kernel_points.size();
+        fields_at_kernel_points.resize(num_kernel_points * num_vectors);
+        for(size_t kernel_point = 0u; kernel_point < num_kernel_points; kernel_point++)
+        {
+            fields_at_kernel_points[kernel_point * num_vectors + vector] = field_at_kernel_points[kernel_point];
+        }
+    }
 
-    // matrix-vector product
-    std::vector<double> output_field_at_kernel_points = internal_parallel_matvec_apply(field_at_kernel_points, transpose);
+    // matrix-multivector product
+    const std::vector<double> output_fields_at_kernel_points =
+            internal_parallel_matvec_apply(fields_at_kernel_points, num_vectors, transpose);
 
-    internal_set_field_at_kernel_points(parallel_field, output_field_at_kernel_points);
+    const size_t num_kernel_points = output_fields_at_kernel_points.size() / num_vectors;
+    std::vector<double> output_field_at_kernel_points(num_kernel_points);
+    for(size_t vector = 0u; vector < num_vectors; vector++)
+    {
+        for(size_t kernel_point = 0u; kernel_point < num_kernel_points; kernel_point++)
+        {
+            output_field_at_kernel_points[kernel_point] = output_fields_at_kernel_points[kernel_point * num_vectors + vector];
+        }
+        internal_set_field_at_kernel_points(parallel_fields[vector], output_field_at_kernel_points);
+    }
 }
 
 std::vector<double> KernelFilter::internal_parallel_matvec_apply(const std::vector<double>& input, const bool transpose)
+{
+    return internal_parallel_matvec_apply(input, 1u, transpose);
+}
+
+std::vector<double> KernelFilter::internal_parallel_matvec_apply(const std::vector<double>& input,
+                                                                 const size_t num_vectors,
+                                                                 const bool transpose)
 {
     const int num_iterations = m_input_data->get_iterations();
-    std::vector<double> output(input);
+    std::vector<double> output;
+    if(m_kernel_point_order.empty())
+    {
+        output = input;
+    }
+    else
+    {
+        permute_field_at_kernel_points(input, num_vectors, false, output);
+    }
 
     for(int iteration = 0; iteration < num_iterations; iteration++)
     {
         if(transpose)
         {
-            parallel_matvec_apply_transpose(output);
+            parallel_matvec_apply_transpose(output, num_vectors);
         }
         else
         {
-            parallel_matvec_apply_noTranspose(output);
+            parallel_matvec_apply_noTranspose(output, num_vectors);
         }
     }
 
+    if(!m_kernel_point_order.empty())
+    {
+        std::vector<double> renumbered_output;
+        renumbered_output.swap(output);
+        permute_field_at_kernel_points(renumbered_output, num_vectors, true, output);
+    }
     return output;
 }
 
-void KernelFilter::parallel_matvec_apply_transpose(std::vector<double>& field)
+void KernelFilter::parallel_matvec_apply_transpose(std::vector<double>& field, size_t num_vectors)
 {
-    const size_t field_size = field.size();
+    if(m_matrix_free_operator)
+    {
+        m_matrix_free_operator->apply(field, num_vectors, true);
+        return;
+    }
+    if(m_built_symmetric)
+    {
+        // (D^-1 W)' = W D^-1
+        scale_by_inverse_row_sums(field, num_vectors);
+        parallel_matvec_apply(field, num_vectors, false, m_noTranspose_plan);
+        return;
+    }
+    parallel_matvec_apply(field, num_vectors, true, m_transpose_plan);
+}
+
+void KernelFilter::parallel_matvec_apply_noTranspose(std::vector<double>& field, size_t num_vectors)
+{
+    if(m_matrix_free_operator)
+    {
+        m_matrix_free_operator->apply(field, num_vectors, false);
+        return;
+    }
+    parallel_matvec_apply(field, num_vectors, false, m_noTranspose_plan);
+    if(m_built_symmetric)
+    {
+        scale_by_inverse_row_sums(field, num_vectors);
+    }
+}
+
+void KernelFilter::build_kernel_matrices()
+{
+    // load assembled kernel matrices if cached, otherwise assemble
+    if(m_input_data->didUserInput_kernel_filter_cache_filename())
+    {
+        KernelFilterCache cache(m_authority, m_input_data->get_kernel_filter_cache_filename(), m_cache_tag);
+        cache.compute_key(m_kernel_points, m_bounded_support_function->get_support(), m_input_data);
+        m_built_from_cache = cache.load(&m_local_kernel_matrix,
+                                        m_parallel_block_row_kernel_matrices,
+                                        m_parallel_block_column_kernel_matrices);
+        if(!m_built_from_cache)
+        {
+            assemble_kernel_matrices();
+            cache.save(m_local_kernel_matrix, m_parallel_block_row_kernel_matrices, m_parallel_block_column_kernel_matrices);
+        }
+        if(m_announce_radius && (m_authority->mpi_wrapper->get_rank() == 0u))
+        {
+            std::stringstream stream;
+            stream << "Kernel Filter: " << (m_built_from_cache ? "loaded kernel matrices from" : "saved kernel matrices to")
+                   << " cache \"" << cache.get_filename() << "\"" << std::endl;
+            m_authority->utilities->print(stream.str());
+        }
+    }
+    else
+    {
+        assemble_kernel_matrices();
+    }
+}
+
+void KernelFilter::assemble_kernel_matrices()
+{
+    // build ghosted kernel points
+    std::vector<PointCloud*> nonlocal_kernel_points;
+    std::vector<size_t> processor_neighbors_below;
+    std::vector<size_t> processor_neighbors_above;
+    m_point_ghosting_agent->share(m_bounded_support_function->get_support(),
+                                  m_kernel_points,
+                                  nonlocal_kernel_points,
+                                  processor_neighbors_below,
+                                  processor_neighbors_above);
+
+    // assemble kernel matrix with matrix assembly agent
+    m_matrix_assembly_agent->build(m_bounded_support_function,
+                                   m_kernel_points,
+                                   nonlocal_kernel_points,
+                                   processor_neighbors_below,
+                                   processor_neighbors_above,
+                                   &m_local_kernel_matrix,
+                                   m_parallel_block_row_kernel_matrices,
+                                   m_parallel_block_column_kernel_matrices);
+
+    if(use_symmetric_storage())
+    {
+        build_symmetric_storage();
+    }
+    else
+    {
+        // normalize kernel matrix with matrix normalization agent
+        m_matrix_normalization_agent->normalize(m_kernel_points,
+                                                nonlocal_kernel_points,
+                                                m_local_kernel_matrix,
+                                                m_parallel_block_row_kernel_matrices,
+                                                m_parallel_block_column_kernel_matrices,
+                                                processor_neighbors_below,
+                                                processor_neighbors_above);
+    }
+
+    // retain ghosted points, so updates reweigh without ghosting and searching again
+    if(m_incremental_update && !m_built_symmetric)
+    {
+        m_nonlocal_kernel_points.swap(nonlocal_kernel_points);
+        m_processor_neighbors_below.swap(processor_neighbors_below);
+        m_processor_neighbors_above.swap(processor_neighbors_above);
+        m_ghosting_support = m_bounded_support_function->get_support();
+        m_pattern_support = m_ghosting_support;
+        build_ghost_refresh_plan();
+    }
+
+    // clean up
+    safe_free(nonlocal_kernel_points);
+    nonlocal_kernel_points.clear();
+}
+
+bool KernelFilter::update_kernel_matrices()
+{
+    // only assembled matrices with retained ghosted points are reweighed
+    int local_reusable = ((m_pattern_support > 0.) && m_kernel_points && !m_matrix_free_operator) ? 1 : 0;
+    if(m_input_data->didUserInput_kernel_filter_cache_filename()
+       || (m_input_data->get_normalization() != normalization_t::classical_row_normalization))
+    {
+        local_reusable = 0;
+    }
+    int global_reusable = 0;
+    m_authority->mpi_wrapper->all_reduce_min(local_reusable, global_reusable);
+    if(global_reusable == 0)
+    {
+        return false;
+    }
+
+    // radial function for the current input and coordinates
+    safe_free(m_mesh_scale_agent);
+    build_mesh_scale_agent(m_input_data->get_mesh_scale_agent());
+    safe_free(m_bounded_support_function);
+    determine_function();
+    const double support = m_bounded_support_function->get_support();
+
+    // kernel points at the current coordinates, cloned as when ghosted; clones must come from the same points
+    std::vector<size_t> indexes_of_local_points = m_parallel_exchanger->get_local_contracted_indexes();
+    const size_t num_local_points = indexes_of_local_points.size();
+    std::vector<double> local_point_ids(num_local_points);
+    for(size_t local_point = 0u; local_point < num_local_points; local_point++)
+    {
+        local_point_ids[local_point] = local_point;
+    }
+    const std::vector<double> built_point_ids = m_symmetry_plane_agent->expand_with_symmetry_points(local_point_ids);
+    PointCloud* kernel_points = m_symmetry_plane_agent->build_kernel_points(m_ghosting_support,
+                                                                            m_input_data->get_node_resolution_tolerance(),
+                                                                            m_input_data,
+                                                                            m_original_points,
+                                                                            indexes_of_local_points);
+    const std::vector<double> point_ids = m_symmetry_plane_agent->expand_with_symmetry_points(local_point_ids);
+    if(!m_kernel_point_order.empty() && (kernel_points->get_num_points() == m_kernel_point_order.size()))
+    {
+        PointCloud* renumbered_kernel_points = permute_kernel_points(kernel_points, false);
+        safe_free(kernel_points);
+        kernel_points = renumbered_kernel_points;
+    }
+
+    // largest displacement of any kernel point since the pattern was computed
+    double local_displacement = 0.;
+    const size_t num_kernel_points = kernel_points->get_num_points();
+    if((point_ids == built_point_ids) && (num_kernel_points == m_kernel_points->get_num_points()))
+    {
+        for(size_t kernel_point = 0u; kernel_point < num_kernel_points; kernel_point++)
+        {
+            Point point = kernel_points->get_point(kernel_point);
+            local_displacement = std::max(local_displacement, m_kernel_points->distance(kernel_point, &point));
+        }
+    }
+    else
+    {
+        local_reusable = 0;
+    }
+    double global_displacement = 0.;
+    m_authority->mpi_wrapper->all_reduce_min(local_reusable, global_reusable);
+    m_authority->mpi_wrapper->all_reduce_max(local_displacement, global_displacement);
+
+    // every pair within the support at the current coordinates must have been within the pattern support,
+    // and moving points only preserves the pattern for functions positive exactly within their support
+    const bool moved = (global_displacement > 0.);
+    if((global_reusable == 0) || (support + 2. * global_displacement > m_pattern_support)
+       || (moved && (m_input_data->get_bounded_support_function() != bounded_support_function_t::polynomial_tent_function)))
+    {
+        safe_free(kernel_points);
+        return false;
+    }
+    safe_free(m_kernel_points);
+    m_kernel_points = kernel_points;
+    if(moved)
+    {
+        refresh_ghosted_kernel_points();
+    }
+
+    // reweigh local and block row matrices; blocks from below processors were transposed when assembled
+    m_local_kernel_matrix = reweigh_kernel_matrix(m_local_kernel_matrix, m_kernel_points, false);
     const size_t mpi_rank = m_authority->mpi_wrapper->get_rank();
-    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+    const size_t num_procs = m_parallel_block_row_kernel_matrices.size();
+    for(size_t proc = 0u; proc < num_procs; proc++)
+    {
+        if(!m_parallel_block_row_kernel_matrices[proc])
+        {
+            continue;
+        }
+        if(!m_nonlocal_kernel_points[proc])
+        {
+            m_authority->utilities->fatal_error("KernelFilter: block row matrix without ghosted points during update. Aborting.\n\n");
+        }
+        m_parallel_block_row_kernel_matrices[proc] = reweigh_kernel_matrix(m_parallel_block_row_kernel_matrices[proc],
+                                                                           m_nonlocal_kernel_points[proc],
+                                                                           proc < mpi_rank);
+    }
 
-    // separate input and output
-    std::vector<double> input(field);
-    field.assign(field_size, 0.);
+    // normalized block columns are received again from the neighbors
+    safe_free(m_parallel_block_column_kernel_matrices);
+    m_matrix_normalization_agent->normalize(m_kernel_points,
+                                            m_nonlocal_kernel_points,
+                                            m_local_kernel_matrix,
+                                            m_parallel_block_row_kernel_matrices,
+                                            m_parallel_block_column_kernel_matrices,
+                                            m_processor_neighbors_below,
+                                            m_processor_neighbors_above);
+    build_parallel_matvec_plans();
+    compact_kernel_matrices();
+    m_pattern_support = support;
 
-    // local matrix vector product
-    m_local_kernel_matrix->matVec(input, field, true);
+    if(m_announce_radius && (m_authority->mpi_wrapper->get_rank() == 0u))
+    {
+        m_authority->utilities->print("Kernel Filter: updated kernel matrices over the existing sparsity pattern\n");
+    }
+    return true;
+}
+
+void KernelFilter::build_ghost_refresh_plan()
+{
+    // each neighbor is told which of its points are ghosted here
+    m_ghost_neighbor_ranks = m_processor_neighbors_below;
+    m_ghost_neighbor_ranks.insert(m_ghost_neighbor_ranks.end(),
+                                  m_processor_neighbors_above.begin(),
+                                  m_processor_neighbors_above.end());
+    const size_t num_neighbors = m_ghost_neighbor_ranks.size();
+    std::vector<std::vector<int> > send_counts(num_neighbors, std::vector<int>(1u, 0));
+    std::vector<std::vector<int> > recv_counts(num_neighbors, std::vector<int>(1u, 0));
+    std::vector<std::vector<int> > send_indexes(num_neighbors);
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        const size_t rank = m_ghost_neighbor_ranks[neighbor];
+        PointCloud* ghosts = m_nonlocal_kernel_points[rank];
+        const size_t num_ghosts = (ghosts ? ghosts->get_num_points() : 0u);
+        send_indexes[neighbor].resize(num_ghosts);
+        for(size_t ghost = 0u; ghost < num_ghosts; ghost++)
+        {
+            send_indexes[neighbor][ghost] = ghosts->get_index(ghost);
+        }
+        send_counts[neighbor][0] = num_ghosts;
+        m_authority->mpi_wrapper->ireceive(rank, recv_counts[neighbor]);
+        m_authority->mpi_wrapper->isend(rank, send_counts[neighbor]);
+    }
+    m_authority->mpi_wrapper->wait_all();
 
-    // parallel matrix vector product
-    for(size_t proc = 0; proc < mpi_size; proc++)
+    std::vector<std::vector<int> > recv_indexes(num_neighbors);
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
     {
-        AbstractInterface::SparseMatrix* blockRowMatrix = m_parallel_block_row_kernel_matrices[proc];
-        if(blockRowMatrix)
+        const size_t rank = m_ghost_neighbor_ranks[neighbor];
+        recv_indexes[neighbor].resize(recv_counts[neighbor][0]);
+        if(!recv_indexes[neighbor].empty())
+        {
+            m_authority->mpi_wrapper->ireceive(rank, recv_indexes[neighbor]);
+        }
+        if(!send_indexes[neighbor].empty())
         {
-            std::vector<double> data_to_send;
-            blockRowMatrix->matVecToReduced(input, data_to_send, true);
+            m_authority->mpi_wrapper->isend(rank, send_indexes[neighbor]);
+        }
+    }
+    m_authority->mpi_wrapper->wait_all();
 
-            std::vector<size_t> reducedVector;
-            blockRowMatrix->getNonZeroSortedRows(reducedVector);
-            const size_t num_reduced = reducedVector.size();
-            std::vector<double> data_to_recv(num_reduced);
+    m_ghost_requested_indexes.assign(num_neighbors, std::vector<size_t>());
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        m_ghost_requested_indexes[neighbor].assign(recv_indexes[neighbor].begin(), recv_indexes[neighbor].end());
+    }
+}
 
-            if(proc < mpi_rank)
+void KernelFilter::refresh_ghosted_kernel_points()
+{
+    // send current coordinates of the points each neighbor ghosts, receive those ghosted here
+    const size_t num_neighbors = m_ghost_neighbor_ranks.size();
+    std::vector<std::vector<double> > send_coordinates(num_neighbors);
+    std::vector<std::vector<double> > recv_coordinates(num_neighbors);
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        const size_t rank = m_ghost_neighbor_ranks[neighbor];
+        PointCloud* ghosts = m_nonlocal_kernel_points[rank];
+        recv_coordinates[neighbor].resize(3u * (ghosts ? ghosts->get_num_points() : 0u));
+        if(!recv_coordinates[neighbor].empty())
+        {
+            m_authority->mpi_wrapper->ireceive(rank, recv_coordinates[neighbor]);
+        }
+
+        const std::vector<size_t>& requested = m_ghost_requested_indexes[neighbor];
+        const size_t num_requested = requested.size();
+        send_coordinates[neighbor].resize(3u * num_requested);
+        for(size_t request = 0u; request < num_requested; request++)
+        {
+            for(size_t dimension = 0u; dimension < 3u; dimension++)
             {
-                m_authority->mpi_wrapper->send(proc, data_to_send);
-                m_authority->mpi_wrapper->receive(proc, data_to_recv);
+                send_coordinates[neighbor][3u * request + dimension] = m_kernel_points->get_coordinate(requested[request], dimension);
             }
-            else
+        }
+        if(!send_coordinates[neighbor].empty())
+        {
+            m_authority->mpi_wrapper->isend(rank, send_coordinates[neighbor]);
+        }
+    }
+    m_authority->mpi_wrapper->wait_all();
+
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        PointCloud* ghosts = m_nonlocal_kernel_points[m_ghost_neighbor_ranks[neighbor]];
+        const size_t num_ghosts = (ghosts ? ghosts->get_num_points() : 0u);
+        for(size_t ghost = 0u; ghost < num_ghosts; ghost++)
+        {
+            const std::vector<double> coordinates(&recv_coordinates[neighbor][3u * ghost],
+                                                  &recv_coordinates[neighbor][3u * ghost] + 3u);
+            ghosts->assign(ghost, Point(ghosts->get_index(ghost), coordinates));
+        }
+    }
+}
+
+AbstractInterface::SparseMatrix* KernelFilter::reweigh_kernel_matrix(AbstractInterface::SparseMatrix* matrix,
+                                                                     PointCloud* column_points,
+                                                                     bool column_is_center)
+{
+    // columns index the points by their index, which for ghosted points is the owner's
+    const size_t num_rows = matrix->getNumRows();
+    const size_t num_columns = matrix->getNumColumns();
+    const size_t num_column_points = column_points->get_num_points();
+    std::vector<size_t> column_to_point(num_columns, num_column_points);
+    for(size_t column_point = 0u; column_point < num_column_points; column_point++)
+    {
+        column_to_point[column_points->get_index(column_point)] = column_point;
+    }
+
+    // weights over the existing pattern
+    std::vector<size_t> row_bounds(num_rows + 1u, 0u);
+    std::vector<size_t> columns;
+    std::vector<double> weights;
+    std::vector<size_t> row_columns;
+    std::vector<double> row_weights;
+    bool all_positive = true;
+    for(size_t row = 0u; row < num_rows; row++)
+    {
+        matrix->getRow(row, row_weights, row_columns);
+        Point row_point = m_kernel_points->get_point(row);
+        const size_t num_row_nonzeros = row_columns.size();
+        for(size_t nonzero = 0u; nonzero < num_row_nonzeros; nonzero++)
+        {
+            const size_t column_point = column_to_point[row_columns[nonzero]];
+            if(column_point == num_column_points)
             {
-                m_authority->mpi_wrapper->receive(proc, data_to_recv);
-                m_authority->mpi_wrapper->send(proc, data_to_send);
+                m_authority->utilities->fatal_error("KernelFilter: kernel matrix column without a point during update. Aborting.\n\n");
             }
+            Point other_point = column_points->get_point(column_point);
+            const double weight = (column_is_center ? m_bounded_support_function->evaluate(&other_point, &row_point)
+                                                    : m_bounded_support_function->evaluate(&row_point, &other_point));
+            all_positive = all_positive && (weight > 0);
+            columns.push_back(row_columns[nonzero]);
+            weights.push_back(weight);
+        }
+        row_bounds[row + 1u] = columns.size();
+    }
+
+    // only weights changed, so set values in place
+    if(all_positive)
+    {
+        for(size_t row = 0u; row < num_rows; row++)
+        {
+            row_weights.assign(weights.begin() + row_bounds[row], weights.begin() + row_bounds[row + 1u]);
+            matrix->setRow(row, row_weights);
+        }
+        return matrix;
+    }
 
-            for(size_t reduced_index = 0; reduced_index < num_reduced; reduced_index++)
+    // otherwise filter the pattern down to the positive weights
+    const size_t num_repeats = m_authority->sparse_builder->get_number_of_passes_over_all_nonzero_entries();
+    m_authority->sparse_builder->begin_build(num_rows, num_columns);
+    for(size_t repeat = 0u; repeat < num_repeats; repeat++)
+    {
+        for(size_t row = 0u; row < num_rows; row++)
+        {
+            for(size_t nonzero = row_bounds[row]; nonzero < row_bounds[row + 1u]; nonzero++)
             {
-                const size_t local_id = reducedVector[reduced_index];
-                field[local_id] += data_to_recv[reduced_index];
+                if(weights[nonzero] > 0)
+                {
+                    m_authority->sparse_builder->specify_nonzero(row, columns[nonzero], weights[nonzero]);
+                }
             }
         }
+        m_authority->sparse_builder->advance_pass();
+    }
+    safe_free(matrix);
+    AbstractInterface::SparseMatrix* result = m_authority->sparse_builder->end_build();
+
+    // as when assembled, empty block matrices are not kept
+    if(result->getNumNonZeroSortedRows() == 0u)
+    {
+        safe_free(result);
+    }
+    return result;
+}
+
+bool KernelFilter::use_symmetric_storage()
+{
+    // weights of the polynomial tent are symmetric, and classical normalization is a row scaling;
+    // caches hold normalized matrices
+    if(!m_input_data->didUserInput_kernel_filter_symmetric_storage() || !m_input_data->get_kernel_filter_symmetric_storage()
+       || m_input_data->didUserInput_kernel_filter_cache_filename())
+    {
+        return false;
+    }
+    return (m_input_data->get_bounded_support_function() == bounded_support_function_t::polynomial_tent_function)
+           && (m_input_data->get_normalization() == normalization_t::classical_row_normalization);
+}
+
+void KernelFilter::build_symmetric_storage()
+{
+    // row sums of the unnormalized weights
+    const size_t num_rows = m_local_kernel_matrix->getNumRows();
+    std::vector<double> ones(num_rows, 1.);
+    std::vector<double> row_sums;
+    m_local_kernel_matrix->matVec(ones, row_sums, false);
+    const size_t num_procs = m_parallel_block_row_kernel_matrices.size();
+    for(size_t proc = 0u; proc < num_procs; proc++)
+    {
+        AbstractInterface::SparseMatrix* block_matrix = m_parallel_block_row_kernel_matrices[proc];
+        if(!block_matrix)
+        {
+            continue;
+        }
+        std::vector<double> block_ones(block_matrix->getNumColumns(), 1.);
+        std::vector<double> row_sum_contribution;
+        block_matrix->matVec(block_ones, row_sum_contribution, false);
+        axpy(1., row_sum_contribution, row_sums);
+    }
+    m_inverse_row_sums.resize(num_rows);
+    for(size_t row = 0u; row < num_rows; row++)
+    {
+        m_inverse_row_sums[row] = 1. / row_sums[row];
+    }
+
+    // by symmetry, a neighbor's rows of the weights are the transposed block row, so only those are kept
+    m_parallel_block_column_kernel_matrices.assign(num_procs, NULL);
+    for(size_t proc = 0u; proc < num_procs; proc++)
+    {
+        if(m_parallel_block_row_kernel_matrices[proc])
+        {
+            m_parallel_block_column_kernel_matrices[proc] = m_authority->sparse_builder->transpose(m_parallel_block_row_kernel_matrices[proc]);
+            safe_free(m_parallel_block_row_kernel_matrices[proc]);
+        }
+    }
+    m_built_symmetric = true;
+}
+
+void KernelFilter::scale_by_inverse_row_sums(std::vector<double>& field, size_t num_vectors)
+{
+    const size_t num_rows = m_inverse_row_sums.size();
+    for(size_t row = 0u; row < num_rows; row++)
+    {
+        for(size_t vector = 0u; vector < num_vectors; vector++)
+        {
+            field[row * num_vectors + vector] *= m_inverse_row_sums[row];
+        }
+    }
+}
+
+void KernelFilter::build_matrix_free_operator()
+{
+    // build ghosted kernel points
+    std::vector<PointCloud*> nonlocal_kernel_points;
+    std::vector<size_t> processor_neighbors_below;
+    std::vector<size_t> processor_neighbors_above;
+    m_point_ghosting_agent->share(m_bounded_support_function->get_support(),
+                                  m_kernel_points,
+                                  nonlocal_kernel_points,
+                                  processor_neighbors_below,
+                                  processor_neighbors_above);
+
+    m_matrix_free_operator = new MatrixFreeKernelOperator(m_authority, m_input_data);
+    m_matrix_free_operator->build(m_bounded_support_function,
+                                  m_kernel_points,
+                                  nonlocal_kernel_points,
+                                  processor_neighbors_below,
+                                  processor_neighbors_above);
+
+    // clean up
+    safe_free(nonlocal_kernel_points);
+    nonlocal_kernel_points.clear();
+}
+
+bool KernelFilter::build_structured_stencil_operator()
+{
+    // stencils replace kernel matrices only if requested, and not when matrices are wanted from a cache
+    if(!m_input_data->didUserInput_kernel_filter_structured_stencil() || !m_input_data->get_kernel_filter_structured_stencil())
+    {
+        return false;
+    }
+    if(m_input_data->didUserInput_kernel_filter_cache_filename()
+       || (m_input_data->get_normalization() != normalization_t::classical_row_normalization))
+    {
+        return false;
+    }
+
+    // every processor's kernel points must be a lattice, otherwise all processors assemble matrices
+    StructuredStencilKernelOperator* stencil_operator = new StructuredStencilKernelOperator(m_authority, m_input_data);
+    int local_is_structured = (stencil_operator->is_structured(m_kernel_points) ? 1 : 0);
+    int global_is_structured = 0;
+    m_authority->mpi_wrapper->all_reduce_min(local_is_structured, global_is_structured);
+    if(global_is_structured == 0)
+    {
+        safe_free(stencil_operator);
+        return false;
+    }
+
+    // build ghosted kernel points
+    std::vector<PointCloud*> nonlocal_kernel_points;
+    std::vector<size_t> processor_neighbors_below;
+    std::vector<size_t> processor_neighbors_above;
+    m_point_ghosting_agent->share(m_bounded_support_function->get_support(),
+                                  m_kernel_points,
+                                  nonlocal_kernel_points,
+                                  processor_neighbors_below,
+                                  processor_neighbors_above);
+
+    stencil_operator->build(m_bounded_support_function,
+                            m_kernel_points,
+                            nonlocal_kernel_points,
+                            processor_neighbors_below,
+                            processor_neighbors_above);
+    safe_free(nonlocal_kernel_points);
+    nonlocal_kernel_points.clear();
+
+    // ghosted points must also be a lattice on every processor, otherwise all processors assemble matrices
+    int local_uses_stencil = (stencil_operator->uses_stencil() ? 1 : 0);
+    int global_uses_stencil = 0;
+    m_authority->mpi_wrapper->all_reduce_min(local_uses_stencil, global_uses_stencil);
+    if(global_uses_stencil == 0)
+    {
+        safe_free(stencil_operator);
+        return false;
+    }
+    m_matrix_free_operator = stencil_operator;
+    m_built_as_structured_stencil = true;
+
+    if(m_announce_radius && (m_authority->mpi_wrapper->get_rank() == 0u))
+    {
+        m_authority->utilities->print("Kernel Filter: applying as a structured stencil\n");
+    }
+    return true;
+}
+
+void KernelFilter::build_parallel_matvec_plans()
+{
+    // no transpose receives contributions to the columns of the block column matrices,
+    // which is also how symmetric weights apply transposes
+    build_parallel_matvec_plan(m_parallel_block_column_kernel_matrices, false, m_noTranspose_plan);
+    if(m_built_symmetric)
+    {
+        return;
+    }
+
+    // transpose receives contributions to the rows of the block row matrices
+    build_parallel_matvec_plan(m_parallel_block_row_kernel_matrices, true, m_transpose_plan);
+
+    // optionally, transposed applies are by rows of stored transposes rather than scattering,
+    // at the memory of a second copy of the local and block row matrices
+    if(!m_input_data->didUserInput_kernel_filter_stored_transpose() || !m_input_data->get_kernel_filter_stored_transpose())
+    {
+        return;
+    }
+    m_local_kernel_matrix->storeTranspose();
+    const size_t num_transpose_neighbors = m_transpose_plan.m_neighbor_matrices.size();
+    for(size_t neighbor = 0; neighbor < num_transpose_neighbors; neighbor++)
+    {
+        m_transpose_plan.m_neighbor_matrices[neighbor]->storeTranspose();
+    }
+}
+
+void KernelFilter::compact_kernel_matrices()
+{
+    const bool single_precision = m_input_data->didUserInput_kernel_filter_single_precision()
+                                  && m_input_data->get_kernel_filter_single_precision();
+    const bool compact_storage = m_input_data->didUserInput_kernel_filter_compact_storage()
+                                 && m_input_data->get_kernel_filter_compact_storage();
+    if(!single_precision && !compact_storage)
+    {
+        return;
+    }
+
+    m_local_kernel_matrix->compactStorage(single_precision);
+    const size_t num_row_matrices = m_parallel_block_row_kernel_matrices.size();
+    for(size_t index = 0u; index < num_row_matrices; index++)
+    {
+        if(m_parallel_block_row_kernel_matrices[index])
+        {
+            m_parallel_block_row_kernel_matrices[index]->compactStorage(single_precision);
+        }
+    }
+    const size_t num_column_matrices = m_parallel_block_column_kernel_matrices.size();
+    for(size_t index = 0u; index < num_column_matrices; index++)
+    {
+        if(m_parallel_block_column_kernel_matrices[index])
+        {
+            m_parallel_block_column_kernel_matrices[index]->compactStorage(single_precision);
+        }
     }
 }
 
-void KernelFilter::parallel_matvec_apply_noTranspose(std::vector<double>& field)
+void KernelFilter::build_parallel_matvec_plan(const std::vector<AbstractInterface::SparseMatrix*>& block_matrices,
+                                              bool transpose,
+                                              ParallelMatvecPlan& plan)
+{
+    plan.m_neighbor_ranks.clear();
+    plan.m_neighbor_matrices.clear();
+    plan.m_reduced_indexes.clear();
+    plan.m_send_buffers.clear();
+    plan.m_recv_buffers.clear();
+
+    const size_t num_procs = block_matrices.size();
+    for(size_t proc = 0; proc < num_procs; proc++)
+    {
+        AbstractInterface::SparseMatrix* blockMatrix = block_matrices[proc];
+        if(!blockMatrix)
+        {
+            continue;
+        }
+
+        // the neighbor sends as many values as its block has nonzero rows (or columns), which
+        // match the nonzero rows (or columns) of this rank's block for that neighbor
+        std::vector<size_t> reducedVector;
+        if(transpose)
+        {
+            blockMatrix->getNonZeroSortedRows(reducedVector);
+        }
+        else
+        {
+            blockMatrix->getNonZeroSortedColumns(reducedVector);
+        }
+        const size_t num_reduced = reducedVector.size();
+        const size_t num_to_send = (transpose ? blockMatrix->getNumNonZeroSortedColumns() : blockMatrix->getNumNonZeroSortedRows());
+
+        plan.m_neighbor_ranks.push_back(proc);
+        plan.m_neighbor_matrices.push_back(blockMatrix);
+        plan.m_reduced_indexes.push_back(reducedVector);
+        plan.m_send_buffers.push_back(std::vector<double>(num_to_send, 0.));
+        plan.m_recv_buffers.push_back(std::vector<double>(num_reduced, 0.));
+    }
+}
+
+void KernelFilter::parallel_matvec_apply(std::vector<double>& field,
+                                         size_t num_vectors,
+                                         bool transpose,
+                                         ParallelMatvecPlan& plan)
 {
     const size_t field_size = field.size();
-    const size_t mpi_rank = m_authority->mpi_wrapper->get_rank();
-    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+    const size_t num_neighbors = plan.m_neighbor_ranks.size();
 
-    // separate input and output
-    std::vector<double> input(field);
+    // separate input and output, reusing storage between applies
+    m_matvec_input.swap(field);
     field.assign(field_size, 0.);
 
-    // local matrix vector product
-    m_local_kernel_matrix->matVec(input, field, false);
+    // post receives before any sends, all vectors packed in one message per neighbor
+    for(size_t neighbor = 0; neighbor < num_neighbors; neighbor++)
+    {
+        plan.m_recv_buffers[neighbor].resize(plan.m_reduced_indexes[neighbor].size() * num_vectors);
+        m_authority->mpi_wrapper->ireceive(plan.m_neighbor_ranks[neighbor], plan.m_recv_buffers[neighbor]);
+    }
 
-    // parallel matrix vector product
-    for(size_t proc = 0; proc < mpi_size; proc++)
+    // compute and send contributions to each neighbor
+    for(size_t neighbor = 0; neighbor < num_neighbors; neighbor++)
     {
-        AbstractInterface::SparseMatrix* blockColumnMatrix = m_parallel_block_column_kernel_matrices[proc];
-        if(blockColumnMatrix)
-        {
-            std::vector<double> data_to_send;
-            blockColumnMatrix->matVecToReduced(input, data_to_send, false);
+        plan.m_neighbor_matrices[neighbor]->matMultiVecToReduced(m_matvec_input,
+                                                                 plan.m_send_buffers[neighbor],
+                                                                 num_vectors,
+                                                                 transpose);
+        m_authority->mpi_wrapper->isend(plan.m_neighbor_ranks[neighbor], plan.m_send_buffers[neighbor]);
+    }
 
-            std::vector<size_t> reducedVector;
-            blockColumnMatrix->getNonZeroSortedColumns(reducedVector);
-            const size_t num_reduced = reducedVector.size();
-            std::vector<double> data_to_recv(num_reduced);
+    // local matrix vector product overlaps with communication
+    m_local_kernel_matrix->matMultiVec(m_matvec_input, field, num_vectors, transpose);
 
-            if(proc < mpi_rank)
-            {
-                m_authority->mpi_wrapper->send(proc, data_to_send);
-                m_authority->mpi_wrapper->receive(proc, data_to_recv);
-            }
-            else
+    // accumulate neighbor contributions in rank order
+    m_authority->mpi_wrapper->wait_all();
+    for(size_t neighbor = 0; neighbor < num_neighbors; neighbor++)
+    {
+        const std::vector<size_t>& reducedVector = plan.m_reduced_indexes[neighbor];
+        const std::vector<double>& data_to_recv = plan.m_recv_buffers[neighbor];
+        const size_t num_reduced = reducedVector.size();
+        for(size_t reduced_index = 0; reduced_index < num_reduced; reduced_index++)
+        {
+            const size_t local_id = reducedVector[reduced_index];
+            for(size_t vector = 0; vector < num_vectors; vector++)
             {
-                m_authority->mpi_wrapper->receive(proc, data_to_recv);
-                m_authority->mpi_wrapper->send(proc, data_to_send);
+                field[local_id * num_vectors + vector] += data_to_recv[reduced_index * num_vectors + vector];
             }
+        }
+    }
+}
 
-            for(size_t reduced_index = 0; reduced_index < num_reduced; reduced_index++)
-            {
-                const size_t local_id = reducedVector[reduced_index];
-                field[local_id] += data_to_recv[reduced_index];
-            }
+void KernelFilter::free_built_state()
+{
+    safe_free(m_bounded_support_function);
+    safe_free(m_mesh_scale_agent);
+    safe_free(m_symmetry_plane_agent);
+    safe_free(m_matrix_assembly_agent);
+    safe_free(m_matrix_normalization_agent);
+    safe_free(m_point_ghosting_agent);
+    safe_free(m_local_kernel_matrix);
+    safe_free(m_parallel_block_row_kernel_matrices);
+    m_parallel_block_row_kernel_matrices.clear();
+    safe_free(m_parallel_block_column_kernel_matrices);
+    m_parallel_block_column_kernel_matrices.clear();
+    m_transpose_plan = ParallelMatvecPlan();
+    m_noTranspose_plan = ParallelMatvecPlan();
+    safe_free(m_matrix_free_operator);
+    safe_free(m_kernel_points);
+    m_kernel_point_order.clear();
+    safe_free(m_nonlocal_kernel_points);
+    m_nonlocal_kernel_points.clear();
+    m_processor_neighbors_below.clear();
+    m_processor_neighbors_above.clear();
+    m_ghost_neighbor_ranks.clear();
+    m_ghost_requested_indexes.clear();
+    m_ghosting_support = -1.;
+    m_pattern_support = -1.;
+    m_inverse_row_sums.clear();
+    m_built_from_cache = false;
+    m_built_as_structured_stencil = false;
+    m_built_symmetric = false;
+}
+
+void KernelFilter::build_kernel_point_order()
+{
+    const size_t num_kernel_points = m_kernel_points->get_num_points();
+    if(num_kernel_points == 0u)
+    {
+        return;
+    }
+
+    // sort degenerate boxes at the points by Morton code
+    std::vector<AxisAlignedBoundingBox> point_boxes(num_kernel_points);
+    for(size_t kernel_point = 0u; kernel_point < num_kernel_points; kernel_point++)
+    {
+        point_boxes[kernel_point] = AxisAlignedBoundingBox(m_kernel_points->get_coordinate(kernel_point, 0u),
+                                                           m_kernel_points->get_coordinate(kernel_point, 1u),
+                                                           m_kernel_points->get_coordinate(kernel_point, 2u),
+                                                           kernel_point);
+    }
+    std::vector<int> sorted_indexes(num_kernel_points);
+    BoundingBoxMortonHierarchy morton_hierarchy;
+    morton_hierarchy.util_morton_sort_boxes(num_kernel_points, point_boxes, sorted_indexes);
+    m_kernel_point_order.assign(sorted_indexes.begin(), sorted_indexes.end());
+
+    // ghosting, assembly, and applies all proceed in the renumbered order
+    PointCloud* renumbered_kernel_points = permute_kernel_points(m_kernel_points, false);
+    safe_free(m_kernel_points);
+    m_kernel_points = renumbered_kernel_points;
+}
+
+PointCloud* KernelFilter::permute_kernel_points(PointCloud* kernel_points, bool inverse)
+{
+    const size_t num_kernel_points = m_kernel_point_order.size();
+    PointCloud* result = new PointCloud;
+    result->resize(num_kernel_points);
+    for(size_t position = 0u; position < num_kernel_points; position++)
+    {
+        const size_t kernel_point = m_kernel_point_order[position];
+        const size_t from = (inverse ? position : kernel_point);
+        const size_t to = (inverse ? kernel_point : position);
+        Point point = kernel_points->get_point(from);
+        point.set_index(to);
+        result->assign(to, point);
+    }
+    return result;
+}
+
+void KernelFilter::permute_field_at_kernel_points(const std::vector<double>& input,
+                                                  size_t num_vectors,
+                                                  bool inverse,
+                                                  std::vector<double>& output)
+{
+    const size_t num_kernel_points = m_kernel_point_order.size();
+    output.resize(input.size());
+    for(size_t position = 0u; position < num_kernel_points; position++)
+    {
+        const size_t kernel_point = m_kernel_point_order[position];
+        const size_t from = (inverse ? position : kernel_point);
+        const size_t to = (inverse ? kernel_point : position);
+        for(size_t vector = 0u; vector < num_vectors; vector++)
+        {
+            output[to * num_vectors + vector] = input[from * num_vectors + vector];
         }
     }
 }
@@ -628,6 +1467,12 @@ void KernelFilter::build_matrix_assembly_agent(matrix_assembly_agent_t::matrix_a
                                                                     m_input_data);
             break;
         }
+        case matrix_assembly_agent_t::by_row_single_pass:
+        {
+            m_matrix_assembly_agent = new ByRowSinglePass_MatrixAssemblyAgent(m_authority,
+                                                                              m_input_data);
+            break;
+        }
         case matrix_assembly_agent_t::unset_matrix_assembly_agent:
         default:
         {
@@ -679,6 +1524,11 @@ void KernelFilter::build_point_ghosting_agent(point_ghosting_agent_t::point_ghos
             m_point_ghosting_agent = new ByNarrowShare_PointGhostingAgent(m_authority);
             break;
         }
+        case point_ghosting_agent_t::by_neighbor_exchange:
+        {
+            m_point_ghosting_agent = new ByNeighborExchange_PointGhostingAgent(m_authority);
+            break;
+        }
         case point_ghosting_agent_t::unset_point_ghosting_agent:
         default:
         {
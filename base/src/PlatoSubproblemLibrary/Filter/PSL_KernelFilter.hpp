@@ -21,6 +21,7 @@
 #include "PSL_ParameterDataEnums.hpp"
 
 #include <vector>
+#include <string>
 #include <cstddef>
 
 namespace PlatoSubproblemLibrary
@@ -49,6 +50,7 @@ class Abstract_PointGhostingAgent;
 class PointCloud;
 class Abstract_BoundedSupportFunction;
 class AbstractAuthority;
+class MatrixFreeKernelOperator;
 
 class KernelFilter : public Filter
 {
@@ -67,28 +69,106 @@ public:
 
     void announce_radius();
     void enable_maintain_kernel_points();
+    // retain ghosted kernel points after build, so updates can reuse them; also requested by input data
+    void enable_incremental_update();
+    // distinguishes the cache of this kernel from others built with the same input data
+    void set_cache_tag(const std::string& tag);
 
     // Filter operations
     void build() override;
+    // rebuild after the radius input or the point coordinates changed. Assembled kernel matrices are
+    // reweighed over their existing sparsity pattern, reusing ghosted points and the communication
+    // plan, when the pattern still covers the new support; otherwise everything is built again.
+    void update() override;
     void apply(AbstractInterface::ParallelVector* field) override;
     void apply(AbstractInterface::ParallelVector* base_field, AbstractInterface::ParallelVector* gradient) override;
+    // batched applies, one matrix pass and one message per neighbor for all fields
+    void apply(const std::vector<AbstractInterface::ParallelVector*>& fields);
+    void apply(AbstractInterface::ParallelVector* base_field,
+               const std::vector<AbstractInterface::ParallelVector*>& gradients);
     bool is_valid(AbstractInterface::ParallelVector* field);
+    bool is_built_from_cache();
+    // whether applies are by structured stencil, which must be requested and holds on every processor or none
+    bool is_built_as_structured_stencil();
+    // whether applies are by symmetric weights and row scaling
+    bool is_built_symmetric();
+    // whether the last update reused the sparsity pattern
+    bool is_updated_incrementally();
 
     // to be used as utilities, use cautiously
     PointCloud* internal_transfer_kernel_points();
     std::vector<double> internal_get_field_at_kernel_points(AbstractInterface::ParallelVector* parallel_field);
     void internal_set_field_at_kernel_points(AbstractInterface::ParallelVector* parallel_field,
                                              const std::vector<double>& field_at_kernel_points);
+    // an apply is getting the field at the locally owned points, filtering them, then setting them
+    std::vector<double> internal_get_field_at_local_points(AbstractInterface::ParallelVector* parallel_field);
+    std::vector<double> internal_apply_at_local_points(const std::vector<double>& field_at_local_points, const bool transpose);
+    void internal_set_field_at_local_points(AbstractInterface::ParallelVector* parallel_field,
+                                            const std::vector<double>& field_at_local_points);
     std::vector<double> internal_parallel_matvec_apply(const std::vector<double>& input, const bool transpose);
+    std::vector<double> internal_parallel_matvec_apply(const std::vector<double>& input,
+                                                       const size_t num_vectors,
+                                                       const bool transpose);
 
 private:
 
     void internal_apply(AbstractInterface::ParallelVector* field, bool transpose);
-    void parallel_matvec_apply_transpose(std::vector<double>& field);
-    void parallel_matvec_apply_noTranspose(std::vector<double>& field);
+    void internal_apply(const std::vector<AbstractInterface::ParallelVector*>& fields, bool transpose);
+    void parallel_matvec_apply_transpose(std::vector<double>& field, size_t num_vectors);
+    void parallel_matvec_apply_noTranspose(std::vector<double>& field, size_t num_vectors);
+
+    // communication pattern of the parallel matrix-vector products, computed once per build
+    struct ParallelMatvecPlan
+    {
+        std::vector<size_t> m_neighbor_ranks;
+        std::vector<AbstractInterface::SparseMatrix*> m_neighbor_matrices;
+        std::vector<std::vector<size_t> > m_reduced_indexes;
+        std::vector<std::vector<double> > m_send_buffers;
+        std::vector<std::vector<double> > m_recv_buffers;
+    };
+    void build_kernel_matrices();
+    void assemble_kernel_matrices();
+    // false unless normalized weights are symmetric weights scaled by rows
+    bool use_symmetric_storage();
+    void build_symmetric_storage();
+    void scale_by_inverse_row_sums(std::vector<double>& field, size_t num_vectors);
+    void build_matrix_free_operator();
+    // false if the kernel points are not a lattice on every processor
+    bool build_structured_stencil_operator();
+    void build_parallel_matvec_plans();
+    // 32-bit column indexes, and single precision weights if requested
+    void compact_kernel_matrices();
+    void build_parallel_matvec_plan(const std::vector<AbstractInterface::SparseMatrix*>& block_matrices,
+                                    bool transpose,
+                                    ParallelMatvecPlan& plan);
+    void parallel_matvec_apply(std::vector<double>& field, size_t num_vectors, bool transpose, ParallelMatvecPlan& plan);
+    void free_built_state();
+
+    // renumber kernel points along a Morton curve, so kernel matrix rows and columns have spatial locality
+    void build_kernel_point_order();
+    // inverse restores the order of the symmetry plane agent
+    PointCloud* permute_kernel_points(PointCloud* kernel_points, bool inverse);
+    void permute_field_at_kernel_points(const std::vector<double>& input,
+                                        size_t num_vectors,
+                                        bool inverse,
+                                        std::vector<double>& output);
+
+    // false if the kernel matrices must be built again
+    bool update_kernel_matrices();
+    void build_ghost_refresh_plan();
+    void refresh_ghosted_kernel_points();
+    // recompute weights over the pattern of the matrix, dropping entries outside the support
+    AbstractInterface::SparseMatrix* reweigh_kernel_matrix(AbstractInterface::SparseMatrix* matrix,
+                                                           PointCloud* column_points,
+                                                           bool column_is_center);
 
     bool m_built;
     bool m_announce_radius;
+    bool m_built_from_cache;
+    bool m_built_as_structured_stencil;
+    bool m_built_symmetric;
+    bool m_updated_incrementally;
+    std::string m_cache_tag;
 
     // required functionalities
     void check_required_functionalities();
@@ -120,10 +200,33 @@ private:
     AbstractInterface::SparseMatrix* m_local_kernel_matrix;
     std::vector<AbstractInterface::SparseMatrix*> m_parallel_block_row_kernel_matrices;
     std::vector<AbstractInterface::SparseMatrix*> m_parallel_block_column_kernel_matrices;
+    ParallelMatvecPlan m_transpose_plan;
+    ParallelMatvecPlan m_noTranspose_plan;
+    std::vector<double> m_matvec_input;
+
+    // if built symmetric, matrices hold unnormalized weights, block columns hold each neighbor's rows,
+    // and normalization is by these row scalings
+    std::vector<double> m_inverse_row_sums;
+
+    // replaces the kernel matrices when applies are matrix-free or by structured stencil
+    MatrixFreeKernelOperator* m_matrix_free_operator;
 
     // kernel points for transfer
     bool m_maintain_kernel_points;
     PointCloud* m_kernel_points;
+    // kernel point of the symmetry plane agent at each renumbered position, empty if not renumbered
+    std::vector<size_t> m_kernel_point_order;
+
+    // retained for incremental updates; supports are negative unless retained
+    bool m_incremental_update;
+    double m_ghosting_support;
+    double m_pattern_support;
+    std::vector<PointCloud*> m_nonlocal_kernel_points;
+    std::vector<size_t> m_processor_neighbors_below;
+    std::vector<size_t> m_processor_neighbors_above;
+    // indexes of local kernel points ghosted by each neighbor
+    std::vector<size_t> m_ghost_neighbor_ranks;
+    std::vector<std::vector<size_t> > m_ghost_requested_indexes;
 };
 
 }
@@ -0,0 +1,339 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_KernelFilterCache.hpp"
+
+#include "PSL_Abstract_GlobalUtilities.hpp"
+#include "PSL_Abstract_MpiWrapper.hpp"
+#include "PSL_Abstract_SparseMatrix.hpp"
+#include "PSL_Abstract_SparseMatrixBuilder.hpp"
+#include "PSL_ParameterData.hpp"
+#include "PSL_ParameterDataEnums.hpp"
+#include "PSL_PointCloud.hpp"
+#include "PSL_Point.hpp"
+#include "PSL_FreeHelpers.hpp"
+#include "PSL_AbstractAuthority.hpp"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace PlatoSubproblemLibrary
+{
+
+// bump when the file layout or the hashed content changes
+static const uint64_t s_kernel_filter_cache_version = 2u;
+static const uint64_t s_fnv_offset_basis = 14695981039346656037ull;
+static const uint64_t s_fnv_prime = 1099511628211ull;
+
+template<typename T>
+static void write_value(std::ofstream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+template<typename T>
+static void write_vector(std::ofstream& stream, const std::vector<T>& values)
+{
+    if(!values.empty())
+    {
+        stream.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+    }
+}
+template<typename T>
+static bool read_value(std::ifstream& stream, T& value)
+{
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return bool(stream);
+}
+template<typename T>
+static bool read_vector(std::ifstream& stream, std::vector<T>& values)
+{
+    if(!values.empty())
+    {
+        stream.read(reinterpret_cast<char*>(values.data()), sizeof(T) * values.size());
+    }
+    return bool(stream);
+}
+
+KernelFilterCache::KernelFilterCache(AbstractAuthority* authority, const std::string& base_filename, const std::string& tag) :
+        m_authority(authority),
+        m_base_filename(base_filename),
+        m_tag(tag),
+        m_key(s_fnv_offset_basis)
+{
+}
+
+KernelFilterCache::~KernelFilterCache()
+{
+    m_authority = NULL;
+}
+
+void KernelFilterCache::compute_key(PointCloud* kernel_points, double support_distance, ParameterData* input_data)
+{
+    // hash local content
+    m_key = s_fnv_offset_basis;
+    const uint64_t mpi_rank = m_authority->mpi_wrapper->get_rank();
+    const uint64_t mpi_size = m_authority->mpi_wrapper->get_size();
+    hash(&s_kernel_filter_cache_version, sizeof(uint64_t));
+    hash(&mpi_rank, sizeof(uint64_t));
+    hash(&mpi_size, sizeof(uint64_t));
+    const uint64_t num_points = kernel_points->get_num_points();
+    hash(&num_points, sizeof(uint64_t));
+    for(size_t point_index = 0u; point_index < num_points; point_index++)
+    {
+        const double coordinates[3] = {kernel_points->get_coordinate(point_index, 0u),
+                                       kernel_points->get_coordinate(point_index, 1u),
+                                       kernel_points->get_coordinate(point_index, 2u)};
+        const uint64_t index = kernel_points->get_index(point_index);
+        hash(coordinates, 3u * sizeof(double));
+        hash(&index, sizeof(uint64_t));
+    }
+    hash(&support_distance, sizeof(double));
+    const double penalty = input_data->get_penalty();
+    hash(&penalty, sizeof(double));
+    const int options[4] = {int(input_data->get_normalization()),
+                            int(input_data->get_reproduction()),
+                            int(input_data->get_matrix_normalization_agent()),
+                            int(input_data->get_bounded_support_function())};
+    hash(options, 4u * sizeof(int));
+
+    // overhang kernels depend on the angle and build direction, unset parameters hash as zero
+    const double overhang_parameters[4] =
+        {(input_data->didUserInput_max_overhang_angle() ? input_data->get_max_overhang_angle() : 0.),
+         (input_data->didUserInput_build_direction_x() ? input_data->get_build_direction_x() : 0.),
+         (input_data->didUserInput_build_direction_y() ? input_data->get_build_direction_y() : 0.),
+         (input_data->didUserInput_build_direction_z() ? input_data->get_build_direction_z() : 0.)};
+    hash(overhang_parameters, 4u * sizeof(double));
+    const uint64_t tag_length = m_tag.size();
+    hash(&tag_length, sizeof(uint64_t));
+    hash(m_tag.data(), m_tag.size());
+
+    // combine local keys of all ranks, so a change in any partition invalidates every cache
+    std::vector<int> local_key = {int(m_key & 0xffffffffu), int(m_key >> 32)};
+    std::vector<int> global_keys(2u * mpi_size);
+    m_authority->mpi_wrapper->all_gather(local_key, global_keys);
+    m_key = s_fnv_offset_basis;
+    hash(global_keys.data(), global_keys.size() * sizeof(int));
+}
+
+bool KernelFilterCache::load(AbstractInterface::SparseMatrix** local_kernel_matrix,
+                             std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+                             std::vector<AbstractInterface::SparseMatrix*>& parallel_block_column_kernel_matrices)
+{
+    *local_kernel_matrix = NULL;
+    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+    parallel_block_row_kernel_matrices.assign(mpi_size, NULL);
+    parallel_block_column_kernel_matrices.assign(mpi_size, NULL);
+
+    int local_loaded = (internal_load(local_kernel_matrix,
+                                      parallel_block_row_kernel_matrices,
+                                      parallel_block_column_kernel_matrices) ? 1 : 0);
+    int global_loaded = 0;
+    m_authority->mpi_wrapper->all_reduce_min(local_loaded, global_loaded);
+    if(global_loaded == 1)
+    {
+        return true;
+    }
+
+    // some rank missed, discard anything loaded
+    safe_free(*local_kernel_matrix);
+    safe_free(parallel_block_row_kernel_matrices);
+    safe_free(parallel_block_column_kernel_matrices);
+    parallel_block_row_kernel_matrices.clear();
+    parallel_block_column_kernel_matrices.clear();
+    return false;
+}
+
+void KernelFilterCache::save(AbstractInterface::SparseMatrix* local_kernel_matrix,
+                             const std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+                             const std::vector<AbstractInterface::SparseMatrix*>& parallel_block_column_kernel_matrices)
+{
+    // write aside and rename, so an interrupted save never leaves a partial cache
+    const std::string filename = get_filename();
+    const std::string temporary_filename = filename + ".tmp";
+    std::ofstream stream(temporary_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!stream.is_open())
+    {
+        m_authority->utilities->print("KernelFilterCache: unable to open \"" + temporary_filename + "\" for writing. Warning.\n\n");
+        return;
+    }
+
+    const uint64_t mpi_size = m_authority->mpi_wrapper->get_size();
+    write_value(stream, s_kernel_filter_cache_version);
+    write_value(stream, m_key);
+    write_value(stream, mpi_size);
+    write_matrix(stream, local_kernel_matrix);
+    for(size_t proc = 0u; proc < mpi_size; proc++)
+    {
+        write_matrix(stream, (proc < parallel_block_row_kernel_matrices.size() ? parallel_block_row_kernel_matrices[proc] : NULL));
+        write_matrix(stream, (proc < parallel_block_column_kernel_matrices.size() ? parallel_block_column_kernel_matrices[proc] : NULL));
+    }
+    stream.close();
+
+    if(stream.fail() || (std::rename(temporary_filename.c_str(), filename.c_str()) != 0))
+    {
+        std::remove(temporary_filename.c_str());
+        m_authority->utilities->print("KernelFilterCache: unable to write \"" + filename + "\". Warning.\n\n");
+    }
+}
+
+std::string KernelFilterCache::get_filename()
+{
+    const size_t mpi_rank = m_authority->mpi_wrapper->get_rank();
+    const size_t mpi_size = m_authority->mpi_wrapper->get_size();
+    const std::string tag = (m_tag.empty() ? std::string() : "." + m_tag);
+    return m_base_filename + tag + "." + std::to_string(mpi_size) + "." + std::to_string(mpi_rank);
+}
+
+void KernelFilterCache::hash(const void* data, size_t num_bytes)
+{
+    // FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for(size_t byte = 0u; byte < num_bytes; byte++)
+    {
+        m_key ^= uint64_t(bytes[byte]);
+        m_key *= s_fnv_prime;
+    }
+}
+
+bool KernelFilterCache::internal_load(AbstractInterface::SparseMatrix** local_kernel_matrix,
+                                      std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+                                      std::vector<AbstractInterface::SparseMatrix*>& parallel_block_column_kernel_matrices)
+{
+    std::ifstream stream(get_filename().c_str(), std::ios::in | std::ios::binary);
+    if(!stream.is_open())
+    {
+        return false;
+    }
+
+    // check header
+    uint64_t version = 0u;
+    uint64_t key = 0u;
+    uint64_t mpi_size = 0u;
+    if(!read_value(stream, version) || !read_value(stream, key) || !read_value(stream, mpi_size))
+    {
+        return false;
+    }
+    if((version != s_kernel_filter_cache_version) || (key != m_key) || (mpi_size != m_authority->mpi_wrapper->get_size()))
+    {
+        return false;
+    }
+
+    // read matrices
+    if(!read_matrix(stream, local_kernel_matrix) || (*local_kernel_matrix == NULL))
+    {
+        return false;
+    }
+    for(size_t proc = 0u; proc < mpi_size; proc++)
+    {
+        if(!read_matrix(stream, &parallel_block_row_kernel_matrices[proc])
+           || !read_matrix(stream, &parallel_block_column_kernel_matrices[proc]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void KernelFilterCache::write_matrix(std::ofstream& stream, AbstractInterface::SparseMatrix* matrix)
+{
+    const uint64_t is_present = (matrix ? 1u : 0u);
+    write_value(stream, is_present);
+    if(!matrix)
+    {
+        return;
+    }
+
+    // gather compressed rows
+    const uint64_t num_rows = matrix->getNumRows();
+    const uint64_t num_columns = matrix->getNumColumns();
+    std::vector<uint64_t> row_bounds(1u, 0u);
+    std::vector<uint64_t> columns;
+    std::vector<double> data;
+    std::vector<double> row_data;
+    std::vector<size_t> row_columns;
+    for(size_t row = 0u; row < num_rows; row++)
+    {
+        matrix->getRow(row, row_data, row_columns);
+        columns.insert(columns.end(), row_columns.begin(), row_columns.end());
+        data.insert(data.end(), row_data.begin(), row_data.end());
+        row_bounds.push_back(columns.size());
+    }
+    const uint64_t num_nonzeros = data.size();
+
+    write_value(stream, num_rows);
+    write_value(stream, num_columns);
+    write_value(stream, num_nonzeros);
+    write_vector(stream, row_bounds);
+    write_vector(stream, columns);
+    write_vector(stream, data);
+}
+
+bool KernelFilterCache::read_matrix(std::ifstream& stream, AbstractInterface::SparseMatrix** matrix)
+{
+    *matrix = NULL;
+    uint64_t is_present = 0u;
+    if(!read_value(stream, is_present))
+    {
+        return false;
+    }
+    if(is_present == 0u)
+    {
+        return true;
+    }
+
+    uint64_t num_rows = 0u;
+    uint64_t num_columns = 0u;
+    uint64_t num_nonzeros = 0u;
+    if(!read_value(stream, num_rows) || !read_value(stream, num_columns) || !read_value(stream, num_nonzeros))
+    {
+        return false;
+    }
+    std::vector<uint64_t> row_bounds(num_rows + 1u);
+    std::vector<uint64_t> columns(num_nonzeros);
+    std::vector<double> data(num_nonzeros);
+    if(!read_vector(stream, row_bounds) || !read_vector(stream, columns) || !read_vector(stream, data))
+    {
+        return false;
+    }
+
+    // validate structure before building
+    if((row_bounds[0] != 0u) || (row_bounds[num_rows] != num_nonzeros))
+    {
+        return false;
+    }
+    for(size_t row = 0u; row < num_rows; row++)
+    {
+        if(row_bounds[row + 1u] < row_bounds[row])
+        {
+            return false;
+        }
+    }
+    for(size_t nz = 0u; nz < num_nonzeros; nz++)
+    {
+        if(num_columns <= columns[nz])
+        {
+            return false;
+        }
+    }
+
+    // build
+    const size_t num_repeats = m_authority->sparse_builder->get_number_of_passes_over_all_nonzero_entries();
+    m_authority->sparse_builder->begin_build(num_rows, num_columns);
+    for(size_t repeat = 0u; repeat < num_repeats; repeat++)
+    {
+        for(size_t row = 0u; row < num_rows; row++)
+        {
+            for(size_t nz = row_bounds[row]; nz < row_bounds[row + 1u]; nz++)
+            {
+                m_authority->sparse_builder->specify_nonzero(row, columns[nz], data[nz]);
+            }
+        }
+        m_authority->sparse_builder->advance_pass();
+    }
+    *matrix = m_authority->sparse_builder->end_build();
+    return true;
+}
+
+}
@@ -0,0 +1,64 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Class: on-disk cache of assembled kernel filter matrices.
+*
+* Each rank saves its local matrix and its parallel block row and block column matrices
+* to its own binary file. The files are keyed by a hash of the kernel points of every rank,
+* the support radius, and the options the matrices depend on, so a later run on the same
+* mesh, partitioning, and options may load the matrices instead of assembling them.
+* Kernels built from the same input data, such as the two kernels of an overhang filter,
+* are told apart by a tag that is part of both the filename and the key.
+*/
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+
+namespace PlatoSubproblemLibrary
+{
+namespace AbstractInterface
+{
+class SparseMatrix;
+}
+class PointCloud;
+class ParameterData;
+class AbstractAuthority;
+
+class KernelFilterCache
+{
+public:
+    KernelFilterCache(AbstractAuthority* authority, const std::string& base_filename, const std::string& tag = std::string());
+    ~KernelFilterCache();
+
+    // collectively hash kernel points of all ranks with the options the matrices depend on
+    void compute_key(PointCloud* kernel_points, double support_distance, ParameterData* input_data);
+
+    // collectively load, only if every rank finds a cache matching the key
+    bool load(AbstractInterface::SparseMatrix** local_kernel_matrix,
+              std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+              std::vector<AbstractInterface::SparseMatrix*>& parallel_block_column_kernel_matrices);
+    void save(AbstractInterface::SparseMatrix* local_kernel_matrix,
+              const std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+              const std::vector<AbstractInterface::SparseMatrix*>& parallel_block_column_kernel_matrices);
+
+    std::string get_filename();
+
+protected:
+    void hash(const void* data, size_t num_bytes);
+    bool internal_load(AbstractInterface::SparseMatrix** local_kernel_matrix,
+                       std::vector<AbstractInterface::SparseMatrix*>& parallel_block_row_kernel_matrices,
+                       std::vector<AbstractInterface::SparseMatrix*>& parallel_block_column_kernel_matrices);
+    void write_matrix(std::ofstream& stream, AbstractInterface::SparseMatrix* matrix);
+    bool read_matrix(std::ifstream& stream, AbstractInterface::SparseMatrix** matrix);
+
+    AbstractAuthority* m_authority;
+    std::string m_base_filename;
+    std::string m_tag;
+    uint64_t m_key;
+
+};
+
+}
@@ -1,25 +1,38 @@
 // PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
 #include "PSL_KernelThenHeavisideFilter.hpp"
 #include "PSL_FreeHelpers.hpp"
-#include "PSL_Interface_ParallelVector.hpp"
+#include "PSL_Abstract_ParallelVector.hpp"
 
 namespace PlatoSubproblemLibrary
 {
 
 void KernelThenHeavisideFilter::projection_apply(const double& beta, AbstractInterface::ParallelVector* field) const
 {
-    auto tFieldLength = field->get_length();
+    AbstractInterface::ParallelVectorView tField(field);
+    const size_t tFieldLength = tField.size();
+    double* tFieldData = tField.data();
     for(size_t i = 0; i < tFieldLength; ++i)
     {
-        field->set_value(i,heaviside_apply(beta,field->get_value(i)));
+        tFieldData[i] = heaviside_apply(beta, tFieldData[i]);
     }
 }
 void KernelThenHeavisideFilter::projection_gradient(const double& beta, AbstractInterface::ParallelVector* const field, AbstractInterface::ParallelVector* gradient) const
 {
-    size_t tLength = gradient->get_length();
+    const AbstractInterface::ParallelVectorView tField(field, true);
+    AbstractInterface::ParallelVectorView tGradient(gradient);
+    const size_t tLength = tGradient.size();
+    double* tGradientData = tGradient.data();
     for(size_t i = 0u; i < tLength; ++i)
     {
-        gradient->set_value(i, gradient->get_value(i)*heaviside_gradient(beta,field->get_value(i)));
+        tGradientData[i] *= heaviside_gradient(beta, tField[i]);
+    }
+}
+void KernelThenHeavisideFilter::projection_apply_with_derivative(const double& beta, double* values, double* derivatives, size_t length) const
+{
+    for(size_t i = 0u; i < length; ++i)
+    {
+        derivatives[i] = heaviside_gradient(beta, values[i]);
+        values[i] = heaviside_apply(beta, values[i]);
     }
 }
 
@@ -44,6 +44,7 @@ private:
 
     void projection_apply(const double& beta, AbstractInterface::ParallelVector* field) const override;
     void projection_gradient(const double& beta, AbstractInterface::ParallelVector* const field, AbstractInterface::ParallelVector* gradient) const override;
+    void projection_apply_with_derivative(const double& beta, double* values, double* derivatives, size_t length) const override;
 
 };
 
@@ -1,6 +1,8 @@
 // PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
 #include "PSL_KernelThenStructuredAMFilter.hpp"
 #include "PSL_Abstract_ParallelVector.hpp"
+#include "PSL_Abstract_MpiWrapper.hpp"
+#include "PSL_AbstractAuthority.hpp"
 #include "PSL_FreeHelpers.hpp"
 #include "PSL_Point.hpp"
 #include "PSL_Vector.hpp"
@@ -20,39 +22,53 @@ void KernelThenStructuredAMFilter::internal_apply(AbstractInterface::ParallelVec
     if(aDensity->get_length() != tCoordinates.size())
         throw(std::domain_error("Provided density field does not match the mesh size"));
 
-    // std::cout << "Compute Grid Blueprint Density" << std::endl;
-    std::vector<double> tGridBlueprintDensity;
-    mAMFilterUtilities->computeGridBlueprintDensity(aDensity,tGridBlueprintDensity); 
-    // std::cout << "Compute Grid Printable Density" << std::endl;
-    std::vector<double> tGridPrintableDensity;
-    mAMFilterUtilities->computeGridPrintableDensity(tGridBlueprintDensity,tGridPrintableDensity);
-    // std::cout << "Compute Tet Mesh Printable Density" << std::endl;
-    mAMFilterUtilities->computeTetMeshPrintableDensity(tGridPrintableDensity,aDensity);
+    mColumnPartition->computeTetMeshPrintableDensity(aDensity);
 }
 
 void KernelThenStructuredAMFilter::internal_gradient(AbstractInterface::ParallelVector* const aBlueprintDensity, AbstractInterface::ParallelVector* aGradient) const
 {
-    //apply chain rule to 3 transformations - T2G, AMFilterGrid, G2T 
-    //i.e. printableDensity = computeTetMeshPrintableDensity(computeGridPrintableDensity(computeGridBlueprintDensity(aBlueprintDensity)))
+    if(!mFilterBuilt)
+        throw(std::runtime_error("KernelThenStructuredAMFilter: Filter not built before attempting to apply filter gradient"));
+
+    const std::vector<std::vector<double>>& tCoordinates = mTetUtilities->getCoordinates();
+
+    if(aBlueprintDensity->get_length() != tCoordinates.size() || aGradient->get_length() != tCoordinates.size())
+        throw(std::domain_error("Provided density field or gradient does not match the mesh size"));
+
+    // apply chain rule to 3 transformations in reverse - G2T, AMFilterGrid, T2G
+    mColumnPartition->computeTetMeshBlueprintDensityGradient(aBlueprintDensity,aGradient);
 }
 
 void KernelThenStructuredAMFilter::buildStructuredGrid(const std::vector<std::vector<double>>& aCoordinates, const std::vector<std::vector<int>>& aConnectivity)
 {
     mTetUtilities = std::unique_ptr<TetMeshUtilities>(new TetMeshUtilities(aCoordinates,aConnectivity));
 
+    // every processor builds the same grid, spanning the whole mesh
     Vector aMaxUVWCoords, aMinUVWCoords;
     mTetUtilities->computeBoundingBox(mUBasisVector,mVBasisVector,mBuildDirection,aMaxUVWCoords,aMinUVWCoords);
-    double aTargetEdgeLength = mTetUtilities->computeMinEdgeLength()/4.0;
-
-    std::cout << "TargetEdgeLength: " << aTargetEdgeLength << std::endl;
-
-    mGridUtilities = std::unique_ptr<OrthogonalGridUtilities>(new OrthogonalGridUtilities(mUBasisVector,mVBasisVector,mBuildDirection,aMaxUVWCoords,aMinUVWCoords,aTargetEdgeLength));
+    std::vector<double> tLocalMaxUVWCoords = {aMaxUVWCoords(0), aMaxUVWCoords(1), aMaxUVWCoords(2)};
+    std::vector<double> tLocalMinUVWCoords = {aMinUVWCoords(0), aMinUVWCoords(1), aMinUVWCoords(2)};
+    std::vector<double> tGlobalMaxUVWCoords(3), tGlobalMinUVWCoords(3);
+    mAuthority->mpi_wrapper->all_reduce_max(tLocalMaxUVWCoords,tGlobalMaxUVWCoords);
+    mAuthority->mpi_wrapper->all_reduce_min(tLocalMinUVWCoords,tGlobalMinUVWCoords);
+    aMaxUVWCoords = Vector(tGlobalMaxUVWCoords);
+    aMinUVWCoords = Vector(tGlobalMinUVWCoords);
+
+    double tLocalTargetEdgeLength = mTetUtilities->computeMinEdgeLength()/4.0;
+    double aTargetEdgeLength = 0;
+    mAuthority->mpi_wrapper->all_reduce_min(tLocalTargetEdgeLength,aTargetEdgeLength);
 
     double tPNorm = mInputData->get_smooth_max_p_norm();
 
-    std::cout << "P Norm: " << tPNorm << std::endl;
+    if(mAuthority->mpi_wrapper->is_root())
+    {
+        std::cout << "TargetEdgeLength: " << aTargetEdgeLength << std::endl;
+        std::cout << "P Norm: " << tPNorm << std::endl;
+    }
+
+    mGridUtilities = std::unique_ptr<OrthogonalGridUtilities>(new OrthogonalGridUtilities(mUBasisVector,mVBasisVector,mBuildDirection,aMaxUVWCoords,aMinUVWCoords,aTargetEdgeLength));
 
-    mAMFilterUtilities = std::unique_ptr<AMFilterUtilities>(new AMFilterUtilities( *(mTetUtilities.get()) , *(mGridUtilities.get()), tPNorm));
+    mColumnPartition = std::unique_ptr<AMFilterColumnPartition>(new AMFilterColumnPartition(mAuthority, *(mTetUtilities.get()), *(mGridUtilities.get()), tPNorm));
 
     mFilterBuilt = true;
 }
@@ -14,7 +14,7 @@
 #include "PSL_Point.hpp"
 #include "PSL_TetMeshUtilities.hpp"
 #include "PSL_OrthogonalGridUtilities.hpp"
-#include "PSL_AMFilterUtilities.hpp"
+#include "PSL_AMFilterColumnPartition.hpp"
 
 
 #include <vector>
@@ -46,10 +46,12 @@ public:
                               AbstractInterface::PointCloud* points,
                               AbstractInterface::ParallelExchanger* exchanger)
                             : AbstractKernelThenFilter(authority, data, points, exchanger),
+                              mAuthority(authority),
                               mInputData(data){}
 
     virtual ~KernelThenStructuredAMFilter()
     {
+        mAuthority = NULL;
         mInputData = NULL;
         // delete mAMFilterUtilities;
         // mAMFilterUtilities = NULL;
@@ -113,11 +115,13 @@ private:
 
     bool mFilterBuilt = false;
 
+    AbstractAuthority* mAuthority;
     ParameterData* mInputData;
 
+    // the mesh is this processor's part, the grid spans the whole mesh and is split into columns across processors
     std::unique_ptr<TetMeshUtilities> mTetUtilities;
     std::unique_ptr<OrthogonalGridUtilities> mGridUtilities;
-    std::unique_ptr<AMFilterUtilities> mAMFilterUtilities;
+    std::unique_ptr<AMFilterColumnPartition> mColumnPartition;
     // TetMeshUtilities* mTetUtilities;
     // OrthogonalGridUtilities* mGridUtilities;
     // AMFilterUtilities* mAMFilterUtilities;
@@ -1,7 +1,7 @@
 // PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
 #include "PSL_KernelThenTANHFilter.hpp"
 #include "PSL_FreeHelpers.hpp"
-#include "PSL_Interface_ParallelVector.hpp"
+#include "PSL_Abstract_ParallelVector.hpp"
 
 
 namespace PlatoSubproblemLibrary
@@ -9,18 +9,31 @@ namespace PlatoSubproblemLibrary
 
 void KernelThenTANHFilter::projection_apply(const double& beta, AbstractInterface::ParallelVector* field) const
 {
-    auto tFieldLength = field->get_length();
+    AbstractInterface::ParallelVectorView tField(field);
+    const size_t tFieldLength = tField.size();
+    double* tFieldData = tField.data();
     for(size_t i = 0; i < tFieldLength; ++i)
     {
-        field->set_value(i,tanh_apply(beta,field->get_value(i)));
+        tFieldData[i] = tanh_apply(beta, tFieldData[i]);
     }
 }
 void KernelThenTANHFilter::projection_gradient(const double& beta, AbstractInterface::ParallelVector* const field, AbstractInterface::ParallelVector* gradient) const
 {
-    size_t tLength = gradient->get_length();
+    const AbstractInterface::ParallelVectorView tField(field, true);
+    AbstractInterface::ParallelVectorView tGradient(gradient);
+    const size_t tLength = tGradient.size();
+    double* tGradientData = tGradient.data();
     for(size_t i = 0u; i < tLength; ++i)
     {
-        gradient->set_value(i, gradient->get_value(i)*tanh_gradient(beta,field->get_value(i)));
+        tGradientData[i] *= tanh_gradient(beta, tField[i]);
+    }
+}
+void KernelThenTANHFilter::projection_apply_with_derivative(const double& beta, double* values, double* derivatives, size_t length) const
+{
+    for(size_t i = 0u; i < length; ++i)
+    {
+        derivatives[i] = tanh_gradient(beta, values[i]);
+        values[i] = tanh_apply(beta, values[i]);
     }
 }
 
@@ -0,0 +1,342 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_MatrixFreeKernelOperator.hpp"
+
+#include "PSL_Abstract_GlobalUtilities.hpp"
+#include "PSL_Abstract_MpiWrapper.hpp"
+#include "PSL_Abstract_FixedRadiusNearestNeighborsSearcher.hpp"
+#include "PSL_Abstract_BoundedSupportFunction.hpp"
+#include "PSL_SpatialSearcherFactory.hpp"
+#include "PSL_ParameterData.hpp"
+#include "PSL_ParameterDataEnums.hpp"
+#include "PSL_PointCloud.hpp"
+#include "PSL_Point.hpp"
+#include "PSL_FreeHelpers.hpp"
+#include "PSL_AbstractAuthority.hpp"
+
+#include <cassert>
+#include <vector>
+#include <cstddef>
+#include <algorithm> // for sort, merge
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace PlatoSubproblemLibrary
+{
+
+MatrixFreeKernelOperator::MatrixFreeKernelOperator(AbstractAuthority* authority, ParameterData* input_data) :
+        m_authority(authority),
+        m_input_data(input_data),
+        m_bounded_support_function(NULL),
+        m_searcher(NULL),
+        m_points(NULL),
+        m_num_local_points(0u),
+        m_inverse_row_sums(),
+        m_row_buffer_size(0u),
+        m_neighbors_buffers(),
+        m_neighbor_ranks(),
+        m_ghost_offsets(),
+        m_send_indexes(),
+        m_send_buffers(),
+        m_recv_buffers(),
+        m_values()
+{
+}
+
+MatrixFreeKernelOperator::~MatrixFreeKernelOperator()
+{
+    m_authority = NULL;
+    m_input_data = NULL;
+    m_bounded_support_function = NULL;
+    safe_free(m_searcher);
+    safe_free(m_points);
+}
+
+void MatrixFreeKernelOperator::build(Abstract_BoundedSupportFunction* bounded_support_function,
+                                     PointCloud* kernel_points,
+                                     std::vector<PointCloud*>& nonlocal_kernel_points,
+                                     const std::vector<size_t>& processor_neighbors_below,
+                                     const std::vector<size_t>& processor_neighbors_above)
+{
+    if(m_input_data->get_normalization() != normalization_t::classical_row_normalization)
+    {
+        m_authority->utilities->fatal_error("MatrixFreeKernelOperator: only classical row normalization is supported. Aborting.\n\n");
+    }
+    m_bounded_support_function = bounded_support_function;
+
+    // neighbors in rank order
+    m_neighbor_ranks.resize(processor_neighbors_below.size() + processor_neighbors_above.size());
+    std::merge(processor_neighbors_below.begin(),
+               processor_neighbors_below.end(),
+               processor_neighbors_above.begin(),
+               processor_neighbors_above.end(),
+               m_neighbor_ranks.begin());
+
+    build_exchange_pattern(nonlocal_kernel_points);
+
+    // gather local then ghosted points, indexed by position
+    safe_free(m_points);
+    m_points = new PointCloud;
+    m_num_local_points = kernel_points->get_num_points();
+    for(size_t local_index = 0u; local_index < m_num_local_points; local_index++)
+    {
+        Point this_point = kernel_points->get_point(local_index);
+        this_point.set_index(local_index);
+        m_points->push_back(this_point);
+    }
+    const size_t num_neighbors = m_neighbor_ranks.size();
+    m_ghost_offsets.assign(1u, m_num_local_points);
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        PointCloud* ghosts = nonlocal_kernel_points[m_neighbor_ranks[neighbor]];
+        const size_t num_ghosts = (ghosts ? ghosts->get_num_points() : 0u);
+        for(size_t ghost_index = 0u; ghost_index < num_ghosts; ghost_index++)
+        {
+            Point this_point = ghosts->get_point(ghost_index);
+            this_point.set_index(m_points->get_num_points());
+            m_points->push_back(this_point);
+        }
+        m_ghost_offsets.push_back(m_points->get_num_points());
+    }
+
+    build_row_operator();
+}
+
+void MatrixFreeKernelOperator::apply(std::vector<double>& field, bool transpose)
+{
+    apply(field, 1u, transpose);
+}
+
+void MatrixFreeKernelOperator::apply(std::vector<double>& fields, size_t num_vectors, bool transpose)
+{
+    assert(fields.size() == m_num_local_points * num_vectors);
+    m_values.resize(m_points->get_num_points() * num_vectors);
+
+    // transpose weights each column by the normalization of its row, which may be ghosted
+    for(size_t local_index = 0u; local_index < m_num_local_points; local_index++)
+    {
+        const double scale = (transpose ? m_inverse_row_sums[local_index] : 1.);
+        for(size_t vector = 0u; vector < num_vectors; vector++)
+        {
+            m_values[local_index * num_vectors + vector] = fields[local_index * num_vectors + vector] * scale;
+        }
+    }
+    exchange_ghost_values(num_vectors);
+    const size_t num_threads = allocate_neighbors_buffers();
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_threads)
+#endif
+    {
+        size_t thread = 0u;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        // each search and weight evaluation is shared by all vectors
+        std::vector<size_t>& neighbors_buffer = m_neighbors_buffers[thread];
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(size_t local_index = 0u; local_index < m_num_local_points; local_index++)
+        {
+            double* products = &fields[local_index * num_vectors];
+            internal_row_product(local_index, num_vectors, transpose, neighbors_buffer, products);
+            if(!transpose)
+            {
+                for(size_t vector = 0u; vector < num_vectors; vector++)
+                {
+                    products[vector] *= m_inverse_row_sums[local_index];
+                }
+            }
+        }
+    }
+}
+
+void MatrixFreeKernelOperator::build_row_operator()
+{
+    // build searcher
+    safe_free(m_searcher);
+    m_searcher = build_fixed_radius_nearest_neighbors_searcher(m_input_data->get_spatial_searcher(), m_authority);
+    assert(m_searcher);
+    m_searcher->build(m_points, m_bounded_support_function->get_support());
+    m_row_buffer_size = m_points->get_num_points();
+
+    build_row_normalization();
+}
+
+void MatrixFreeKernelOperator::build_exchange_pattern(std::vector<PointCloud*>& nonlocal_kernel_points)
+{
+    // each rank tells its neighbors which of their points it has ghosted
+    const size_t num_neighbors = m_neighbor_ranks.size();
+    std::vector<std::vector<int> > ghosted_indexes(num_neighbors);
+    std::vector<std::vector<int> > num_ghosted(num_neighbors, std::vector<int>(1u, 0));
+    std::vector<std::vector<int> > num_requested(num_neighbors, std::vector<int>(1u, 0));
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        PointCloud* ghosts = nonlocal_kernel_points[m_neighbor_ranks[neighbor]];
+        const size_t num_ghosts = (ghosts ? ghosts->get_num_points() : 0u);
+        for(size_t ghost_index = 0u; ghost_index < num_ghosts; ghost_index++)
+        {
+            ghosted_indexes[neighbor].push_back(ghosts->get_index(ghost_index));
+        }
+        num_ghosted[neighbor][0] = num_ghosts;
+    }
+
+    // exchange sizes
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        m_authority->mpi_wrapper->ireceive(m_neighbor_ranks[neighbor], num_requested[neighbor]);
+    }
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        m_authority->mpi_wrapper->isend(m_neighbor_ranks[neighbor], num_ghosted[neighbor]);
+    }
+    m_authority->mpi_wrapper->wait_all();
+
+    // exchange indexes
+    std::vector<std::vector<int> > requested_indexes(num_neighbors);
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        requested_indexes[neighbor].resize(num_requested[neighbor][0]);
+        m_authority->mpi_wrapper->ireceive(m_neighbor_ranks[neighbor], requested_indexes[neighbor]);
+    }
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        m_authority->mpi_wrapper->isend(m_neighbor_ranks[neighbor], ghosted_indexes[neighbor]);
+    }
+    m_authority->mpi_wrapper->wait_all();
+
+    // allocate buffers
+    m_send_indexes.resize(num_neighbors);
+    m_send_buffers.resize(num_neighbors);
+    m_recv_buffers.resize(num_neighbors);
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        m_send_indexes[neighbor].assign(requested_indexes[neighbor].begin(), requested_indexes[neighbor].end());
+        m_send_buffers[neighbor].assign(m_send_indexes[neighbor].size(), 0.);
+        m_recv_buffers[neighbor].assign(ghosted_indexes[neighbor].size(), 0.);
+    }
+}
+
+void MatrixFreeKernelOperator::build_row_normalization()
+{
+    // row sums of local rows include ghosted columns
+    const size_t num_points = m_points->get_num_points();
+    m_values.assign(num_points, 1.);
+    m_inverse_row_sums.assign(m_num_local_points, 0.);
+    const size_t num_threads = allocate_neighbors_buffers();
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_threads)
+#endif
+    {
+        size_t thread = 0u;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        std::vector<size_t>& neighbors_buffer = m_neighbors_buffers[thread];
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(size_t local_index = 0u; local_index < m_num_local_points; local_index++)
+        {
+            double row_sum = 0.;
+            internal_row_product(local_index, 1u, false, neighbors_buffer, &row_sum);
+            // rows without weights stay empty, as they are when assembled
+            m_inverse_row_sums[local_index] = (row_sum > 0. ? 1. / row_sum : 0.);
+        }
+    }
+}
+
+size_t MatrixFreeKernelOperator::allocate_neighbors_buffers()
+{
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = std::max(1, omp_get_max_threads());
+#endif
+    // only reallocate when the thread count or the ghosted point count changed
+    if(m_neighbors_buffers.size() != size_t(num_threads) || m_neighbors_buffers[0].size() != m_row_buffer_size)
+    {
+        m_neighbors_buffers.assign(num_threads, std::vector<size_t>(m_row_buffer_size));
+    }
+    return num_threads;
+}
+
+void MatrixFreeKernelOperator::exchange_ghost_values(size_t num_vectors)
+{
+    const size_t num_neighbors = m_neighbor_ranks.size();
+
+    // post receives before any sends, all vectors packed in one message per neighbor
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        m_recv_buffers[neighbor].resize((m_ghost_offsets[neighbor + 1u] - m_ghost_offsets[neighbor]) * num_vectors);
+        m_authority->mpi_wrapper->ireceive(m_neighbor_ranks[neighbor], m_recv_buffers[neighbor]);
+    }
+
+    // send values at points ghosted by each neighbor
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        const std::vector<size_t>& send_indexes = m_send_indexes[neighbor];
+        std::vector<double>& send_buffer = m_send_buffers[neighbor];
+        const size_t num_to_send = send_indexes.size();
+        send_buffer.resize(num_to_send * num_vectors);
+        for(size_t index = 0u; index < num_to_send; index++)
+        {
+            for(size_t vector = 0u; vector < num_vectors; vector++)
+            {
+                send_buffer[index * num_vectors + vector] = m_values[send_indexes[index] * num_vectors + vector];
+            }
+        }
+        m_authority->mpi_wrapper->isend(m_neighbor_ranks[neighbor], send_buffer);
+    }
+    m_authority->mpi_wrapper->wait_all();
+
+    // place received values after local values
+    for(size_t neighbor = 0u; neighbor < num_neighbors; neighbor++)
+    {
+        std::copy(m_recv_buffers[neighbor].begin(),
+                  m_recv_buffers[neighbor].end(),
+                  &m_values[m_ghost_offsets[neighbor] * num_vectors]);
+    }
+}
+
+void MatrixFreeKernelOperator::internal_row_product(size_t local_index,
+                                                    size_t num_vectors,
+                                                    bool transpose,
+                                                    std::vector<size_t>& neighbors_buffer,
+                                                    double* result)
+{
+    Point local_point = m_points->get_point(local_index);
+
+    // determine which points are within the radius
+    size_t num_neighbors = 0u;
+    m_searcher->get_neighbors(&local_point, neighbors_buffer, num_neighbors);
+
+    // this sort is not necessary but promotes more sequential access
+    std::sort(&neighbors_buffer[0], &neighbors_buffer[num_neighbors]);
+
+    for(size_t vector = 0u; vector < num_vectors; vector++)
+    {
+        result[vector] = 0.;
+    }
+    for(size_t neighbor_index = 0u; neighbor_index < num_neighbors; neighbor_index++)
+    {
+        const size_t other_index = neighbors_buffer[neighbor_index];
+        Point other_point = m_points->get_point(other_index);
+
+        // if weight positive, accumulate
+        const double weight = (transpose ? m_bounded_support_function->evaluate(&other_point, &local_point) :
+                                           m_bounded_support_function->evaluate(&local_point, &other_point));
+        if(weight > 0)
+        {
+            const double* other_values = &m_values[other_index * num_vectors];
+            for(size_t vector = 0u; vector < num_vectors; vector++)
+            {
+                result[vector] += weight * other_values[vector];
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,83 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Class: matrix-free kernel filter operator.
+*
+* Applies the classically row normalized kernel matrix, or its transpose, without storing it.
+* Only a searcher over the local and ghosted kernel points and the inverse row sums are kept.
+* Each apply exchanges values at ghosted points with neighboring ranks, then evaluates the
+* bounded support function for every row, trading recomputation for memory.
+*/
+
+#include <vector>
+#include <cstddef>
+
+namespace PlatoSubproblemLibrary
+{
+namespace AbstractInterface
+{
+class FixedRadiusNearestNeighborsSearcher;
+}
+class PointCloud;
+class ParameterData;
+class AbstractAuthority;
+class Abstract_BoundedSupportFunction;
+
+class MatrixFreeKernelOperator
+{
+public:
+    MatrixFreeKernelOperator(AbstractAuthority* authority, ParameterData* input_data);
+    virtual ~MatrixFreeKernelOperator();
+
+    // collectively build searcher, exchange pattern, and row normalization
+    void build(Abstract_BoundedSupportFunction* bounded_support_function,
+               PointCloud* kernel_points,
+               std::vector<PointCloud*>& nonlocal_kernel_points,
+               const std::vector<size_t>& processor_neighbors_below,
+               const std::vector<size_t>& processor_neighbors_above);
+
+    // field = K * field, or field = K' * field
+    void apply(std::vector<double>& field, bool transpose);
+    // same for num_vectors fields interleaved by point
+    void apply(std::vector<double>& fields, size_t num_vectors, bool transpose);
+
+protected:
+    void build_exchange_pattern(std::vector<PointCloud*>& nonlocal_kernel_points);
+    // what rows are computed from, once local and ghosted points are gathered
+    virtual void build_row_operator();
+    void build_row_normalization();
+    // size one neighbors buffer per thread, kept across applies; returns the number of threads
+    size_t allocate_neighbors_buffers();
+    void exchange_ghost_values(size_t num_vectors);
+    // sums of weight times values over neighbors of a local point, row weights if not transpose
+    virtual void internal_row_product(size_t local_index,
+                                      size_t num_vectors,
+                                      bool transpose,
+                                      std::vector<size_t>& neighbors_buffer,
+                                      double* result);
+
+    AbstractAuthority* m_authority;
+    ParameterData* m_input_data;
+    Abstract_BoundedSupportFunction* m_bounded_support_function;
+    AbstractInterface::FixedRadiusNearestNeighborsSearcher* m_searcher;
+
+    // local points first, then ghosted points in neighbor order
+    PointCloud* m_points;
+    size_t m_num_local_points;
+    std::vector<double> m_inverse_row_sums;
+    // length of the per thread neighbors buffer passed to row products
+    size_t m_row_buffer_size;
+    std::vector<std::vector<size_t> > m_neighbors_buffers;
+
+    std::vector<size_t> m_neighbor_ranks;
+    std::vector<size_t> m_ghost_offsets;
+    std::vector<std::vector<size_t> > m_send_indexes;
+    std::vector<std::vector<double> > m_send_buffers;
+    std::vector<std::vector<double> > m_recv_buffers;
+
+    // values at local then ghosted points for the current apply, interleaved by point
+    std::vector<double> m_values;
+
+};
+
+}
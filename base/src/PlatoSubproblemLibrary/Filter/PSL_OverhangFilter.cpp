@@ -155,6 +155,7 @@ void OverhangFilter::build()
     safe_free(m_smoothing_kernel);
     m_input_data->set_bounded_support_function(bounded_support_function_t::bounded_support_function_t::polynomial_tent_function);
     m_smoothing_kernel = new KernelFilter(m_authority, m_input_data, m_original_points, m_parallel_exchanger);
+    m_smoothing_kernel->set_cache_tag("smoothing");
     m_smoothing_kernel->enable_maintain_kernel_points();
     m_smoothing_kernel->build();
     if(m_announce_radius)
@@ -169,6 +170,7 @@ void OverhangFilter::build()
     safe_free(m_overhang_kernel);
     m_input_data->set_bounded_support_function(bounded_support_function_t::bounded_support_function_t::overhang_inclusion_function);
     m_overhang_kernel = new KernelFilter(m_authority, m_input_data, m_original_points, m_parallel_exchanger);
+    m_overhang_kernel->set_cache_tag("overhang");
     m_overhang_kernel->build();
     if(m_announce_radius)
     {
@@ -299,7 +301,7 @@ void OverhangFilter::compute_overhang_bias(PointCloud* kernel_points)
     {
         // get point data
         std::vector<double> this_point;
-        kernel_points->get_point(p)->get_data(this_point);
+        kernel_points->get_point(p).get_data(this_point);
         double this_inp = m_authority->dense_vector_operations->dot(build_direction, this_point);
         local_smallest_inner_product = std::min(local_smallest_inner_product, this_inp);
     }
@@ -315,7 +317,7 @@ void OverhangFilter::compute_overhang_bias(PointCloud* kernel_points)
     {
         // get point data
         std::vector<double> this_point;
-        kernel_points->get_point(p)->get_data(this_point);
+        kernel_points->get_point(p).get_data(this_point);
         double this_inp = m_authority->dense_vector_operations->dot(build_direction, this_point);
 
         // if global minimum, then on build plate, and thus bias on
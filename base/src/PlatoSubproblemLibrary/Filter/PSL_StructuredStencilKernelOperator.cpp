@@ -0,0 +1,310 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_StructuredStencilKernelOperator.hpp"
+
+#include "PSL_Abstract_BoundedSupportFunction.hpp"
+#include "PSL_PointCloud.hpp"
+#include "PSL_Point.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+namespace PlatoSubproblemLibrary
+{
+
+StructuredStencilKernelOperator::StructuredStencilKernelOperator(AbstractAuthority* authority, ParameterData* input_data) :
+        MatrixFreeKernelOperator(authority, input_data),
+        m_uses_stencil(false),
+        m_lattice(),
+        m_cell_points(),
+        m_stencil_offsets(),
+        m_stencil_cell_offsets(),
+        m_stencil_weights(),
+        m_stencil_transpose_weights(),
+        m_boundary_row_of_point(),
+        m_boundary_row_offsets(),
+        m_boundary_columns(),
+        m_boundary_weights(),
+        m_boundary_transpose_weights()
+{
+}
+
+StructuredStencilKernelOperator::~StructuredStencilKernelOperator()
+{
+}
+
+bool StructuredStencilKernelOperator::is_structured(PointCloud* points) const
+{
+    Lattice lattice;
+    return compute_lattice(points, lattice);
+}
+
+bool StructuredStencilKernelOperator::uses_stencil() const
+{
+    return m_uses_stencil;
+}
+
+bool StructuredStencilKernelOperator::compute_lattice(PointCloud* points, Lattice& lattice) const
+{
+    const size_t num_points = points->get_num_points();
+    lattice.m_point_cells.assign(num_points, 0u);
+    for(size_t dim = 0u; dim < 3u; dim++)
+    {
+        lattice.m_origin[dim] = 0.;
+        lattice.m_spacing[dim] = 0.;
+        lattice.m_num_cells[dim] = 1u;
+    }
+    if(num_points == 0u)
+    {
+        return true;
+    }
+
+    // points must be at lattice positions to a tolerance far below any kernel weight sensitivity
+    double max_extent = 0.;
+    for(size_t dim = 0u; dim < 3u; dim++)
+    {
+        const std::vector<double>& coordinates = points->get_coordinates(dim);
+        lattice.m_origin[dim] = *std::min_element(coordinates.begin(), coordinates.end());
+        max_extent = std::max(max_extent, *std::max_element(coordinates.begin(), coordinates.end()) - lattice.m_origin[dim]);
+    }
+    const double tolerance = 1e-9 * max_extent;
+
+    // spacing from the smallest gap between distinct coordinates, refined to divide the extent
+    const size_t max_num_cells = 8u * num_points + 64u;
+    size_t total_cells = 1u;
+    for(size_t dim = 0u; dim < 3u; dim++)
+    {
+        std::vector<double> sorted_coordinates = points->get_coordinates(dim);
+        std::sort(sorted_coordinates.begin(), sorted_coordinates.end());
+        const double extent = sorted_coordinates.back() - sorted_coordinates.front();
+        if(extent <= tolerance)
+        {
+            continue;
+        }
+        double min_gap = extent;
+        for(size_t index = 1u; index < num_points; index++)
+        {
+            const double gap = sorted_coordinates[index] - sorted_coordinates[index - 1u];
+            if(gap > tolerance)
+            {
+                min_gap = std::min(min_gap, gap);
+            }
+        }
+        const double num_steps = std::floor(extent / min_gap + 0.5);
+        if(max_num_cells < num_steps + 1.)
+        {
+            return false;
+        }
+        lattice.m_spacing[dim] = extent / num_steps;
+        lattice.m_num_cells[dim] = size_t(num_steps) + 1u;
+        total_cells *= lattice.m_num_cells[dim];
+        if(max_num_cells < total_cells)
+        {
+            // too sparse a lattice to be a structured mesh
+            return false;
+        }
+    }
+
+    // place each point in its own cell
+    std::vector<char> is_occupied(total_cells, 0);
+    for(size_t point_index = 0u; point_index < num_points; point_index++)
+    {
+        size_t cell = 0u;
+        for(size_t dim = 0u; dim < 3u; dim++)
+        {
+            size_t cell_coordinate = 0u;
+            if(lattice.m_spacing[dim] > 0.)
+            {
+                const double coordinate = points->get_coordinate(point_index, dim);
+                const double steps = std::floor((coordinate - lattice.m_origin[dim]) / lattice.m_spacing[dim] + 0.5);
+                if(tolerance < std::fabs(coordinate - (lattice.m_origin[dim] + steps * lattice.m_spacing[dim])))
+                {
+                    return false;
+                }
+                cell_coordinate = std::min(size_t(std::max(steps, 0.)), lattice.m_num_cells[dim] - 1u);
+            }
+            cell = cell * lattice.m_num_cells[dim] + cell_coordinate;
+        }
+        if(is_occupied[cell])
+        {
+            return false;
+        }
+        is_occupied[cell] = 1;
+        lattice.m_point_cells[point_index] = cell;
+    }
+    return true;
+}
+
+void StructuredStencilKernelOperator::build_row_operator()
+{
+    m_uses_stencil = compute_lattice(m_points, m_lattice);
+    if(!m_uses_stencil)
+    {
+        m_lattice.m_point_cells.clear();
+        MatrixFreeKernelOperator::build_row_operator();
+        return;
+    }
+
+    build_stencil();
+    build_rows();
+    m_row_buffer_size = 0u;
+    build_row_normalization();
+}
+
+void StructuredStencilKernelOperator::build_stencil()
+{
+    // kernel functions depend only on the offset between points, so weights are evaluated about the origin
+    const double support = m_bounded_support_function->get_support();
+    int half_widths[3];
+    for(size_t dim = 0u; dim < 3u; dim++)
+    {
+        half_widths[dim] = (m_lattice.m_spacing[dim] > 0. ? int(std::floor(support / m_lattice.m_spacing[dim])) : 0);
+        m_stencil_offsets[dim].clear();
+    }
+    m_stencil_cell_offsets.clear();
+    m_stencil_weights.clear();
+    m_stencil_transpose_weights.clear();
+
+    const std::vector<double> origin_data = {0., 0., 0.};
+    Point origin(0u, origin_data);
+    for(int x_offset = -half_widths[0]; x_offset <= half_widths[0]; x_offset++)
+    {
+        for(int y_offset = -half_widths[1]; y_offset <= half_widths[1]; y_offset++)
+        {
+            for(int z_offset = -half_widths[2]; z_offset <= half_widths[2]; z_offset++)
+            {
+                const std::vector<double> offset_data = {x_offset * m_lattice.m_spacing[0],
+                                                         y_offset * m_lattice.m_spacing[1],
+                                                         z_offset * m_lattice.m_spacing[2]};
+                Point offset(0u, offset_data);
+                const double weight = m_bounded_support_function->evaluate(&origin, &offset);
+                const double transpose_weight = m_bounded_support_function->evaluate(&offset, &origin);
+                if((weight <= 0.) && (transpose_weight <= 0.))
+                {
+                    continue;
+                }
+
+                m_stencil_offsets[0].push_back(x_offset);
+                m_stencil_offsets[1].push_back(y_offset);
+                m_stencil_offsets[2].push_back(z_offset);
+                m_stencil_cell_offsets.push_back((long(x_offset) * long(m_lattice.m_num_cells[1]) + long(y_offset))
+                                                 * long(m_lattice.m_num_cells[2])
+                                                 + long(z_offset));
+                m_stencil_weights.push_back(std::max(weight, 0.));
+                m_stencil_transpose_weights.push_back(std::max(transpose_weight, 0.));
+            }
+        }
+    }
+}
+
+void StructuredStencilKernelOperator::build_rows()
+{
+    const size_t num_points = m_points->get_num_points();
+    const size_t num_stencil = m_stencil_weights.size();
+
+    m_cell_points.assign(m_lattice.m_num_cells[0] * m_lattice.m_num_cells[1] * m_lattice.m_num_cells[2], num_points);
+    for(size_t point_index = 0u; point_index < num_points; point_index++)
+    {
+        m_cell_points[m_lattice.m_point_cells[point_index]] = point_index;
+    }
+
+    // interior rows have every stencil point present, others are stored with the points they have
+    m_boundary_row_of_point.assign(m_num_local_points, m_num_local_points);
+    m_boundary_row_offsets.assign(1u, 0u);
+    m_boundary_columns.clear();
+    m_boundary_weights.clear();
+    m_boundary_transpose_weights.clear();
+    std::vector<size_t> stencil_points(num_stencil);
+    for(size_t local_index = 0u; local_index < m_num_local_points; local_index++)
+    {
+        const size_t cell = m_lattice.m_point_cells[local_index];
+        const long cell_coordinates[3] = {long(cell / (m_lattice.m_num_cells[1] * m_lattice.m_num_cells[2])),
+                                          long((cell / m_lattice.m_num_cells[2]) % m_lattice.m_num_cells[1]),
+                                          long(cell % m_lattice.m_num_cells[2])};
+
+        bool is_interior = true;
+        for(size_t stencil = 0u; stencil < num_stencil; stencil++)
+        {
+            stencil_points[stencil] = num_points;
+            bool is_inside = true;
+            for(size_t dim = 0u; dim < 3u; dim++)
+            {
+                const long other_coordinate = cell_coordinates[dim] + m_stencil_offsets[dim][stencil];
+                is_inside = is_inside && (0 <= other_coordinate) && (other_coordinate < long(m_lattice.m_num_cells[dim]));
+            }
+            if(is_inside)
+            {
+                stencil_points[stencil] = m_cell_points[size_t(long(cell) + m_stencil_cell_offsets[stencil])];
+            }
+            is_interior = is_interior && (stencil_points[stencil] != num_points);
+        }
+        if(is_interior)
+        {
+            continue;
+        }
+
+        m_boundary_row_of_point[local_index] = m_boundary_row_offsets.size() - 1u;
+        for(size_t stencil = 0u; stencil < num_stencil; stencil++)
+        {
+            if(stencil_points[stencil] != num_points)
+            {
+                m_boundary_columns.push_back(stencil_points[stencil]);
+                m_boundary_weights.push_back(m_stencil_weights[stencil]);
+                m_boundary_transpose_weights.push_back(m_stencil_transpose_weights[stencil]);
+            }
+        }
+        m_boundary_row_offsets.push_back(m_boundary_columns.size());
+    }
+}
+
+void StructuredStencilKernelOperator::internal_row_product(size_t local_index,
+                                                           size_t num_vectors,
+                                                           bool transpose,
+                                                           std::vector<size_t>& neighbors_buffer,
+                                                           double* result)
+{
+    if(!m_uses_stencil)
+    {
+        MatrixFreeKernelOperator::internal_row_product(local_index, num_vectors, transpose, neighbors_buffer, result);
+        return;
+    }
+
+    for(size_t vector = 0u; vector < num_vectors; vector++)
+    {
+        result[vector] = 0.;
+    }
+
+    const size_t boundary_row = m_boundary_row_of_point[local_index];
+    if(boundary_row != m_num_local_points)
+    {
+        const std::vector<double>& weights = (transpose ? m_boundary_transpose_weights : m_boundary_weights);
+        const size_t entry_end = m_boundary_row_offsets[boundary_row + 1u];
+        for(size_t entry = m_boundary_row_offsets[boundary_row]; entry < entry_end; entry++)
+        {
+            const double weight = weights[entry];
+            const double* other_values = &m_values[m_boundary_columns[entry] * num_vectors];
+            for(size_t vector = 0u; vector < num_vectors; vector++)
+            {
+                result[vector] += weight * other_values[vector];
+            }
+        }
+        return;
+    }
+
+    // interior rows read every stencil point through the cell map
+    const std::vector<double>& weights = (transpose ? m_stencil_transpose_weights : m_stencil_weights);
+    const long cell = long(m_lattice.m_point_cells[local_index]);
+    const size_t num_stencil = weights.size();
+    for(size_t stencil = 0u; stencil < num_stencil; stencil++)
+    {
+        const double weight = weights[stencil];
+        const double* other_values = &m_values[m_cell_points[size_t(cell + m_stencil_cell_offsets[stencil])] * num_vectors];
+        for(size_t vector = 0u; vector < num_vectors; vector++)
+        {
+            result[vector] += weight * other_values[vector];
+        }
+    }
+}
+
+}
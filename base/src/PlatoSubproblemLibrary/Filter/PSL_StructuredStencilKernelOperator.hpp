@@ -0,0 +1,76 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Class: structured stencil kernel filter operator.
+*
+* On a uniform lattice of points, such as the nodes of a structured hex mesh, every row of the kernel
+* matrix whose support is entirely present has the same weights. Those weights are evaluated once as a
+* stencil and interior rows are applied as a convolution over a map from lattice cells to points, with
+* no neighbor search and no per row column indexes. Only rows near the boundary of the local and
+* ghosted points are stored explicitly. If the local and ghosted points are not a lattice, rows are
+* computed as by the matrix-free operator; KernelFilter instead assembles matrices on every processor
+* unless all processors use the stencil.
+*/
+
+#include "PSL_MatrixFreeKernelOperator.hpp"
+
+#include <vector>
+#include <cstddef>
+
+namespace PlatoSubproblemLibrary
+{
+class PointCloud;
+class ParameterData;
+class AbstractAuthority;
+
+class StructuredStencilKernelOperator : public MatrixFreeKernelOperator
+{
+public:
+    StructuredStencilKernelOperator(AbstractAuthority* authority, ParameterData* input_data);
+    ~StructuredStencilKernelOperator() override;
+
+    // whether points lie on a uniform lattice
+    bool is_structured(PointCloud* points) const;
+    // whether rows are applied by stencil, once built
+    bool uses_stencil() const;
+
+protected:
+    // uniform lattice of points, cells numbered with z fastest
+    struct Lattice
+    {
+        double m_origin[3];
+        double m_spacing[3];
+        size_t m_num_cells[3];
+        std::vector<size_t> m_point_cells;
+    };
+    bool compute_lattice(PointCloud* points, Lattice& lattice) const;
+
+    void build_row_operator() override;
+    void build_stencil();
+    void build_rows();
+    void internal_row_product(size_t local_index,
+                              size_t num_vectors,
+                              bool transpose,
+                              std::vector<size_t>& neighbors_buffer,
+                              double* result) override;
+
+    bool m_uses_stencil;
+    Lattice m_lattice;
+    // point at each lattice cell, or the number of points if none
+    std::vector<size_t> m_cell_points;
+
+    // stencil offsets in cells along each dimension and in cell numbering, with row and transposed row weights
+    std::vector<int> m_stencil_offsets[3];
+    std::vector<long> m_stencil_cell_offsets;
+    std::vector<double> m_stencil_weights;
+    std::vector<double> m_stencil_transpose_weights;
+
+    // rows with some of their stencil missing, in compressed row form, indexed by local point if not interior
+    std::vector<size_t> m_boundary_row_of_point;
+    std::vector<size_t> m_boundary_row_offsets;
+    std::vector<size_t> m_boundary_columns;
+    std::vector<double> m_boundary_weights;
+    std::vector<double> m_boundary_transpose_weights;
+};
+
+}
@@ -277,6 +277,31 @@ std::vector<size_t> OrthogonalGridUtilities::getSurroundingIndices(const size_t&
     return tSurroundingIndices;
 }
 
+OrthogonalGridUtilities OrthogonalGridUtilities::getSubGrid(const std::vector<size_t>& aBeginIndex, const std::vector<size_t>& aEndIndex) const
+{
+    if(aBeginIndex.size() != 3 || aEndIndex.size() != 3)
+        throw(std::domain_error("OrthogonalGridUtilities::getSubGrid: Index must have 3 entries"));
+
+    std::vector<size_t> tDimensions = getGridDimensions();
+    std::vector<size_t> tLastIndex(3);
+    std::vector<size_t> tNumElements(3);
+    for(size_t tDim = 0; tDim < 3; ++tDim)
+    {
+        if(aEndIndex[tDim] > tDimensions[tDim] || aBeginIndex[tDim] + 1 >= aEndIndex[tDim])
+            throw(std::out_of_range("OrthogonalGridUtilities::getSubGrid: Sub grid must lie within the grid and have at least one element in each direction"));
+
+        tLastIndex[tDim] = aEndIndex[tDim] - 1;
+        tNumElements[tDim] = aEndIndex[tDim] - aBeginIndex[tDim] - 1;
+    }
+
+    return OrthogonalGridUtilities(mUBasisVector,
+                                   mVBasisVector,
+                                   mWBasisVector,
+                                   computeGridPointUVWCoordinates(tLastIndex),
+                                   computeGridPointUVWCoordinates(aBeginIndex),
+                                   tNumElements);
+}
+
 Vector OrthogonalGridUtilities::computePointUVWCoordinates(const Vector& aXYZPoint) const
 {
     //use cramers rule to compute change of basis for input point
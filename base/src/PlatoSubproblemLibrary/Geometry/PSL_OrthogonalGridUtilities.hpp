@@ -75,6 +75,9 @@ class OrthogonalGridUtilities
 
         std::vector<size_t> getSurroundingIndices(const size_t& aDim, const Vector& aPoint) const;
 
+        // grid over the half open index ranges [aBeginIndex, aEndIndex) whose points coincide with this grid's
+        OrthogonalGridUtilities getSubGrid(const std::vector<size_t>& aBeginIndex, const std::vector<size_t>& aEndIndex) const;
+
         double interpolateScalar(const std::vector<std::vector<size_t>>& aContainingElementIndicies,
                                  const std::vector<double>& aScalarValues,
                                  const Vector& aPoint) const;
@@ -6,13 +6,16 @@
 #include <cmath>
 #include <cassert>
 #include <cstring>
+#include <algorithm>
+#include <stdexcept>
 
 namespace PlatoSubproblemLibrary
 {
 
 Point::Point() :
         m_index(),
-        m_data()
+        m_dimension(0u),
+        m_data{0., 0., 0.}
 {
 }
 
@@ -22,16 +25,29 @@ Point::~Point()
 
 // fill data
 Point::Point(size_t index, const std::vector<double>& data) :
-        m_index(index),
-        m_data(data)
+        m_index(),
+        m_dimension(0u),
+        m_data{0., 0., 0.}
 {
+    set(index, data);
 }
 
 // fill data
 void Point::set(size_t index, const std::vector<double>& data)
 {
+    set(index, data.data(), data.size());
+}
+
+// fill data
+void Point::set(size_t index, const double* data, size_t dimension)
+{
+    if(dimension > s_max_dimension)
+    {
+        throw(std::length_error("Point::set: dimension exceeds Point::s_max_dimension"));
+    }
     m_index = index;
-    m_data.assign(data.begin(),data.end());
+    m_dimension = dimension;
+    std::copy(data, data + dimension, m_data);
 }
 
 // fill data
@@ -41,7 +57,7 @@ void Point::set(size_t index, char* data)
 
     // currently assuming dimension
     const size_t dimension = 3u;
-    m_data.resize(dimension);
+    m_dimension = dimension;
     for(size_t di = 0u; di < dimension; di++)
     {
         char float_array[4] = {data[0 + 4u * di], data[1u + 4u * di], data[2u + 4u * di], data[3u + 4u * di]};
@@ -63,7 +79,7 @@ size_t Point::get_index() const
 // get dimension
 size_t Point::dimension() const
 {
-    return m_data.size();
+    return m_dimension;
 }
 
 // get a value
@@ -75,11 +91,15 @@ double Point::operator()(size_t index) const
 // get all values
 void Point::get_data(std::vector<double>& data) const
 {
-    data.assign(m_data.begin(), m_data.end());
+    data.assign(m_data, m_data + m_dimension);
 }
 
 void Point::set(size_t index, double value)
 {
+    if(index >= s_max_dimension)
+    {
+        throw(std::out_of_range("Point::set: coordinate index exceeds Point::s_max_dimension"));
+    }
     m_data[index] = value;
 }
 
@@ -1,10 +1,13 @@
 // PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
 #pragma once
 
-/* A Point in an arbitrary dimension.
+/* A Point in up to three dimensions.
  *
  * A single Id slot is allocated. This Id may be local, global, or not set depending on the
  * needs of the application (be careful).
+ *
+ * Coordinates are held in place rather than on the heap, so Points are cheap to copy out of a PointCloud.
+ * At most s_max_dimension coordinates are held; setting more throws.
  */
 
 #include <cstddef>
@@ -18,9 +21,12 @@ public:
     Point();
     ~Point();
 
+    static const size_t s_max_dimension = 3u;
+
     // fill data
     Point(size_t index, const std::vector<double>& data);
     void set(size_t index, const std::vector<double>& data);
+    void set(size_t index, const double* data, size_t dimension);
     void set(size_t index, char* data);
 
     void set_index(size_t index);
@@ -46,7 +52,8 @@ public:
 
 private:
     size_t m_index;
-    std::vector<double> m_data;
+    size_t m_dimension;
+    double m_data[s_max_dimension];
 };
 
 Point operator *(const double scalar, const Point& P);
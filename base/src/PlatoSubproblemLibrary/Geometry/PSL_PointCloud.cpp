@@ -6,22 +6,37 @@
 
 #include <vector>
 #include <cstddef>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
 
 namespace PlatoSubproblemLibrary
 {
 
 PointCloud::PointCloud()
-    : m_points() {
+    : m_dimension(0u),
+      m_indexes(),
+      m_x(),
+      m_y(),
+      m_z() {
 
 }
 
 PointCloud::PointCloud(PointCloud* other, const std::vector<size_t>& indexes_to_transfer)
-    : m_points(indexes_to_transfer.size())
+    : m_dimension(other->m_dimension),
+      m_indexes(indexes_to_transfer.size()),
+      m_x(indexes_to_transfer.size()),
+      m_y(indexes_to_transfer.size()),
+      m_z(indexes_to_transfer.size())
 {
     const size_t num_indexes_to_transfer = indexes_to_transfer.size();
     for(size_t i = 0u; i < num_indexes_to_transfer; i++)
     {
-        m_points[i] = *other->get_point(indexes_to_transfer[i]);
+        const size_t other_index = indexes_to_transfer[i];
+        m_indexes[i] = other->m_indexes[other_index];
+        m_x[i] = other->m_x[other_index];
+        m_y[i] = other->m_y[other_index];
+        m_z[i] = other->m_z[other_index];
     }
 }
 
@@ -31,32 +46,120 @@ PointCloud::~PointCloud() {
 
 void PointCloud::resize(size_t num_points)
 {
-    m_points.resize(num_points);
+    m_indexes.resize(num_points);
+    m_x.resize(num_points, 0.);
+    m_y.resize(num_points, 0.);
+    m_z.resize(num_points, 0.);
+}
+
+void PointCloud::reserve(size_t num_points)
+{
+    m_indexes.reserve(num_points);
+    m_x.reserve(num_points);
+    m_y.reserve(num_points);
+    m_z.reserve(num_points);
 }
 
 void PointCloud::assign(std::vector<Point>& points)
 {
-    m_points.assign(points.begin(), points.end());
+    const size_t num_points = points.size();
+    resize(num_points);
+    for(size_t index = 0u; index < num_points; index++)
+    {
+        assign(index, points[index]);
+    }
 }
 
 void PointCloud::assign(size_t index, const Point& point)
 {
-    m_points[index] = point;
+    // the first point assigned sets the dimension of the cloud
+    const size_t dimension = point.dimension();
+    assert(dimension <= Point::s_max_dimension);
+    assert(m_dimension == 0u || m_dimension == dimension);
+    m_dimension = dimension;
+
+    m_indexes[index] = point.get_index();
+    m_x[index] = (0u < dimension ? point(0u) : 0.);
+    m_y[index] = (1u < dimension ? point(1u) : 0.);
+    m_z[index] = (2u < dimension ? point(2u) : 0.);
 }
 
 void PointCloud::push_back(const Point& point)
 {
-    m_points.push_back(point);
+    resize(m_indexes.size() + 1u);
+    assign(m_indexes.size() - 1u, point);
+}
+
+void PointCloud::push_back(size_t point_index, const double* coordinates)
+{
+    // points added by coordinates are three dimensional
+    assert(m_dimension == 0u || m_dimension == 3u);
+    m_dimension = 3u;
+
+    m_indexes.push_back(point_index);
+    m_x.push_back(coordinates[0]);
+    m_y.push_back(coordinates[1]);
+    m_z.push_back(coordinates[2]);
 }
 
 size_t PointCloud::get_num_points() const
 {
-    return m_points.size();
+    return m_indexes.size();
+}
+
+Point PointCloud::get_point(size_t index) const
+{
+    const double coordinates[3] = {m_x[index], m_y[index], m_z[index]};
+    Point result;
+    result.set(m_indexes[index], coordinates, m_dimension);
+    return result;
+}
+
+size_t PointCloud::get_dimension() const
+{
+    return m_dimension;
+}
+
+size_t PointCloud::get_index(size_t index) const
+{
+    return m_indexes[index];
 }
 
-Point* PointCloud::get_point(size_t index)
+double PointCloud::get_coordinate(size_t index, size_t dimension) const
 {
-    return &m_points[index];
+    return get_coordinates(dimension)[index];
+}
+
+const std::vector<size_t>& PointCloud::get_indexes() const
+{
+    return m_indexes;
+}
+
+const std::vector<double>& PointCloud::get_coordinates(size_t dimension) const
+{
+    assert(dimension < 3u);
+    return (dimension == 0u ? m_x : (dimension == 1u ? m_y : m_z));
+}
+
+double PointCloud::distance(size_t index, const Point* other) const
+{
+    assert(m_dimension == other->dimension());
+
+    // accumulate in the same order as Point::distance, so results are identical
+    double result = 0;
+    if(0u < m_dimension)
+    {
+        result += (m_x[index] - (*other)(0u)) * (m_x[index] - (*other)(0u));
+    }
+    if(1u < m_dimension)
+    {
+        result += (m_y[index] - (*other)(1u)) * (m_y[index] - (*other)(1u));
+    }
+    if(2u < m_dimension)
+    {
+        result += (m_z[index] - (*other)(2u)) * (m_z[index] - (*other)(2u));
+    }
+    return std::sqrt(result);
 }
 
 AxisAlignedBoundingBox PointCloud::get_bound()
@@ -64,17 +167,22 @@ AxisAlignedBoundingBox PointCloud::get_bound()
     AxisAlignedBoundingBox result(0., 0., 0., 0u);
 
     // if no points, return origin
-    if(m_points.size() == 0u)
+    const size_t num_points = m_indexes.size();
+    if(num_points == 0u)
     {
         return result;
     }
 
     // build result to contain each point
-    result.set(&m_points[0]);
-    const size_t num_points = m_points.size();
+    result = AxisAlignedBoundingBox(m_x[0], m_y[0], m_z[0], m_indexes[0]);
     for(size_t index = 1u; index < num_points; index++)
     {
-        result.grow_to_include(&m_points[index]);
+        result.set_x_min(std::min(float(m_x[index]), result.get_x_min()));
+        result.set_x_max(std::max(float(m_x[index]), result.get_x_max()));
+        result.set_y_min(std::min(float(m_y[index]), result.get_y_min()));
+        result.set_y_max(std::max(float(m_y[index]), result.get_y_max()));
+        result.set_z_min(std::min(float(m_z[index]), result.get_z_min()));
+        result.set_z_max(std::max(float(m_z[index]), result.get_z_max()));
     }
 
     return result;
@@ -1,10 +1,14 @@
 // PlatoSubproblemLibraryVersion(3): a stand-alone library for the kernel filter for plato.
 #pragma once
 
-/* An ordered collection of points in an arbitrary dimension.
+/* An ordered collection of points in up to three dimensions.
  *
  * Point are accessed in this class by an indexing order in the cloud.
  * This ordering may not reflect the individual indexes of the points (be careful).
+ *
+ * Points are stored as a structure of arrays: one contiguous array of indexes and one of
+ * coordinates per dimension. get_point copies a point out of these arrays; searchers and
+ * agents that visit every point should read the arrays directly.
  */
 
 #include <vector>
@@ -22,16 +26,32 @@ public:
     ~PointCloud();
 
     void resize(size_t num_points);
+    void reserve(size_t num_points);
     void assign(std::vector<Point>& points);
     void assign(size_t index, const Point& point);
     void push_back(const Point& point);
+    void push_back(size_t point_index, const double* coordinates);
     size_t get_num_points() const;
-    Point* get_point(size_t index);
+    Point get_point(size_t index) const;
+
+    // contiguous storage, dimensions past get_dimension are zero
+    size_t get_dimension() const;
+    size_t get_index(size_t index) const;
+    double get_coordinate(size_t index, size_t dimension) const;
+    const std::vector<size_t>& get_indexes() const;
+    const std::vector<double>& get_coordinates(size_t dimension) const;
+
+    // same as other->distance(&point) for the point at index
+    double distance(size_t index, const Point* other) const;
 
     AxisAlignedBoundingBox get_bound();
 
 protected:
-    std::vector<Point> m_points;
+    size_t m_dimension;
+    std::vector<size_t> m_indexes;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
 
 };
 
@@ -84,6 +84,16 @@ public:
     PSL_PARAMETER_DATA_POD(tokens_t, double, build_direction_x)
     PSL_PARAMETER_DATA_POD(tokens_t, double, build_direction_y)
     PSL_PARAMETER_DATA_POD(tokens_t, double, build_direction_z)
+    PSL_PARAMETER_DATA_POD_LONG(tokens_t, string, std::string, kernel_filter_cache_filename)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_matrix_free)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_fused_projection)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_structured_stencil)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_morton_order)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_compact_storage)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_single_precision)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_symmetric_storage)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_incremental_update)
+    PSL_PARAMETER_DATA_POD(tokens_t, bool, kernel_filter_stored_transpose)
 
     void defaults_for_classification();
     void defaults_for_feedForwardNeuralNetwork();
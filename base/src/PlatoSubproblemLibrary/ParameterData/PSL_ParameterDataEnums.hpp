@@ -78,6 +78,16 @@ enum tokens_t
     build_direction_x,
     build_direction_y,
     build_direction_z,
+    kernel_filter_cache_filename,
+    kernel_filter_matrix_free,
+    kernel_filter_fused_projection,
+    kernel_filter_structured_stencil,
+    kernel_filter_morton_order,
+    kernel_filter_compact_storage,
+    kernel_filter_single_precision,
+    kernel_filter_symmetric_storage,
+    kernel_filter_incremental_update,
+    kernel_filter_stored_transpose,
 };
 }
 namespace normalization_t {
@@ -109,6 +119,8 @@ enum spatial_searcher_t
     brute_force_fixed_radius_nearest_neighbors,
     radix_grid_fixed_radius_nearest_neighbors,
     brute_force_nearest_neighbor,
+    cell_list_fixed_radius_nearest_neighbors,
+    arborx_fixed_radius_nearest_neighbors,
 };
 }
 namespace bounded_support_function_t {
@@ -123,6 +135,7 @@ enum matrix_assembly_agent_t
 {
     unset_matrix_assembly_agent,
     by_row,
+    by_row_single_pass,
 };
 }
 namespace symmetry_plane_agent_t {
@@ -150,6 +163,15 @@ namespace point_ghosting_agent_t {
 enum point_ghosting_agent_t {
     unset_point_ghosting_agent,
     by_narrow_share,
+    by_neighbor_exchange,
+};
+}
+namespace preconditioner_t {
+enum preconditioner_t
+{
+    no_preconditioner,
+    jacobi_preconditioner,
+    incomplete_cholesky_preconditioner,
 };
 }
 namespace activation_function_t {
@@ -0,0 +1,254 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_ArborXFixedRadiusNearestNeighbors.hpp"
+
+#include "PSL_Point.hpp"
+#include "PSL_PointCloud.hpp"
+
+#include <ArborX.hpp>
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace PlatoSubproblemLibrary
+{
+
+using ArborXHostExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+using ArborXHostDeviceType = Kokkos::Device<ArborXHostExecutionSpace, Kokkos::HostSpace>;
+
+struct ArborXAnswerPoints
+{
+    const double* m_x;
+    const double* m_y;
+    const double* m_z;
+    size_t m_num_points;
+};
+
+struct ArborXQuerySpheres
+{
+    const double* m_x;
+    const double* m_y;
+    const double* m_z;
+    size_t m_num_points;
+    float m_radius;
+};
+
+struct ArborXFixedRadiusNearestNeighbors::SearchTree
+{
+    explicit SearchTree(const ArborXAnswerPoints& answer_points) :
+            m_bvh(answer_points)
+    {
+    }
+
+    ArborX::BVH<ArborXHostDeviceType> m_bvh;
+};
+
+}
+
+namespace ArborX
+{
+namespace Traits
+{
+template<>
+struct Access<PlatoSubproblemLibrary::ArborXAnswerPoints, PrimitivesTag>
+{
+    inline static std::size_t size(PlatoSubproblemLibrary::ArborXAnswerPoints const& points)
+    {
+        return points.m_num_points;
+    }
+    KOKKOS_INLINE_FUNCTION static Point get(PlatoSubproblemLibrary::ArborXAnswerPoints const& points, std::size_t i)
+    {
+        return {{points.m_x[i], points.m_y[i], points.m_z[i]}};
+    }
+    using memory_space = Kokkos::HostSpace;
+};
+
+template<>
+struct Access<PlatoSubproblemLibrary::ArborXQuerySpheres, PredicatesTag>
+{
+    inline static std::size_t size(PlatoSubproblemLibrary::ArborXQuerySpheres const& spheres)
+    {
+        return spheres.m_num_points;
+    }
+    KOKKOS_INLINE_FUNCTION static auto get(PlatoSubproblemLibrary::ArborXQuerySpheres const& spheres, std::size_t i)
+    {
+        return intersects(Sphere{Point{spheres.m_x[i], spheres.m_y[i], spheres.m_z[i]}, spheres.m_radius});
+    }
+    using memory_space = Kokkos::HostSpace;
+};
+}
+}
+
+namespace PlatoSubproblemLibrary
+{
+
+ArborXFixedRadiusNearestNeighbors::ArborXFixedRadiusNearestNeighbors() :
+        AbstractInterface::FixedRadiusNearestNeighborsSearcher(),
+        m_radius(-1.),
+        m_lower_squared_radius(-1.),
+        m_upper_squared_radius(-1.),
+        m_search_radius(-1.),
+        m_coordinates(),
+        m_indexes(),
+        m_tree()
+{
+}
+
+ArborXFixedRadiusNearestNeighbors::~ArborXFixedRadiusNearestNeighbors()
+{
+    m_tree.reset();
+}
+
+// build tree over answer points
+void ArborXFixedRadiusNearestNeighbors::build(PlatoSubproblemLibrary::PointCloud* answer_points, double radius)
+{
+    m_radius = radius;
+
+    // squared distances within this band are resolved with the same sqrt test as Point::distance
+    const double squared_radius = m_radius * m_radius;
+    m_lower_squared_radius = squared_radius * (1. - 1e-12);
+    m_upper_squared_radius = squared_radius * (1. + 1e-12);
+
+    const size_t num_points = answer_points->get_num_points();
+    double max_magnitude = 0.;
+    for(size_t dim = 0u; dim < 3u; dim++)
+    {
+        m_coordinates[dim] = answer_points->get_coordinates(dim);
+        for(size_t point_index = 0u; point_index < num_points; point_index++)
+        {
+            max_magnitude = std::max(max_magnitude, std::fabs(m_coordinates[dim][point_index]));
+        }
+    }
+    m_indexes.resize(num_points);
+    for(size_t point_index = 0u; point_index < num_points; point_index++)
+    {
+        m_indexes[point_index] = answer_points->get_index(point_index);
+    }
+
+    // enlarge spheres past the single precision rounding of tree coordinates, candidates are confirmed in double
+    m_search_radius = m_radius + 1e-5 * (m_radius + max_magnitude);
+
+    m_tree.reset();
+    if(num_points > 0u)
+    {
+        ArborXAnswerPoints primitives = {m_coordinates[0].data(), m_coordinates[1].data(), m_coordinates[2].data(), num_points};
+        m_tree.reset(new SearchTree(primitives));
+    }
+}
+
+// find neighbors of query point within radius
+void ArborXFixedRadiusNearestNeighbors::get_neighbors(PlatoSubproblemLibrary::Point* query_point,
+                                                       std::vector<size_t>& neighbors_buffer,
+                                                       size_t& num_neighbors)
+{
+    const double x = (*query_point)(0);
+    const double y = (*query_point)(1);
+    const double z = (*query_point)(2);
+
+    std::vector<size_t> neighbor_offsets;
+    std::vector<size_t> neighbor_indexes;
+    query(&x, &y, &z, 1u, neighbor_offsets, neighbor_indexes);
+
+    const size_t num_found = neighbor_indexes.size();
+    for(size_t found = 0u; found < num_found; found++)
+    {
+        neighbors_buffer[num_neighbors++] = neighbor_indexes[found];
+    }
+}
+
+// find neighbors of every query point within radius
+void ArborXFixedRadiusNearestNeighbors::get_all_neighbors(PlatoSubproblemLibrary::PointCloud* query_points,
+                                                           const size_t& max_num_neighbors,
+                                                           std::vector<size_t>& neighbor_offsets,
+                                                           std::vector<size_t>& neighbor_indexes)
+{
+    // results are sized by the traversal, not by the caller's bound
+    (void)max_num_neighbors;
+
+    query(query_points->get_coordinates(0u).data(),
+          query_points->get_coordinates(1u).data(),
+          query_points->get_coordinates(2u).data(),
+          query_points->get_num_points(),
+          neighbor_offsets,
+          neighbor_indexes);
+}
+
+void ArborXFixedRadiusNearestNeighbors::query(const double* query_x,
+                                              const double* query_y,
+                                              const double* query_z,
+                                              const size_t& num_queries,
+                                              std::vector<size_t>& neighbor_offsets,
+                                              std::vector<size_t>& neighbor_indexes) const
+{
+    neighbor_offsets.assign(num_queries + 1u, 0u);
+    neighbor_indexes.clear();
+    if(!m_tree || num_queries == 0u)
+    {
+        return;
+    }
+
+    // candidates of every query from one traversal
+    ArborXQuerySpheres predicates = {query_x, query_y, query_z, num_queries, float(m_search_radius)};
+    Kokkos::View<int*, ArborXHostDeviceType> candidate_indexes("indexes", 0);
+    Kokkos::View<int*, ArborXHostDeviceType> candidate_offsets("offsets", 0);
+    m_tree->m_bvh.query(predicates, candidate_indexes, candidate_offsets);
+
+    // confirm candidates, compacting each query's range in place
+    std::vector<size_t> confirmed(candidate_offsets(num_queries));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(size_t query_index = 0u; query_index < num_queries; query_index++)
+    {
+        const size_t begin = candidate_offsets(query_index);
+        const size_t end = candidate_offsets(query_index + 1u);
+        size_t num_confirmed = 0u;
+        for(size_t candidate = begin; candidate < end; candidate++)
+        {
+            const size_t answer = candidate_indexes(candidate);
+            if(is_within_radius(answer, query_x[query_index], query_y[query_index], query_z[query_index]))
+            {
+                confirmed[begin + num_confirmed++] = m_indexes[answer];
+            }
+        }
+        neighbor_offsets[query_index + 1u] = num_confirmed;
+    }
+
+    for(size_t query_index = 0u; query_index < num_queries; query_index++)
+    {
+        neighbor_offsets[query_index + 1u] += neighbor_offsets[query_index];
+    }
+    neighbor_indexes.resize(neighbor_offsets[num_queries]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(size_t query_index = 0u; query_index < num_queries; query_index++)
+    {
+        const size_t begin = candidate_offsets(query_index);
+        const size_t num_confirmed = neighbor_offsets[query_index + 1u] - neighbor_offsets[query_index];
+        std::copy(confirmed.begin() + begin,
+                  confirmed.begin() + begin + num_confirmed,
+                  neighbor_indexes.begin() + neighbor_offsets[query_index]);
+    }
+}
+
+bool ArborXFixedRadiusNearestNeighbors::is_within_radius(const size_t& answer,
+                                                         const double& x,
+                                                         const double& y,
+                                                         const double& z) const
+{
+    const double dx = m_coordinates[0][answer] - x;
+    const double dy = m_coordinates[1][answer] - y;
+    const double dz = m_coordinates[2][answer] - z;
+    const double squared_distance = dx * dx + dy * dy + dz * dz;
+
+    if(m_upper_squared_radius < squared_distance)
+    {
+        return false;
+    }
+    return (squared_distance <= m_lower_squared_radius) || (std::sqrt(squared_distance) <= m_radius);
+}
+
+}
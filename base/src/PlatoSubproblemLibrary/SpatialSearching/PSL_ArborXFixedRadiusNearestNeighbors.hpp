@@ -0,0 +1,65 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Fixed radius searcher over an ArborX bounding volume hierarchy.
+ *
+ * Answer points are the primitives of an ArborX::BVH on the Kokkos host execution space, and
+ * queries are sphere intersection predicates. ArborX stores single precision coordinates, so
+ * spheres are slightly enlarged and candidates are confirmed with the same double precision
+ * test as the other fixed radius searchers. Batched queries over a point cloud are answered by
+ * one tree traversal, threaded by Kokkos, and come back in compressed row form.
+ */
+
+#include "PSL_Abstract_FixedRadiusNearestNeighborsSearcher.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+namespace PlatoSubproblemLibrary
+{
+class PointCloud;
+class Point;
+
+class ArborXFixedRadiusNearestNeighbors : public AbstractInterface::FixedRadiusNearestNeighborsSearcher
+{
+public:
+    ArborXFixedRadiusNearestNeighbors();
+    ~ArborXFixedRadiusNearestNeighbors() override;
+
+    // build searcher
+    void build(PlatoSubproblemLibrary::PointCloud* answer_points, double radius) override;
+    // find neighbors within radius
+    void get_neighbors(PlatoSubproblemLibrary::Point* query_point,
+                       std::vector<size_t>& neighbors_buffer,
+                       size_t& num_neighbors) override;
+    // find neighbors within radius of every query point in one tree traversal
+    void get_all_neighbors(PlatoSubproblemLibrary::PointCloud* query_points,
+                           const size_t& max_num_neighbors,
+                           std::vector<size_t>& neighbor_offsets,
+                           std::vector<size_t>& neighbor_indexes) override;
+
+protected:
+    struct SearchTree;
+
+    void query(const double* query_x,
+               const double* query_y,
+               const double* query_z,
+               const size_t& num_queries,
+               std::vector<size_t>& neighbor_offsets,
+               std::vector<size_t>& neighbor_indexes) const;
+    bool is_within_radius(const size_t& answer, const double& x, const double& y, const double& z) const;
+
+    double m_radius;
+    double m_lower_squared_radius;
+    double m_upper_squared_radius;
+    double m_search_radius;
+
+    // answer coordinates and indexes in point cloud order, the order of the tree's primitives
+    std::vector<double> m_coordinates[3];
+    std::vector<size_t> m_indexes;
+
+    std::unique_ptr<SearchTree> m_tree;
+};
+
+}
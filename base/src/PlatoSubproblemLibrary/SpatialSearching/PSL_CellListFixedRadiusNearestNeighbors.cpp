@@ -0,0 +1,207 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#include "PSL_CellListFixedRadiusNearestNeighbors.hpp"
+
+#include "PSL_Point.hpp"
+#include "PSL_PointCloud.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace PlatoSubproblemLibrary
+{
+
+CellListFixedRadiusNearestNeighbors::CellListFixedRadiusNearestNeighbors() :
+        AbstractInterface::FixedRadiusNearestNeighborsSearcher(),
+        m_radius(-1.),
+        m_lower_squared_radius(-1.),
+        m_upper_squared_radius(-1.),
+        m_min_domain{0., 0., 0.},
+        m_max_domain{-1., -1., -1.},
+        m_cell_step(1.),
+        m_num_cells{1u, 1u, 1u},
+        m_cell_offsets(),
+        m_sorted_coordinates(),
+        m_sorted_indexes()
+{
+}
+
+CellListFixedRadiusNearestNeighbors::~CellListFixedRadiusNearestNeighbors()
+{
+    m_cell_offsets.clear();
+    m_sorted_coordinates.clear();
+    m_sorted_indexes.clear();
+}
+
+// bin answer points into cells by counting sort
+void CellListFixedRadiusNearestNeighbors::build(PlatoSubproblemLibrary::PointCloud* answer_points, double radius)
+{
+    m_radius = radius;
+
+    // squared distances within this band are resolved with the same sqrt test as Point::distance
+    const double squared_radius = m_radius * m_radius;
+    m_lower_squared_radius = squared_radius * (1. - 1e-12);
+    m_upper_squared_radius = squared_radius * (1. + 1e-12);
+
+    const size_t num_points = answer_points->get_num_points();
+    if(num_points == 0u)
+    {
+        // empty domain, every query is outside
+        for(size_t dim = 0u; dim < 3u; dim++)
+        {
+            m_min_domain[dim] = 0.;
+            m_max_domain[dim] = -1.;
+            m_num_cells[dim] = 1u;
+        }
+        m_cell_step = 1.;
+        m_cell_offsets.assign(2u, 0u);
+        m_sorted_coordinates.clear();
+        m_sorted_indexes.clear();
+        return;
+    }
+
+    // bounds from the contiguous coordinates
+    const std::vector<double>* coordinates[3] = {&answer_points->get_coordinates(0u),
+                                                 &answer_points->get_coordinates(1u),
+                                                 &answer_points->get_coordinates(2u)};
+    double min_bound[3];
+    double max_bound[3];
+    for(size_t dim = 0u; dim < 3u; dim++)
+    {
+        const std::vector<double>& values = *coordinates[dim];
+        min_bound[dim] = *std::min_element(values.begin(), values.end());
+        max_bound[dim] = *std::max_element(values.begin(), values.end());
+    }
+
+    double max_extent = 0.;
+    for(size_t dim = 0u; dim < 3u; dim++)
+    {
+        m_min_domain[dim] = min_bound[dim] - m_radius;
+        m_max_domain[dim] = max_bound[dim] + m_radius;
+        max_extent = std::max(max_extent, m_max_domain[dim] - m_min_domain[dim]);
+    }
+
+    // cells are no smaller than the radius, but are coarsened to bound memory for small radii
+    const double max_num_cells = double(std::max<size_t>(64u, 2u * num_points));
+    m_cell_step = m_radius;
+    if(!(m_cell_step > 0.))
+    {
+        m_cell_step = (max_extent > 0. ? max_extent / max_num_cells : 1.);
+    }
+    while(true)
+    {
+        double total_cells = 1.;
+        for(size_t dim = 0u; dim < 3u; dim++)
+        {
+            total_cells *= std::floor((m_max_domain[dim] - m_min_domain[dim]) / m_cell_step) + 1.;
+        }
+        if(total_cells <= max_num_cells)
+        {
+            break;
+        }
+        m_cell_step *= 2.;
+    }
+    for(size_t dim = 0u; dim < 3u; dim++)
+    {
+        m_num_cells[dim] = size_t(std::floor((m_max_domain[dim] - m_min_domain[dim]) / m_cell_step)) + 1u;
+    }
+    const size_t total_cells = m_num_cells[0] * m_num_cells[1] * m_num_cells[2];
+
+    // count points per cell
+    std::vector<size_t> point_cells(num_points);
+    m_cell_offsets.assign(total_cells + 1u, 0u);
+    for(size_t point_index = 0u; point_index < num_points; point_index++)
+    {
+        const size_t cell_x = compute_cell_coordinate((*coordinates[0u])[point_index], 0u);
+        const size_t cell_y = compute_cell_coordinate((*coordinates[1u])[point_index], 1u);
+        const size_t cell_z = compute_cell_coordinate((*coordinates[2u])[point_index], 2u);
+        const size_t cell = (cell_x * m_num_cells[1] + cell_y) * m_num_cells[2] + cell_z;
+        point_cells[point_index] = cell;
+        m_cell_offsets[cell + 1u]++;
+    }
+    for(size_t cell = 0u; cell < total_cells; cell++)
+    {
+        m_cell_offsets[cell + 1u] += m_cell_offsets[cell];
+    }
+
+    // scatter into cell order, preserving point cloud order within a cell
+    std::vector<size_t> cell_fill(m_cell_offsets.begin(), m_cell_offsets.end() - 1);
+    m_sorted_coordinates.resize(3u * num_points);
+    m_sorted_indexes.resize(num_points);
+    for(size_t point_index = 0u; point_index < num_points; point_index++)
+    {
+        const size_t destination = cell_fill[point_cells[point_index]]++;
+        m_sorted_coordinates[3u * destination + 0u] = (*coordinates[0u])[point_index];
+        m_sorted_coordinates[3u * destination + 1u] = (*coordinates[1u])[point_index];
+        m_sorted_coordinates[3u * destination + 2u] = (*coordinates[2u])[point_index];
+        m_sorted_indexes[destination] = answer_points->get_index(point_index);
+    }
+}
+
+// find neighbors of query point within radius
+void CellListFixedRadiusNearestNeighbors::get_neighbors(PlatoSubproblemLibrary::Point* query_point,
+                                                         std::vector<size_t>& neighbors_buffer,
+                                                         size_t& num_neighbors)
+{
+    const double x = (*query_point)(0);
+    const double y = (*query_point)(1);
+    const double z = (*query_point)(2);
+
+    if((x < m_min_domain[0]) || (y < m_min_domain[1]) || (z < m_min_domain[2]) || (m_max_domain[0] < x)
+       || (m_max_domain[1] < y) || (m_max_domain[2] < z))
+    {
+        return;
+    }
+
+    const size_t cell_x = compute_cell_coordinate(x, 0u);
+    const size_t cell_y = compute_cell_coordinate(y, 1u);
+    const size_t cell_z = compute_cell_coordinate(z, 2u);
+
+    const size_t cell_x_begin = (cell_x == 0u ? 0u : cell_x - 1u);
+    const size_t cell_y_begin = (cell_y == 0u ? 0u : cell_y - 1u);
+    const size_t cell_z_begin = (cell_z == 0u ? 0u : cell_z - 1u);
+    const size_t cell_x_end = std::min(cell_x + 1u, m_num_cells[0] - 1u);
+    const size_t cell_y_end = std::min(cell_y + 1u, m_num_cells[1] - 1u);
+    const size_t cell_z_end = std::min(cell_z + 1u, m_num_cells[2] - 1u);
+
+    const double* coordinates = m_sorted_coordinates.data();
+    for(size_t answer_cell_x = cell_x_begin; answer_cell_x <= cell_x_end; answer_cell_x++)
+    {
+        for(size_t answer_cell_y = cell_y_begin; answer_cell_y <= cell_y_end; answer_cell_y++)
+        {
+            // cells adjacent in z are adjacent in storage, so scan them as one range
+            const size_t column = (answer_cell_x * m_num_cells[1] + answer_cell_y) * m_num_cells[2];
+            const size_t range_begin = m_cell_offsets[column + cell_z_begin];
+            const size_t range_end = m_cell_offsets[column + cell_z_end + 1u];
+            for(size_t sorted_index = range_begin; sorted_index < range_end; sorted_index++)
+            {
+                const double dx = coordinates[3u * sorted_index + 0u] - x;
+                const double dy = coordinates[3u * sorted_index + 1u] - y;
+                const double dz = coordinates[3u * sorted_index + 2u] - z;
+                const double squared_distance = dx * dx + dy * dy + dz * dz;
+
+                if(m_upper_squared_radius < squared_distance)
+                {
+                    continue;
+                }
+                if((squared_distance <= m_lower_squared_radius) || (std::sqrt(squared_distance) <= m_radius))
+                {
+                    neighbors_buffer[num_neighbors++] = m_sorted_indexes[sorted_index];
+                }
+            }
+        }
+    }
+}
+
+size_t CellListFixedRadiusNearestNeighbors::compute_cell_coordinate(double value, size_t dimension) const
+{
+    const double scaled = (value - m_min_domain[dimension]) / m_cell_step;
+    if(!(scaled > 0.))
+    {
+        return 0u;
+    }
+    return std::min(size_t(scaled), m_num_cells[dimension] - 1u);
+}
+
+}
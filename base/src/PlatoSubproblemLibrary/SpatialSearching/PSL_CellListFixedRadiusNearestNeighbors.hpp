@@ -0,0 +1,52 @@
+// PlatoSubproblemLibraryVersion(8): a stand-alone library for the kernel filter for plato.
+#pragma once
+
+/* Fixed radius searcher over a flat cell list.
+ *
+ * Answer points are binned into a uniform grid of cells no smaller than the radius by a
+ * counting sort. Coordinates and indexes are stored contiguously in cell order, and each
+ * cell is addressed by a compressed row style offset array, so a query visits at most 27
+ * cells in 9 contiguous ranges with no tree lookups and no pointer chasing.
+ */
+
+#include "PSL_Abstract_FixedRadiusNearestNeighborsSearcher.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace PlatoSubproblemLibrary
+{
+class PointCloud;
+class Point;
+
+class CellListFixedRadiusNearestNeighbors : public AbstractInterface::FixedRadiusNearestNeighborsSearcher
+{
+public:
+    CellListFixedRadiusNearestNeighbors();
+    ~CellListFixedRadiusNearestNeighbors() override;
+
+    // build searcher
+    void build(PlatoSubproblemLibrary::PointCloud* answer_points, double radius) override;
+    // find neighbors within radius
+    void get_neighbors(PlatoSubproblemLibrary::Point* query_point,
+                       std::vector<size_t>& neighbors_buffer,
+                       size_t& num_neighbors) override;
+
+protected:
+    size_t compute_cell_coordinate(double value, size_t dimension) const;
+
+    double m_radius;
+    double m_lower_squared_radius;
+    double m_upper_squared_radius;
+
+    double m_min_domain[3];
+    double m_max_domain[3];
+    double m_cell_step;
+    size_t m_num_cells[3];
+
+    std::vector<size_t> m_cell_offsets;
+    std::vector<double> m_sorted_coordinates;
+    std::vector<size_t> m_sorted_indexes;
+};
+
+}
@@ -39,22 +39,23 @@ void RadixGridFixedRadiusNearestNeighbors::build(PlatoSubproblemLibrary::PointCl
     double max_z = 0.;
 
     const size_t num_points = m_answer_points->get_num_points();
+    const std::vector<double>& answer_x = m_answer_points->get_coordinates(0u);
+    const std::vector<double>& answer_y = m_answer_points->get_coordinates(1u);
+    const std::vector<double>& answer_z = m_answer_points->get_coordinates(2u);
     if(num_points > 0u)
     {
-        min_x = (*m_answer_points->get_point(0u))(0);
+        min_x = answer_x[0u];
         max_x = min_x;
-        min_y = (*m_answer_points->get_point(0u))(1);
+        min_y = answer_y[0u];
         max_y = min_y;
-        min_z = (*m_answer_points->get_point(0u))(2);
+        min_z = answer_z[0u];
         max_z = min_z;
     }
     for(size_t point_index = 1u; point_index < num_points; point_index++)
     {
-        PlatoSubproblemLibrary::Point* this_point = m_answer_points->get_point(point_index);
-
-        const double x = (*this_point)(0);
-        const double y = (*this_point)(1);
-        const double z = (*this_point)(2);
+        const double x = answer_x[point_index];
+        const double y = answer_y[point_index];
+        const double z = answer_z[point_index];
 
         min_x = std::min(min_x, x);
         max_x = std::max(max_x, x);
@@ -90,17 +91,15 @@ void RadixGridFixedRadiusNearestNeighbors::build(PlatoSubproblemLibrary::PointCl
 
     for(size_t point_index = 0u; point_index < num_points; point_index++)
     {
-        PlatoSubproblemLibrary::Point* this_point = m_answer_points->get_point(point_index);
-
-        const double x = (*this_point)(0);
-        const double y = (*this_point)(1);
-        const double z = (*this_point)(2);
+        const double x = answer_x[point_index];
+        const double y = answer_y[point_index];
+        const double z = answer_z[point_index];
 
         const size_t radix_x = size_t((x - m_min_x_domain) / m_radix_step_x);
         const size_t radix_y = size_t((y - m_min_y_domain) / m_radix_step_y);
         const size_t radix_z = size_t((z - m_min_z_domain) / m_radix_step_z);
 
-        m_radix_grid[std::make_pair(std::make_pair(radix_x, radix_y), radix_z)].push_back(this_point);
+        m_radix_grid[std::make_pair(std::make_pair(radix_x, radix_y), radix_z)].push_back(point_index);
     }
 }
 
@@ -127,7 +126,7 @@ void RadixGridFixedRadiusNearestNeighbors::get_neighbors(PlatoSubproblemLibrary:
     const size_t radix_y_begin = (radix_y == 0u ? 0u : radix_y - 1);
     const size_t radix_z_begin = (radix_z == 0u ? 0u : radix_z - 1);
 
-    std::map<std::pair<std::pair<size_t, size_t>, size_t>, std::vector<PlatoSubproblemLibrary::Point*> >::iterator map_iter;
+    std::map<std::pair<std::pair<size_t, size_t>, size_t>, std::vector<size_t> >::iterator map_iter;
     for(size_t answer_radix_x = radix_x_begin; answer_radix_x <= radix_x + 1u; answer_radix_x++)
     {
         for(size_t answer_radix_y = radix_y_begin; answer_radix_y <= radix_y + 1u; answer_radix_y++)
@@ -140,10 +139,10 @@ void RadixGridFixedRadiusNearestNeighbors::get_neighbors(PlatoSubproblemLibrary:
                     const size_t bin_size = map_iter->second.size();
                     for(size_t bin_index = 0u; bin_index < bin_size; bin_index++)
                     {
-                        PlatoSubproblemLibrary::Point* pt = map_iter->second[bin_index];
-                        if(query_point->distance(pt) <= m_radius)
+                        const size_t point_index = map_iter->second[bin_index];
+                        if(m_answer_points->distance(point_index, query_point) <= m_radius)
                         {
-                            neighbors_buffer[num_neighbors++] = pt->get_index();
+                            neighbors_buffer[num_neighbors++] = m_answer_points->get_index(point_index);
                         }
                     }
                 }
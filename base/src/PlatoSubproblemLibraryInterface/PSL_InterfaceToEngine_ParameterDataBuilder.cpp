@@ -30,6 +30,7 @@ PlatoSubproblemLibrary::ParameterData* InterfaceToEngine_ParameterDataBuilder::b
     double heaviside_min=-1.;
     double heaviside_update=-1.;
     double heaviside_max=-1;
+    bool neighbor_exchange_ghosting=false;
 
     if( m_inputData.size<Plato::InputData>("Filter") )
     {
@@ -82,6 +83,50 @@ PlatoSubproblemLibrary::ParameterData* InterfaceToEngine_ParameterDataBuilder::b
         {
             result->set_build_direction_z(Plato::Get::Double(tFilterNode, "BuildDirectionZ"));
         }
+        if(tFilterNode.size<std::string>("CacheFile") > 0)
+        {
+            result->set_kernel_filter_cache_filename(Plato::Get::String(tFilterNode, "CacheFile"));
+        }
+        if(tFilterNode.size<std::string>("MatrixFree") > 0)
+        {
+            result->set_kernel_filter_matrix_free(Plato::Get::Bool(tFilterNode, "MatrixFree"));
+        }
+        if(tFilterNode.size<std::string>("FusedProjection") > 0)
+        {
+            result->set_kernel_filter_fused_projection(Plato::Get::Bool(tFilterNode, "FusedProjection"));
+        }
+        if(tFilterNode.size<std::string>("StructuredStencil") > 0)
+        {
+            result->set_kernel_filter_structured_stencil(Plato::Get::Bool(tFilterNode, "StructuredStencil"));
+        }
+        if(tFilterNode.size<std::string>("MortonOrder") > 0)
+        {
+            result->set_kernel_filter_morton_order(Plato::Get::Bool(tFilterNode, "MortonOrder"));
+        }
+        if(tFilterNode.size<std::string>("CompactStorage") > 0)
+        {
+            result->set_kernel_filter_compact_storage(Plato::Get::Bool(tFilterNode, "CompactStorage"));
+        }
+        if(tFilterNode.size<std::string>("SinglePrecision") > 0)
+        {
+            result->set_kernel_filter_single_precision(Plato::Get::Bool(tFilterNode, "SinglePrecision"));
+        }
+        if(tFilterNode.size<std::string>("SymmetricStorage") > 0)
+        {
+            result->set_kernel_filter_symmetric_storage(Plato::Get::Bool(tFilterNode, "SymmetricStorage"));
+        }
+        if(tFilterNode.size<std::string>("IncrementalUpdate") > 0)
+        {
+            result->set_kernel_filter_incremental_update(Plato::Get::Bool(tFilterNode, "IncrementalUpdate"));
+        }
+        if(tFilterNode.size<std::string>("StoredTranspose") > 0)
+        {
+            result->set_kernel_filter_stored_transpose(Plato::Get::Bool(tFilterNode, "StoredTranspose"));
+        }
+        if(tFilterNode.size<std::string>("NeighborExchangeGhosting") > 0)
+        {
+            neighbor_exchange_ghosting = Plato::Get::Bool(tFilterNode, "NeighborExchangeGhosting");
+        }
 
     }
 
@@ -151,7 +196,14 @@ PlatoSubproblemLibrary::ParameterData* InterfaceToEngine_ParameterDataBuilder::b
     result->set_matrix_assembly_agent(PlatoSubproblemLibrary::matrix_assembly_agent_t::by_row);
     result->set_mesh_scale_agent(PlatoSubproblemLibrary::mesh_scale_agent_t::by_average_optimized_element_side);
     result->set_matrix_normalization_agent(PlatoSubproblemLibrary::matrix_normalization_agent_t::default_agent);
-    result->set_point_ghosting_agent(PlatoSubproblemLibrary::point_ghosting_agent_t::by_narrow_share);
+    if(neighbor_exchange_ghosting)
+    {
+        result->set_point_ghosting_agent(PlatoSubproblemLibrary::point_ghosting_agent_t::by_neighbor_exchange);
+    }
+    else
+    {
+        result->set_point_ghosting_agent(PlatoSubproblemLibrary::point_ghosting_agent_t::by_narrow_share);
+    }
     result->set_bounded_support_function(PlatoSubproblemLibrary::bounded_support_function_t::polynomial_tent_function);
 
     return result;
@@ -49,6 +49,7 @@
 #include "PlatoApp.hpp"
 #include "Plato_Parser.hpp"
 #include "Plato_Filter.hpp"
+#include "Plato_Macros.hpp"
 #include "Plato_InputData.hpp"
 #include "PlatoEngine_AbstractFilter.hpp"
 
@@ -65,9 +66,9 @@ Filter::Filter(const std::string& aInputToFilterName,
                Plato::AbstractFilter* aFilter,
                bool aIsGradient) :
                mFilter(aFilter),
-               mInputToFilterName(aInputToFilterName),
+               mInputToFilterNames(1u, aInputToFilterName),
                mInputBaseFieldName(aInputBaseFieldName),
-               mOutputFromFilterName(aOutputFromFilterName),
+               mOutputFromFilterNames(1u, aOutputFromFilterName),
                mIsGradient(aIsGradient)
 {
 }
@@ -76,10 +77,11 @@ Filter::Filter(const std::string& aInputToFilterName,
 Filter::Filter(PlatoApp* aPlatoApp, Plato::InputData& aNode) :
         Plato::LocalOp(aPlatoApp),
         mFilter(),
-        mInputToFilterName(),
+        mInputToFilterNames(),
         mInputBaseFieldName(),
-        mOutputFromFilterName(),
-        mIsGradient()
+        mOutputFromFilterNames(),
+        mIsGradient(),
+        mUpdate()
 {
     // retrieve filter
     mFilter = mPlatoApp->getFilter();
@@ -88,16 +90,39 @@ Filter::Filter(PlatoApp* aPlatoApp, Plato::InputData& aNode) :
     mIsGradient = Plato::Get::Bool(aNode, "Gradient");
     if(mIsGradient == true)
     {
-        mInputToFilterName = "Gradient";
         mInputBaseFieldName = "Field";
-        mOutputFromFilterName = "Filtered Gradient";
     }
     else
     {
-        mInputToFilterName = "Field";
         mInputBaseFieldName = "";
-        mOutputFromFilterName = "Filtered Field";
     }
+
+    // optionally, several quantities are filtered together in one pass; the base field of a
+    // gradient filter is an input too, but it is not filtered
+    for(Plato::InputData tInputNode : aNode.getByName<Plato::InputData>("Input"))
+    {
+        const std::string tInputName = Plato::Get::String(tInputNode, "ArgumentName");
+        if(mIsGradient == false || tInputName != mInputBaseFieldName)
+        {
+            mInputToFilterNames.push_back(tInputName);
+        }
+    }
+    for(Plato::InputData tOutputNode : aNode.getByName<Plato::InputData>("Output"))
+    {
+        mOutputFromFilterNames.push_back(Plato::Get::String(tOutputNode, "ArgumentName"));
+    }
+    if(mInputToFilterNames.size() != mOutputFromFilterNames.size())
+    {
+        THROWERR("Filter operation: number of 'Input' and 'Output' arguments differ.")
+    }
+    if(mInputToFilterNames.empty())
+    {
+        mInputToFilterNames.push_back(mIsGradient ? "Gradient" : "Field");
+        mOutputFromFilterNames.push_back(mIsGradient ? "Filtered Gradient" : "Filtered Field");
+    }
+
+    // optionally, the filter is updated before each application, e.g. after the mesh moved
+    mUpdate = Plato::Get::Bool(aNode, "Update");
 }
 
 Filter::~Filter()
@@ -112,17 +137,26 @@ void Filter::operator()()
         mPlatoApp->getTimersTree()->begin_partition(Plato::timer_partition_t::timer_partition_t::filter);
     }
 
-    // get input data
-    auto tInfield = mPlatoApp->getNodeField(mInputToFilterName);
-    Real* tInputField;
-    tInfield->ExtractView(&tInputField);
-    auto tOutfield = mPlatoApp->getNodeField(mOutputFromFilterName);
-    Real* tOutputField;
-    tOutfield->ExtractView(&tOutputField);
+    if(mFilter && mUpdate)
+    {
+        mFilter->update();
+    }
 
-    // copy input field to output
-    const int tLength = tInfield->MyLength();
-    std::copy(tInputField, tInputField + tLength, tOutputField);
+    // get input data, copied to output
+    const size_t tNumFields = mInputToFilterNames.size();
+    std::vector<double*> tOutputFields(tNumFields, nullptr);
+    int tLength = 0;
+    for(size_t tIndex = 0; tIndex < tNumFields; tIndex++)
+    {
+        auto tInfield = mPlatoApp->getNodeField(mInputToFilterNames[tIndex]);
+        Real* tInputField;
+        tInfield->ExtractView(&tInputField);
+        auto tOutfield = mPlatoApp->getNodeField(mOutputFromFilterNames[tIndex]);
+        tOutfield->ExtractView(&tOutputFields[tIndex]);
+
+        tLength = tInfield->MyLength();
+        std::copy(tInputField, tInputField + tLength, tOutputFields[tIndex]);
+    }
 
     if(mIsGradient == true)
     {
@@ -131,16 +165,24 @@ void Filter::operator()()
         Real* tBaseField;
         tBasefield->ExtractView(&tBaseField);
 
-        if(mFilter)
+        if(mFilter && tNumFields == 1u)
         {
-            mFilter->apply_on_gradient(tLength, tBaseField, tOutputField);
+            mFilter->apply_on_gradient(tLength, tBaseField, tOutputFields[0]);
+        }
+        else if(mFilter)
+        {
+            mFilter->apply_on_gradients(tLength, tBaseField, tOutputFields);
         }
     }
     else
     {
-        if(mFilter)
+        if(mFilter && tNumFields == 1u)
+        {
+            mFilter->apply_on_field(tLength, tOutputFields[0]);
+        }
+        else if(mFilter)
         {
-            mFilter->apply_on_field(tLength, tOutputField);
+            mFilter->apply_on_fields(tLength, tOutputFields);
         }
     }
 
@@ -152,15 +194,21 @@ void Filter::operator()()
 
 void Filter::getArguments(std::vector<Plato::LocalArg>& aLocalArgs)
 {
-    aLocalArgs.push_back(Plato::LocalArg
-        { Plato::data::layout_t::SCALAR_FIELD, mInputToFilterName });
+    for(const std::string& tInputName : mInputToFilterNames)
+    {
+        aLocalArgs.push_back(Plato::LocalArg
+            { Plato::data::layout_t::SCALAR_FIELD, tInputName });
+    }
     if(!mInputBaseFieldName.empty())
     {
         aLocalArgs.push_back(Plato::LocalArg
             { Plato::data::layout_t::SCALAR_FIELD, mInputBaseFieldName });
     }
-    aLocalArgs.push_back(Plato::LocalArg
-        { Plato::data::layout_t::SCALAR_FIELD, mOutputFromFilterName });
+    for(const std::string& tOutputName : mOutputFromFilterNames)
+    {
+        aLocalArgs.push_back(Plato::LocalArg
+            { Plato::data::layout_t::SCALAR_FIELD, tOutputName });
+    }
 }
 
 }
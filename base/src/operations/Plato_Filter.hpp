@@ -50,6 +50,10 @@
 
 #include "Plato_LocalOperation.hpp"
 
+#include <string>
+#include <vector>
+#include <boost/serialization/vector.hpp>
+
 class PlatoApp;
 
 namespace Plato
@@ -98,19 +102,21 @@ public:
     void serialize(Archive & aArchive, const unsigned int /*version*/)
     {
       aArchive & boost::serialization::make_nvp("LocalOp",boost::serialization::base_object<LocalOp>(*this));
-      aArchive & boost::serialization::make_nvp("InputToFilterName",mInputToFilterName);
+      aArchive & boost::serialization::make_nvp("InputToFilterNames",mInputToFilterNames);
       aArchive & boost::serialization::make_nvp("InputBaseFieldName",mInputBaseFieldName);
-      aArchive & boost::serialization::make_nvp("OutputFromFilterName",mOutputFromFilterName);
+      aArchive & boost::serialization::make_nvp("OutputFromFilterNames",mOutputFromFilterNames);
       aArchive & boost::serialization::make_nvp("IsGradient",mIsGradient);
+      aArchive & boost::serialization::make_nvp("Update",mUpdate);
       //TODO serialization of all the filters
     }
 
 private:
     Plato::AbstractFilter* mFilter = nullptr; /*!< Kernel filter interface */
-    std::string mInputToFilterName; /*!< input argument name */
+    std::vector<std::string> mInputToFilterNames; /*!< input argument names, filtered together */
     std::string mInputBaseFieldName; /*!< input base field argument name */
-    std::string mOutputFromFilterName; /*!< output argument name */
+    std::vector<std::string> mOutputFromFilterNames; /*!< output argument names, one per input */
     bool mIsGradient = false; /*!< is the gradient the input argument to the filter */
+    bool mUpdate = false; /*!< update the filter to the current mesh and parameters before applying */
 };
 // class Filter;
 
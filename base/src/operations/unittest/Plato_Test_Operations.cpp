@@ -39,7 +39,10 @@
 // *************************************************************************
 //@HEADER
 */
+#include "PlatoApp.hpp"
 #include "Plato_Utils.hpp"
+#include "Plato_Filter.hpp"
+#include "Plato_Parser.hpp"
 #include "Plato_InputData.hpp"
 #include "Plato_EnforceBounds.hpp"
 #include "Plato_SystemCallOperation.hpp"
@@ -75,4 +78,66 @@ TEST(EnforceBounds, applyBounds)
     EXPECT_EQ(tDataToBound[9], 0);
 }
 
+TEST(Filter, gradientArgumentsFromGeneratedOperation)
+{
+    // as written by the input generator for a topology problem filtered in the engine
+    const std::string tInput =
+    "<Operation>\n"
+    "  <Function>Filter</Function>\n"
+    "  <Name>Filter Gradient</Name>\n"
+    "  <Gradient>True</Gradient>\n"
+    "  <Input>\n"
+    "    <ArgumentName>Field</ArgumentName>\n"
+    "  </Input>\n"
+    "  <Input>\n"
+    "    <ArgumentName>Gradient</ArgumentName>\n"
+    "  </Input>\n"
+    "  <Output>\n"
+    "    <ArgumentName>Filtered Gradient</ArgumentName>\n"
+    "  </Output>\n"
+    "</Operation>\n";
+    Plato::InputData tInputData = Plato::PugiParser{}.parseString(tInput);
+    Plato::InputData tNode = tInputData.get<Plato::InputData>("Operation");
+
+    MPI_Comm tMyComm = MPI_COMM_WORLD;
+    PlatoApp tPlatoApp(tMyComm);
+    Plato::Filter tOperation(&tPlatoApp, tNode);
+
+    // the base field is an argument, but only the gradient is filtered
+    std::vector<Plato::LocalArg> tLocalArguments;
+    tOperation.getArguments(tLocalArguments);
+    ASSERT_EQ(3u, tLocalArguments.size());
+    EXPECT_STREQ("Gradient", tLocalArguments[0].mName.c_str());
+    EXPECT_STREQ("Field", tLocalArguments[1].mName.c_str());
+    EXPECT_STREQ("Filtered Gradient", tLocalArguments[2].mName.c_str());
+}
+
+TEST(Filter, fieldArgumentsFromOperation)
+{
+    const std::string tInput =
+    "<Operation>\n"
+    "  <Function>Filter</Function>\n"
+    "  <Name>Filter Control</Name>\n"
+    "  <Gradient>False</Gradient>\n"
+    "  <Input>\n"
+    "    <ArgumentName>Field</ArgumentName>\n"
+    "  </Input>\n"
+    "  <Output>\n"
+    "    <ArgumentName>Filtered Field</ArgumentName>\n"
+    "  </Output>\n"
+    "</Operation>\n";
+    Plato::InputData tInputData = Plato::PugiParser{}.parseString(tInput);
+    Plato::InputData tNode = tInputData.get<Plato::InputData>("Operation");
+
+    MPI_Comm tMyComm = MPI_COMM_WORLD;
+    PlatoApp tPlatoApp(tMyComm);
+    Plato::Filter tOperation(&tPlatoApp, tNode);
+
+    std::vector<Plato::LocalArg> tLocalArguments;
+    tOperation.getArguments(tLocalArguments);
+    ASSERT_EQ(2u, tLocalArguments.size());
+    EXPECT_STREQ("Field", tLocalArguments[0].mName.c_str());
+    EXPECT_STREQ("Filtered Field", tLocalArguments[1].mName.c_str());
+}
+
 } // end PlatoTestOperations namespace